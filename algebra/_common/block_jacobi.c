@@ -0,0 +1,268 @@
+#include "glob_opts.h"
+#include "block_jacobi.h"
+#include "csc_utils.h"
+
+// Largest block (and coupling span) considered by the automatic detection
+#define BLOCK_JACOBI_MAX_AUTO 64
+
+
+/* Place the block boundaries between variables that are not coupled by P or
+ * by a row of A, splitting blocks longer than BLOCK_JACOBI_MAX_AUTO.
+ * Returns the number of blocks (-1 if out of memory). */
+static OSQPInt detect_blocks(const OSQPCscMatrix* P,
+                             const OSQPCscMatrix* A,
+                             OSQPInt*             block_ptr) {
+
+  OSQPInt  i, j, k, r, run;
+  OSQPInt  nb    = 0;
+  OSQPInt  n     = P->n;
+  OSQPInt  m     = A->m;
+  OSQPInt* cover = c_calloc(n + 1, sizeof(OSQPInt));
+  OSQPInt* rmin  = c_malloc(c_max(m, 1) * sizeof(OSQPInt));
+  OSQPInt* rmax  = c_malloc(c_max(m, 1) * sizeof(OSQPInt));
+
+  if (!cover || !rmin || !rmax) {
+    c_free(cover);
+    c_free(rmin);
+    c_free(rmax);
+    return -1;
+  }
+
+  // Every coupling between variables i < j prevents a boundary in (i, j].
+  // cover holds the differences of the number of couplings over each gap.
+  for (j = 0; j < n; j++) {
+    for (k = P->p[j]; k < P->p[j+1]; k++) {
+      i = P->i[k];
+      if (i < j && j - i < BLOCK_JACOBI_MAX_AUTO) {
+        cover[i+1]++;
+        cover[j+1]--;
+      }
+    }
+  }
+
+  for (r = 0; r < m; r++) {
+    rmin[r] = n;
+    rmax[r] = -1;
+  }
+  for (j = 0; j < n; j++) {
+    for (k = A->p[j]; k < A->p[j+1]; k++) {
+      r = A->i[k];
+      rmin[r] = c_min(rmin[r], j);
+      rmax[r] = c_max(rmax[r], j);
+    }
+  }
+  for (r = 0; r < m; r++) {
+    if (rmax[r] > rmin[r] && rmax[r] - rmin[r] < BLOCK_JACOBI_MAX_AUTO) {
+      cover[rmin[r]+1]++;
+      cover[rmax[r]+1]--;
+    }
+  }
+
+  block_ptr[0] = 0;
+  run = 0;
+  for (k = 1; k < n; k++) {
+    run += cover[k];
+    if (run == 0 || k - block_ptr[nb] >= BLOCK_JACOBI_MAX_AUTO)
+      block_ptr[++nb] = k;
+  }
+  block_ptr[++nb] = n;
+
+  c_free(cover);
+  c_free(rmin);
+  c_free(rmax);
+
+  return nb;
+}
+
+
+block_jacobi_precond* block_jacobi_new(const OSQPCscMatrix* P,
+                                       const OSQPCscMatrix* A,
+                                       OSQPInt              block_size) {
+
+  OSQPInt b, j, nbk;
+  OSQPInt n   = P->n;
+  OSQPInt Anz = A->p[A->n];
+
+  block_jacobi_precond* f = c_calloc(1, sizeof(block_jacobi_precond));
+  if (!f) return OSQP_NULL;
+
+  f->n         = n;
+  f->block_ptr = c_malloc((n + 1) * sizeof(OSQPInt));
+  f->blk       = c_malloc(c_max(n, 1) * sizeof(OSQPInt));
+  if (!f->block_ptr || !f->blk) goto fail;
+
+  if (block_size > 0) {
+    block_size = c_min(block_size, n);
+    f->nblocks = (n + block_size - 1) / block_size;
+    for (b = 0; b <= f->nblocks; b++)
+      f->block_ptr[b] = c_min(b * block_size, n);
+  } else {
+    f->nblocks = detect_blocks(P, A, f->block_ptr);
+    if (f->nblocks < 0) goto fail;
+  }
+
+  // Dense storage for the factor of every block
+  f->L_ptr = c_malloc((f->nblocks + 1) * sizeof(OSQPInt));
+  if (!f->L_ptr) goto fail;
+
+  f->L_ptr[0] = 0;
+  for (b = 0; b < f->nblocks; b++) {
+    nbk = f->block_ptr[b+1] - f->block_ptr[b];
+    f->L_ptr[b+1] = f->L_ptr[b] + nbk * nbk;
+    for (j = f->block_ptr[b]; j < f->block_ptr[b+1]; j++) f->blk[j] = b;
+  }
+
+  f->L = c_malloc(c_max(f->L_ptr[f->nblocks], 1) * sizeof(OSQPFloat));
+  if (!f->L) goto fail;
+
+  // Rows of A are needed to assemble A'*diag(rho)*A
+  f->AtoAt = c_malloc(c_max(Anz, 1) * sizeof(OSQPInt));
+  if (!f->AtoAt) goto fail;
+  f->At = csc_transpose(A, f->AtoAt);
+  if (!f->At) goto fail;
+
+  return f;
+
+fail:
+  block_jacobi_free(f);
+  return OSQP_NULL;
+}
+
+
+/* In-place Cholesky factorization of a dense block (lower part, column major).
+ * Returns 0 on success and 1 if the block is not positive definite. */
+static OSQPInt dense_chol(OSQPFloat* L,
+                          OSQPInt    nbk) {
+
+  OSQPInt   i, j, k;
+  OSQPFloat d, s;
+
+  for (j = 0; j < nbk; j++) {
+    d = L[j + j*nbk];
+    for (k = 0; k < j; k++) d -= L[j + k*nbk] * L[j + k*nbk];
+
+    if (!(d > 0.0)) return 1;
+    d = c_sqrt(d);
+    L[j + j*nbk] = d;
+
+    for (i = j + 1; i < nbk; i++) {
+      s = L[i + j*nbk];
+      for (k = 0; k < j; k++) s -= L[i + k*nbk] * L[j + k*nbk];
+      L[i + j*nbk] = s / d;
+    }
+  }
+
+  return 0;
+}
+
+
+OSQPInt block_jacobi_factor(block_jacobi_precond* f,
+                            const OSQPCscMatrix*  P,
+                            const OSQPCscMatrix*  A,
+                            OSQPFloat             sigma,
+                            const OSQPFloat*      rho) {
+
+  OSQPInt    a, b, c, i, j, k, kend, r, s, nbk;
+  OSQPInt    failed = 0;
+  OSQPInt*   Atp = f->At->p;
+  OSQPInt*   Ati = f->At->i;
+  OSQPFloat* Atx = f->At->x;
+  OSQPFloat* Lb;
+  OSQPFloat  va;
+
+  // Bring At in sync with A
+  for (k = 0; k < A->p[A->n]; k++) Atx[f->AtoAt[k]] = A->x[k];
+
+  for (k = 0; k < f->L_ptr[f->nblocks]; k++) f->L[k] = 0.0;
+
+  // P + sigma*I (P is upper triangular, fill the lower part of the blocks)
+  for (j = 0; j < f->n; j++) {
+    b   = f->blk[j];
+    s   = f->block_ptr[b];
+    nbk = f->block_ptr[b+1] - s;
+    Lb  = f->L + f->L_ptr[b];
+
+    for (k = P->p[j]; k < P->p[j+1]; k++) {
+      i = P->i[k];
+      if (i >= s && i <= j) Lb[(j - s) + (i - s)*nbk] += P->x[k];
+    }
+    Lb[(j - s)*(nbk + 1)] += sigma;
+  }
+
+  // A'*diag(rho)*A, one row of A at a time. The rows of At are sorted, so the
+  // entries of a row that fall in the same block are consecutive.
+  for (r = 0; r < f->At->n; r++) {
+    for (k = Atp[r]; k < Atp[r+1]; k = kend) {
+      b   = f->blk[Ati[k]];
+      s   = f->block_ptr[b];
+      nbk = f->block_ptr[b+1] - s;
+      Lb  = f->L + f->L_ptr[b];
+
+      kend = k;
+      while (kend < Atp[r+1] && Ati[kend] < s + nbk) kend++;
+
+      for (a = k; a < kend; a++) {
+        va = rho[r] * Atx[a];
+        for (c = a; c < kend; c++)
+          Lb[(Ati[c] - s) + (Ati[a] - s)*nbk] += va * Atx[c];
+      }
+    }
+  }
+
+  // The assembled blocks are factored independently of each other
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp parallel for private(nbk) reduction(+:failed) schedule(dynamic)
+#endif
+  for (b = 0; b < f->nblocks; b++) {
+    nbk = f->block_ptr[b+1] - f->block_ptr[b];
+    if (dense_chol(f->L + f->L_ptr[b], nbk)) failed++;
+  }
+
+  return failed ? 1 : 0;
+}
+
+
+void block_jacobi_solve(const block_jacobi_precond* f,
+                        OSQPFloat*                  x) {
+
+  OSQPInt    b, i, j, nbk;
+  OSQPFloat* Lb;
+  OSQPFloat* xb;
+  OSQPFloat  s;
+
+  // The blocks are independent of each other
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp parallel for private(i, j, nbk, Lb, xb, s) schedule(dynamic)
+#endif
+  for (b = 0; b < f->nblocks; b++) {
+    nbk = f->block_ptr[b+1] - f->block_ptr[b];
+    Lb  = f->L + f->L_ptr[b];
+    xb  = x + f->block_ptr[b];
+
+    // L z = x
+    for (j = 0; j < nbk; j++) {
+      xb[j] /= Lb[j + j*nbk];
+      for (i = j + 1; i < nbk; i++) xb[i] -= Lb[i + j*nbk] * xb[j];
+    }
+
+    // L' y = z
+    for (j = nbk - 1; j >= 0; j--) {
+      s = xb[j];
+      for (i = j + 1; i < nbk; i++) s -= Lb[i + j*nbk] * xb[i];
+      xb[j] = s / Lb[j + j*nbk];
+    }
+  }
+}
+
+
+void block_jacobi_free(block_jacobi_precond* f) {
+  if (f) {
+    c_free(f->block_ptr);
+    c_free(f->blk);
+    c_free(f->L_ptr);
+    c_free(f->L);
+    csc_spfree(f->At);
+    c_free(f->AtoAt);
+    c_free(f);
+  }
+}
@@ -0,0 +1,83 @@
+#ifndef BLOCK_JACOBI_H_
+#define BLOCK_JACOBI_H_
+
+#include "osqp_api_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Block-Jacobi preconditioner of the reduced KKT matrix
+ *
+ *   K = P + sigma*I + A'*diag(rho)*A
+ *
+ * used by the CPU conjugate gradient solvers. The variables are split into
+ * contiguous blocks and the dense diagonal blocks of K are factored with a
+ * Cholesky decomposition. All coupling between blocks is dropped.
+ */
+typedef struct {
+  OSQPInt        n;         ///< dimension of K
+  OSQPInt        nblocks;   ///< number of blocks
+  OSQPInt*       block_ptr; ///< first variable of every block (length nblocks+1)
+  OSQPInt*       blk;       ///< block of every variable (length n)
+  OSQPInt*       L_ptr;     ///< offset of every dense factor in L (length nblocks+1)
+  OSQPFloat*     L;         ///< dense lower triangular factors (column major)
+  OSQPCscMatrix* At;        ///< transpose of A (values refreshed before every factorization)
+  OSQPInt*       AtoAt;     ///< index of elements from A to At
+} block_jacobi_precond;
+
+/**
+ * Allocate the preconditioner and partition the variables into blocks
+ *
+ * With a positive block_size the variables are split into consecutive blocks
+ * of that size (the last one may be smaller). Otherwise the blocks are placed
+ * between variables that are not coupled by P or by the rows of A, ignoring
+ * couplings that span more than a fixed maximum block size.
+ *
+ * @param  P           Objective function matrix in csc format (triu form)
+ * @param  A           Constraints matrix in csc format
+ * @param  block_size  Size of the blocks (0 to detect them automatically)
+ * @return             Preconditioner (OSQP_NULL if out of memory)
+ */
+block_jacobi_precond* block_jacobi_new(const OSQPCscMatrix* P,
+                                       const OSQPCscMatrix* A,
+                                       OSQPInt              block_size);
+
+/**
+ * Assemble and factor the diagonal blocks of K
+ *
+ * @param  f      Preconditioner
+ * @param  P      Objective function matrix (same pattern as in block_jacobi_new)
+ * @param  A      Constraints matrix (same pattern as in block_jacobi_new)
+ * @param  sigma  Regularization parameter
+ * @param  rho    Vector of penalty parameters (length m)
+ * @return        Exitflag (0 if all blocks were factored)
+ */
+OSQPInt block_jacobi_factor(block_jacobi_precond* f,
+                            const OSQPCscMatrix*  P,
+                            const OSQPCscMatrix*  A,
+                            OSQPFloat             sigma,
+                            const OSQPFloat*      rho);
+
+/**
+ * Apply the preconditioner in place, block by block (in parallel with OpenMP)
+ *
+ * @param f  Preconditioner
+ * @param x  Vector of length n
+ */
+void block_jacobi_solve(const block_jacobi_precond* f,
+                        OSQPFloat*                  x);
+
+/**
+ * Free the preconditioner
+ *
+ * @param f  Preconditioner
+ */
+void block_jacobi_free(block_jacobi_precond* f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLOCK_JACOBI_H_ */
@@ -285,6 +285,39 @@ OSQPCscMatrix* triplet_to_csr(const OSQPCscMatrix* T, OSQPInt* TtoC) {
   return csc_done(C, w, OSQP_NULL, 1);     /* success; free w and return C */
 }
 
+OSQPCscMatrix* csc_transpose(const OSQPCscMatrix* A, OSQPInt* AtoC) {
+  OSQPInt    m, n, p, q, j;
+  OSQPInt*   Cp;
+  OSQPInt*   Ci;
+  OSQPInt*   w;
+  OSQPFloat* Cx;
+  OSQPCscMatrix* C;
+
+  m  = A->m;
+  n  = A->n;
+  C  = csc_spalloc(n, m, A->p[n], A->x != OSQP_NULL, 0);  /* allocate result */
+  w  = csc_calloc(m, sizeof(OSQPInt));                      /* get workspace */
+
+  if (!C || !w) return csc_done(C, w, OSQP_NULL, 0);      /* out of memory */
+
+  Cp = C->p;
+  Ci = C->i;
+  Cx = C->x;
+
+  for (p = 0; p < A->p[n]; p++) w[A->i[p]]++;  /* row counts */
+  csc_cumsum(Cp, w, m);                        /* row pointers */
+
+  for (j = 0; j < n; j++) {
+    for (p = A->p[j]; p < A->p[j + 1]; p++) {
+      Ci[q = w[A->i[p]]++] = j;                /* A(i,j) is the qth entry in C */
+
+      if (Cx) Cx[q] = A->x[p];
+      if (AtoC != OSQP_NULL) AtoC[p] = q;      // Assign vector of indices
+    }
+  }
+  return csc_done(C, w, OSQP_NULL, 1);         /* success; free w and return C */
+}
+
 #endif /* OSQP_EMBEDDED_MODE */
 
 void csc_extract_diag(const OSQPCscMatrix* A,
@@ -126,6 +126,20 @@ OSQPCscMatrix* triplet_to_csr(const OSQPCscMatrix* T,
                                     OSQPInt*       TtoC);
 
 
+/**
+ * C = A' in compressed-column form
+ *
+ * AtoC stores the vector of indices from A to C
+ *  -> C[AtoC[i]] = A[i]
+ *
+ * @param  A    matrix in CSC format
+ * @param  AtoC vector of indices from A to C (can be OSQP_NULL)
+ * @return      transpose of A in CSC format
+ */
+OSQPCscMatrix* csc_transpose(const OSQPCscMatrix* A,
+                                   OSQPInt*       AtoC);
+
+
 // /**
 //  * Convert square CSC matrix into upper triangular one
 //  *
@@ -0,0 +1,323 @@
+#include "glob_opts.h"
+#include "deflation.h"
+
+// Number of solves after a reset whose directions refine the basis
+#define DEFLATION_REFINE 20
+// Relative pivot under which a direction is considered linearly dependent
+#define DEFLATION_DEP_TOL 1e-10
+// Maximum number of sweeps of the Jacobi eigenvalue iteration
+#define DEFLATION_MAX_SWEEPS 50
+
+#define DEFLATION_NZ (DEFLATION_SIZE + DEFLATION_DIRS)
+
+
+static OSQPFloat dot(const OSQPFloat* a,
+                     const OSQPFloat* b,
+                     OSQPInt          n) {
+  OSQPInt   i;
+  OSQPFloat s = 0.0;
+
+  for (i = 0; i < n; i++) s += a[i] * b[i];
+  return s;
+}
+
+
+cg_deflation* deflation_new(OSQPInt n) {
+
+  cg_deflation* d = c_calloc(1, sizeof(cg_deflation));
+  if (!d) return OSQP_NULL;
+
+  d->n     = n;
+  d->W     = c_malloc(n * DEFLATION_SIZE * sizeof(OSQPFloat));
+  d->KW    = c_malloc(n * DEFLATION_SIZE * sizeof(OSQPFloat));
+  d->P     = c_malloc(n * DEFLATION_DIRS * sizeof(OSQPFloat));
+  d->KP    = c_malloc(n * DEFLATION_DIRS * sizeof(OSQPFloat));
+  d->theta = c_malloc(DEFLATION_SIZE * sizeof(OSQPFloat));
+  d->work  = c_malloc((4 * DEFLATION_NZ * DEFLATION_NZ + 2 * DEFLATION_NZ) * sizeof(OSQPFloat));
+
+  if (!d->W || !d->KW || !d->P || !d->KP || !d->theta || !d->work) {
+    deflation_free(d);
+    return OSQP_NULL;
+  }
+
+  deflation_reset(d);
+
+  return d;
+}
+
+
+void deflation_reset(cg_deflation* d) {
+  d->k      = 0;
+  d->l      = 0;
+  d->refine = DEFLATION_REFINE;
+}
+
+
+void deflation_project(const cg_deflation* d,
+                       OSQPFloat*          x,
+                       OSQPFloat*          r) {
+
+  OSQPInt    i, j;
+  OSQPInt    n = d->n;
+  OSQPFloat  c;
+  OSQPFloat* w;
+  OSQPFloat* Kw;
+
+  // W'*K*W is diagonal, so every column is handled on its own
+  for (j = 0; j < d->k; j++) {
+    w  = d->W  + j*n;
+    Kw = d->KW + j*n;
+    c  = dot(w, r, n) / d->theta[j];
+
+    for (i = 0; i < n; i++) {
+      x[i] -= c * w[i];
+      r[i] -= c * Kw[i];
+    }
+  }
+}
+
+
+void deflation_direction(const cg_deflation* d,
+                         OSQPFloat*          p,
+                         const OSQPFloat*    y) {
+
+  OSQPInt    i, j;
+  OSQPInt    n = d->n;
+  OSQPFloat  mu;
+  OSQPFloat* w;
+
+  for (j = 0; j < d->k; j++) {
+    w  = d->W + j*n;
+    mu = dot(d->KW + j*n, y, n) / d->theta[j];
+
+    for (i = 0; i < n; i++) p[i] += mu * w[i];
+  }
+}
+
+
+void deflation_collect(cg_deflation*    d,
+                       const OSQPFloat* p,
+                       const OSQPFloat* Kp) {
+
+  OSQPInt i;
+  OSQPInt n = d->n;
+
+  if (d->refine <= 0 || d->l >= DEFLATION_DIRS) return;
+
+  for (i = 0; i < n; i++) {
+    d->P[d->l*n + i]  = p[i];
+    d->KP[d->l*n + i] = Kp[i];
+  }
+  d->l++;
+}
+
+
+/* Eigenvalues (diagonal of C on exit) and eigenvectors (columns of V) of the
+ * symmetric matrix C of size nz (leading dimension ld) with cyclic Jacobi rotations */
+static void jacobi_eig(OSQPFloat* C,
+                       OSQPFloat* V,
+                       OSQPInt    nz,
+                       OSQPInt    ld) {
+
+  OSQPInt   i, p, q, sweep;
+  OSQPFloat off, nrm, th, t, c, s, a, b;
+
+  for (p = 0; p < nz; p++)
+    for (q = 0; q < nz; q++) V[p + q*ld] = (p == q) ? 1.0 : 0.0;
+
+  for (sweep = 0; sweep < DEFLATION_MAX_SWEEPS; sweep++) {
+    off = 0.0;
+    nrm = 0.0;
+    for (q = 0; q < nz; q++) {
+      nrm += C[q + q*ld] * C[q + q*ld];
+      for (p = 0; p < q; p++) off += C[p + q*ld] * C[p + q*ld];
+    }
+    if (off <= 1e-30 * nrm) break;
+
+    for (q = 1; q < nz; q++) {
+      for (p = 0; p < q; p++) {
+        if (C[p + q*ld] == 0.0) continue;
+
+        th = (C[q + q*ld] - C[p + p*ld]) / (2.0 * C[p + q*ld]);
+        t  = 1.0 / (c_absval(th) + c_sqrt(th * th + 1.0));
+        if (th < 0.0) t = -t;
+        c  = 1.0 / c_sqrt(t * t + 1.0);
+        s  = t * c;
+
+        // C = J'*C*J, V = V*J
+        for (i = 0; i < nz; i++) {
+          a = C[i + p*ld];
+          b = C[i + q*ld];
+          C[i + p*ld] = c * a - s * b;
+          C[i + q*ld] = s * a + c * b;
+        }
+        for (i = 0; i < nz; i++) {
+          a = C[p + i*ld];
+          b = C[q + i*ld];
+          C[p + i*ld] = c * a - s * b;
+          C[q + i*ld] = s * a + c * b;
+        }
+        for (i = 0; i < nz; i++) {
+          a = V[i + p*ld];
+          b = V[i + q*ld];
+          V[i + p*ld] = c * a - s * b;
+          V[i + q*ld] = s * a + c * b;
+        }
+      }
+    }
+  }
+}
+
+
+/* Replace the first knew columns of X (n x nz, column major) with X*Y,
+ * one row at a time so that X can be overwritten in place */
+static void combine_columns(OSQPFloat*       X,
+                            const OSQPFloat* Y,
+                            OSQPFloat*       row,
+                            OSQPInt          n,
+                            OSQPInt          nz,
+                            OSQPInt          knew,
+                            OSQPInt          ld,
+                            OSQPInt          nW,
+                            const OSQPFloat* Xtail) {
+
+  OSQPInt   i, a, j;
+  OSQPFloat s;
+
+  for (i = 0; i < n; i++) {
+    // Row i of [X(:, 0:nW), Xtail]
+    for (a = 0; a < nz; a++)
+      row[a] = (a < nW) ? X[i + a*n] : Xtail[i + (a - nW)*n];
+
+    for (j = 0; j < knew; j++) {
+      s = 0.0;
+      for (a = 0; a < nz; a++) s += row[a] * Y[a + j*ld];
+      X[i + j*n] = s;
+    }
+  }
+}
+
+
+void deflation_update(cg_deflation* d) {
+
+  OSQPInt    a, b, j, t, nz, knew, best;
+  OSQPInt    n    = d->n;
+  OSQPInt    ld   = DEFLATION_NZ;
+  OSQPFloat* G    = d->work;            // Z'*K*Z
+  OSQPFloat* F    = G + ld * ld;        // Z'*Z, then its Cholesky factor
+  OSQPFloat* C    = F + ld * ld;        // L \ G / L'
+  OSQPFloat* V    = C + ld * ld;        // eigenvectors of C, then the coefficients Y
+  OSQPFloat* ev   = V + ld * ld;        // eigenvalues of C
+  OSQPFloat* row  = ev + ld;            // row buffer
+  OSQPFloat  sum, piv, tmp;
+  const OSQPFloat *za, *zb, *kzb;
+
+  if (d->l == 0) return;
+
+  nz = d->k + d->l;
+
+  // Z = [W, P] and K*Z = [K*W, K*P]
+  for (b = 0; b < nz; b++) {
+    zb  = (b < d->k) ? d->W  + b*n : d->P  + (b - d->k)*n;
+    kzb = (b < d->k) ? d->KW + b*n : d->KP + (b - d->k)*n;
+    for (a = 0; a <= b; a++) {
+      za = (a < d->k) ? d->W + a*n : d->P + (a - d->k)*n;
+      G[a + b*ld] = G[b + a*ld] = dot(za, kzb, n);
+      F[a + b*ld] = F[b + a*ld] = dot(za, zb, n);
+    }
+  }
+
+  // F = L*L', dropping the directions that depend on the previous ones
+  for (j = 0; j < nz; j++) {
+    piv = F[j + j*ld];
+    for (t = 0; t < j; t++) piv -= F[j + t*ld] * F[j + t*ld];
+
+    if (!(piv > DEFLATION_DEP_TOL * F[j + j*ld])) {
+      nz = j;
+      break;
+    }
+    piv = c_sqrt(piv);
+    F[j + j*ld] = piv;
+
+    for (a = j + 1; a < nz; a++) {
+      sum = F[a + j*ld];
+      for (t = 0; t < j; t++) sum -= F[a + t*ld] * F[j + t*ld];
+      F[a + j*ld] = sum / piv;
+    }
+  }
+
+  d->l = 0;
+  d->refine--;
+  if (nz == 0) return;
+
+  // C = L \ G, then C = L \ C'
+  for (b = 0; b < nz; b++) {
+    for (a = 0; a < nz; a++) {
+      sum = G[a + b*ld];
+      for (t = 0; t < a; t++) sum -= F[a + t*ld] * C[t + b*ld];
+      C[a + b*ld] = sum / F[a + a*ld];
+    }
+  }
+  for (a = 0; a < nz; a++)
+    for (b = 0; b < a; b++) {
+      tmp = C[a + b*ld];
+      C[a + b*ld] = C[b + a*ld];
+      C[b + a*ld] = tmp;
+    }
+  for (b = 0; b < nz; b++) {
+    for (a = 0; a < nz; a++) {
+      sum = C[a + b*ld];
+      for (t = 0; t < a; t++) sum -= F[a + t*ld] * C[t + b*ld];
+      C[a + b*ld] = sum / F[a + a*ld];
+    }
+  }
+
+  jacobi_eig(C, V, nz, ld);
+
+  // Move the eigenpairs of the smallest positive Ritz values to the front
+  knew = 0;
+  for (a = 0; a < nz; a++) ev[a] = C[a + a*ld];
+  while (knew < c_min(nz, DEFLATION_SIZE)) {
+    best = -1;
+    for (a = knew; a < nz; a++)
+      if (ev[a] > 0.0 && (best < 0 || ev[a] < ev[best])) best = a;
+    if (best < 0) break;
+
+    tmp = ev[knew]; ev[knew] = ev[best]; ev[best] = tmp;
+    for (a = 0; a < nz; a++) {
+      tmp = V[a + knew*ld];
+      V[a + knew*ld] = V[a + best*ld];
+      V[a + best*ld] = tmp;
+    }
+    knew++;
+  }
+
+  // Y = L' \ V, so that Y'*F*Y = I and Y'*G*Y = diag(ev)
+  for (j = 0; j < knew; j++) {
+    for (a = nz - 1; a >= 0; a--) {
+      sum = V[a + j*ld];
+      for (t = a + 1; t < nz; t++) sum -= F[t + a*ld] * V[t + j*ld];
+      V[a + j*ld] = sum / F[a + a*ld];
+    }
+  }
+
+  // W = Z*Y and K*W = K*Z*Y
+  combine_columns(d->W,  V, row, n, nz, knew, ld, d->k, d->P);
+  combine_columns(d->KW, V, row, n, nz, knew, ld, d->k, d->KP);
+
+  for (j = 0; j < knew; j++) d->theta[j] = ev[j];
+  d->k = knew;
+}
+
+
+void deflation_free(cg_deflation* d) {
+  if (d) {
+    c_free(d->W);
+    c_free(d->KW);
+    c_free(d->P);
+    c_free(d->KP);
+    c_free(d->theta);
+    c_free(d->work);
+    c_free(d);
+  }
+}
@@ -0,0 +1,110 @@
+#ifndef DEFLATION_H_
+#define DEFLATION_H_
+
+#include "osqp_api_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Maximum number of vectors in the basis
+#define DEFLATION_SIZE 6
+// Maximum number of search directions collected per solve
+#define DEFLATION_DIRS 6
+
+/**
+ * Deflation basis recycled across the conjugate gradient solves of the
+ * reduced KKT matrix K = P + sigma*I + A'*diag(rho)*A
+ *
+ * The basis W holds approximate eigenvectors of K for its smallest
+ * eigenvalues, normalized so that W'*K*W = diag(theta). Deflated CG keeps its
+ * residuals orthogonal to W and its search directions K-orthogonal to W, so
+ * these eigenvalues no longer slow down the convergence.
+ *
+ * The first search directions of every solve are collected and the basis is
+ * refined with a Rayleigh-Ritz step on span(W, directions) after the solve.
+ * This is repeated for a fixed number of solves after every reset, after
+ * which the basis is only used.
+ */
+typedef struct {
+  OSQPInt    n;         ///< dimension of K
+  OSQPInt    k;         ///< number of vectors in the basis
+  OSQPInt    l;         ///< number of directions collected in the current solve
+  OSQPInt    refine;    ///< remaining solves that refine the basis
+  OSQPFloat* W;         ///< basis (n x max size, column major)
+  OSQPFloat* KW;        ///< K*W
+  OSQPFloat* theta;     ///< diagonal of W'*K*W
+  OSQPFloat* P;         ///< collected search directions (n x max directions, column major)
+  OSQPFloat* KP;        ///< K*P
+  OSQPFloat* work;      ///< dense workspace of the Rayleigh-Ritz step
+} cg_deflation;
+
+/**
+ * Allocate an empty deflation basis
+ *
+ * @param  n  Dimension of K
+ * @return    Deflation basis (OSQP_NULL if out of memory)
+ */
+cg_deflation* deflation_new(OSQPInt n);
+
+/**
+ * Drop the basis, e.g. after K changed
+ *
+ * @param d  Deflation basis
+ */
+void deflation_reset(cg_deflation* d);
+
+/**
+ * Move the initial iterate so that the residual is orthogonal to W:
+ * x -= W*c and r -= K*W*c with c = diag(theta) \ W'*r, where r = K*x - b
+ *
+ * @param d  Deflation basis
+ * @param x  Initial iterate (length n)
+ * @param r  Residual at x (length n)
+ */
+void deflation_project(const cg_deflation* d,
+                       OSQPFloat*          x,
+                       OSQPFloat*          r);
+
+/**
+ * Make a search direction K-orthogonal to W: p += W*(diag(theta) \ (K*W)'*y),
+ * where p = -y + beta*p_prev and y is the preconditioned residual
+ *
+ * @param d  Deflation basis
+ * @param p  Search direction (length n)
+ * @param y  Preconditioned residual (length n)
+ */
+void deflation_direction(const cg_deflation* d,
+                         OSQPFloat*          p,
+                         const OSQPFloat*    y);
+
+/**
+ * Store a search direction and its product with K if the basis is being refined
+ *
+ * @param d   Deflation basis
+ * @param p   Search direction (length n)
+ * @param Kp  K*p (length n)
+ */
+void deflation_collect(cg_deflation*    d,
+                       const OSQPFloat* p,
+                       const OSQPFloat* Kp);
+
+/**
+ * Refine the basis with the directions collected since the last call
+ *
+ * @param d  Deflation basis
+ */
+void deflation_update(cg_deflation* d);
+
+/**
+ * Free the deflation basis
+ *
+ * @param d  Deflation basis
+ */
+void deflation_free(cg_deflation* d);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEFLATION_H_ */
@@ -0,0 +1,191 @@
+#include "glob_opts.h"
+#include "ic0.h"
+#include "csc_utils.h"
+#include "kkt.h"
+
+// Maximum number of diagonal shifts tried when the factorization breaks down
+#define IC0_MAX_SHIFTS 30
+// First relative diagonal shift
+#define IC0_SHIFT_INIT 1e-3
+
+
+ic0_precond* ic0_new(const OSQPCscMatrix* P,
+                     const OSQPCscMatrix* A) {
+
+  OSQPInt        k;
+  OSQPInt        n   = P->n;
+  OSQPInt        m   = A->m;
+  OSQPInt        Anz = A->p[A->n];
+  OSQPInt*       KtoT = OSQP_NULL;
+  OSQPInt*       TtoU = OSQP_NULL;
+  OSQPCscMatrix* T    = OSQP_NULL;
+
+  ic0_precond* f = c_calloc(1, sizeof(ic0_precond));
+  if (!f) return OSQP_NULL;
+
+  f->n = n;
+
+  // Rows of A are needed to assemble A'*diag(rho)*A
+  f->AtoAt = c_malloc(c_max(Anz, 1) * sizeof(OSQPInt));
+  if (!f->AtoAt) goto fail;
+  f->At = csc_transpose(A, f->AtoAt);
+  if (!f->At) goto fail;
+
+  // Pattern of the reduced KKT matrix
+  f->Kpat = form_reduced_KKT(P, A, f->At);
+  if (!f->Kpat) goto fail;
+
+  // Transposing twice sorts the rows in every column of the factor
+  KtoT       = c_malloc(c_max(f->Kpat->p[n], 1) * sizeof(OSQPInt));
+  TtoU       = c_malloc(c_max(f->Kpat->p[n], 1) * sizeof(OSQPInt));
+  f->KpattoU = c_malloc(c_max(f->Kpat->p[n], 1) * sizeof(OSQPInt));
+  if (!KtoT || !TtoU || !f->KpattoU) goto fail;
+
+  T = csc_transpose(f->Kpat, KtoT);
+  if (!T) goto fail;
+  f->U = csc_transpose(T, TtoU);
+  if (!f->U) goto fail;
+
+  for (k = 0; k < f->Kpat->p[n]; k++) f->KpattoU[k] = TtoU[KtoT[k]];
+
+  csc_spfree(T);
+  c_free(KtoT);
+  c_free(TtoU);
+
+  f->rho_inv = c_malloc(c_max(m, 1) * sizeof(OSQPFloat));
+  f->work    = c_calloc(c_max(n, 1), sizeof(OSQPFloat));
+  if (!f->rho_inv || !f->work) {
+    ic0_free(f);
+    return OSQP_NULL;
+  }
+
+  return f;
+
+fail:
+  csc_spfree(T);
+  c_free(KtoT);
+  c_free(TtoU);
+  ic0_free(f);
+  return OSQP_NULL;
+}
+
+
+/*
+ * Overwrite the values of U (the upper triangular part of K) with its
+ * incomplete Cholesky factor, using the diagonal of K scaled by (1 + shift).
+ * Column j of U is row j of U', which is computed with a sparse triangular
+ * solve restricted to the pattern of the column.
+ * Returns 0 on success and 1 if a nonpositive pivot is found.
+ */
+static OSQPInt _ic0_factor(OSQPCscMatrix* U,
+                           OSQPFloat      shift,
+                           OSQPFloat*     x) {
+
+  OSQPInt   i, j, k, t, dj;
+  OSQPInt   n  = U->n;
+  OSQPInt*  Up = U->p;
+  OSQPInt*  Ui = U->i;
+  OSQPFloat* Ux = U->x;
+  OSQPFloat d, s;
+
+  for (j = 0; j < n; j++) {
+    dj = Up[j+1] - 1;
+
+    // Scatter the column of K above the diagonal
+    for (k = Up[j]; k < dj; k++) x[Ui[k]] = Ux[k];
+
+    d = Ux[dj] * (1.0 + shift);
+
+    // Rows are sorted, so every x[t] read below is already final
+    for (k = Up[j]; k < dj; k++) {
+      i = Ui[k];
+      s = x[i];
+      for (t = Up[i]; t < Up[i+1] - 1; t++) s -= Ux[t] * x[Ui[t]];
+      s /= Ux[Up[i+1] - 1];
+
+      x[i]  = s;
+      Ux[k] = s;
+      d    -= s * s;
+    }
+
+    // Reset the work vector
+    for (k = Up[j]; k < dj; k++) x[Ui[k]] = 0.0;
+
+    if (!(d > 0.0)) return 1;
+    Ux[dj] = c_sqrt(d);
+  }
+
+  return 0;
+}
+
+
+OSQPInt ic0_factor(ic0_precond*         f,
+                   const OSQPCscMatrix* P,
+                   const OSQPCscMatrix* A,
+                   OSQPFloat            sigma,
+                   const OSQPFloat*     rho) {
+
+  OSQPInt   k, tries;
+  OSQPInt   m     = A->m;
+  OSQPFloat shift = 0.0;
+
+  // Bring At in sync with A
+  for (k = 0; k < A->p[A->n]; k++) f->At->x[f->AtoAt[k]] = A->x[k];
+
+  for (k = 0; k < m; k++) f->rho_inv[k] = 1.0 / rho[k];
+
+  for (tries = 0; tries <= IC0_MAX_SHIFTS; tries++) {
+    update_reduced_KKT(f->U, f->Kpat, f->KpattoU, P, A, f->At,
+                       sigma, f->rho_inv, 1.0, f->work);
+
+    if (!_ic0_factor(f->U, shift, f->work)) {
+      f->shift = shift;
+      return 0;
+    }
+
+    shift = (shift == 0.0) ? IC0_SHIFT_INIT : 2.0 * shift;
+  }
+
+  return 1;
+}
+
+
+void ic0_solve(const ic0_precond* f,
+               OSQPFloat*         x) {
+
+  OSQPInt    j, k, dj;
+  OSQPInt    n  = f->n;
+  OSQPInt*   Up = f->U->p;
+  OSQPInt*   Ui = f->U->i;
+  OSQPFloat* Ux = f->U->x;
+  OSQPFloat  s;
+
+  // U' z = x
+  for (j = 0; j < n; j++) {
+    dj = Up[j+1] - 1;
+    s  = x[j];
+    for (k = Up[j]; k < dj; k++) s -= Ux[k] * x[Ui[k]];
+    x[j] = s / Ux[dj];
+  }
+
+  // U y = z
+  for (j = n - 1; j >= 0; j--) {
+    dj = Up[j+1] - 1;
+    x[j] /= Ux[dj];
+    for (k = Up[j]; k < dj; k++) x[Ui[k]] -= Ux[k] * x[j];
+  }
+}
+
+
+void ic0_free(ic0_precond* f) {
+  if (f) {
+    csc_spfree(f->At);
+    c_free(f->AtoAt);
+    csc_spfree(f->Kpat);
+    c_free(f->KpattoU);
+    csc_spfree(f->U);
+    c_free(f->rho_inv);
+    c_free(f->work);
+    c_free(f);
+  }
+}
@@ -0,0 +1,79 @@
+#ifndef IC0_H_
+#define IC0_H_
+
+#include "osqp_api_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Zero-fill incomplete Cholesky factorization of the reduced KKT matrix
+ *
+ *   K = P + sigma*I + A'*diag(rho)*A ~ U'*U
+ *
+ * used as a preconditioner by the CPU conjugate gradient solvers. The factor
+ * U has the sparsity pattern of the upper triangular part of K.
+ */
+typedef struct {
+  OSQPInt        n;         ///< dimension of K
+  OSQPCscMatrix* At;        ///< transpose of A (values refreshed before every factorization)
+  OSQPInt*       AtoAt;     ///< index of elements from A to At
+  OSQPCscMatrix* Kpat;      ///< pattern of K as built by form_reduced_KKT
+  OSQPInt*       KpattoU;   ///< index of elements from Kpat to U
+  OSQPCscMatrix* U;         ///< upper triangular factor (rows sorted, diagonal last)
+  OSQPFloat*     rho_inv;   ///< inverse of rho (length m)
+  OSQPFloat*     work;      ///< dense work vector of length n (kept at zero)
+  OSQPFloat      shift;     ///< relative diagonal shift used by the last factorization
+} ic0_precond;
+
+/**
+ * Allocate the preconditioner and compute the sparsity pattern of its factor
+ *
+ * @param  P  Objective function matrix in csc format (triu form)
+ * @param  A  Constraints matrix in csc format
+ * @return    Preconditioner (OSQP_NULL if out of memory)
+ */
+ic0_precond* ic0_new(const OSQPCscMatrix* P,
+                     const OSQPCscMatrix* A);
+
+/**
+ * Compute the values of K and its incomplete Cholesky factor
+ *
+ * If the factorization breaks down, the diagonal of K is scaled by
+ * (1 + shift) with an increasing shift until it succeeds.
+ *
+ * @param  f      Preconditioner
+ * @param  P      Objective function matrix (same pattern as in ic0_new)
+ * @param  A      Constraints matrix (same pattern as in ic0_new)
+ * @param  sigma  Regularization parameter
+ * @param  rho    Vector of penalty parameters (length m)
+ * @return        Exitflag (0 if the factor was computed)
+ */
+OSQPInt ic0_factor(ic0_precond*         f,
+                   const OSQPCscMatrix* P,
+                   const OSQPCscMatrix* A,
+                   OSQPFloat            sigma,
+                   const OSQPFloat*     rho);
+
+/**
+ * Apply the preconditioner in place: x = (U'*U) \ x
+ *
+ * @param f  Preconditioner
+ * @param x  Vector of length n
+ */
+void ic0_solve(const ic0_precond* f,
+               OSQPFloat*         x);
+
+/**
+ * Free the preconditioner
+ *
+ * @param f  Preconditioner
+ */
+void ic0_free(ic0_precond* f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IC0_H_ */
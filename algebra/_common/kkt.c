@@ -341,6 +341,102 @@ OSQPCscMatrix* form_KKT(OSQPCscMatrix* P,
   return KKT;
 }
 
+
+//walk the upper triangular pattern of P + I + A'A column by column.
+//If K is not null, the row indices are stored in it.
+//Returns the number of nonzeros.
+static OSQPInt _reduced_kkt_pattern(const OSQPCscMatrix* P,
+                                    const OSQPCscMatrix* A,
+                                    const OSQPCscMatrix* At,
+                                    OSQPCscMatrix*       K,
+                                    OSQPInt*             mark) {
+
+  OSQPInt i, j, k, r, t;
+  OSQPInt n   = P->n;
+  OSQPInt nnz = 0;
+
+  for (i = 0; i < n; i++) mark[i] = -1;
+
+  for (j = 0; j < n; j++) {
+    if (K) K->p[j] = nnz;
+
+    //diagonal is always present and goes last in the column
+    mark[j] = j;
+
+    //entries of P above the diagonal
+    for (k = P->p[j]; k < P->p[j+1]; k++) {
+      i = P->i[k];
+      if (mark[i] != j) {
+        mark[i] = j;
+        if (K) K->i[nnz] = i;
+        nnz++;
+      }
+    }
+
+    //entries of A'A above the diagonal: columns i of A
+    //sharing a row r with column j
+    for (k = A->p[j]; k < A->p[j+1]; k++) {
+      r = A->i[k];
+      for (t = At->p[r]; t < At->p[r+1]; t++) {
+        i = At->i[t];
+        if (i < j && mark[i] != j) {
+          mark[i] = j;
+          if (K) K->i[nnz] = i;
+          nnz++;
+        }
+      }
+    }
+
+    if (K) K->i[nnz] = j;
+    nnz++;
+  }
+  if (K) K->p[n] = nnz;
+
+  return nnz;
+}
+
+OSQPInt count_reduced_KKT_nnz(const OSQPCscMatrix* P,
+                              const OSQPCscMatrix* A,
+                              const OSQPCscMatrix* At) {
+
+  OSQPInt  nnz;
+  OSQPInt* mark = c_malloc(P->n * sizeof(OSQPInt));
+
+  if (!mark) return -1;
+
+  nnz = _reduced_kkt_pattern(P, A, At, OSQP_NULL, mark);
+  c_free(mark);
+
+  return nnz;
+}
+
+OSQPCscMatrix* form_reduced_KKT(const OSQPCscMatrix* P,
+                                const OSQPCscMatrix* A,
+                                const OSQPCscMatrix* At) {
+
+  OSQPInt        j, nnz;
+  OSQPInt        n = P->n;
+  OSQPInt*       mark;
+  OSQPCscMatrix* K;
+
+  nnz = count_reduced_KKT_nnz(P, A, At);
+  if (nnz < 0) return OSQP_NULL;
+
+  K    = csc_spalloc(n, n, nnz, 1, 0);
+  mark = c_malloc(n * sizeof(OSQPInt));
+  if (!K || !mark) {
+    csc_spfree(K);
+    c_free(mark);
+    return OSQP_NULL;
+  }
+
+  _reduced_kkt_pattern(P, A, At, K, mark);
+  for (j = 0; j < nnz; j++) K->x[j] = 0.0;
+
+  c_free(mark);
+  return K;
+}
+
 #endif /* ifndef OSQP_EMBEDDED_MODE */
 
 
@@ -421,4 +517,46 @@ void update_KKT_param2(OSQPCscMatrix* KKT,
   }
 }
 
+
+void update_reduced_KKT(OSQPCscMatrix*       KKT,
+                        const OSQPCscMatrix* Kred,
+                        const OSQPInt*       KredtoKKT,
+                        const OSQPCscMatrix* P,
+                        const OSQPCscMatrix* A,
+                        const OSQPCscMatrix* At,
+                        OSQPFloat            param1,
+                        const OSQPFloat*     param2,
+                        OSQPFloat            param2_sc,
+                        OSQPFloat*           work) {
+
+  OSQPInt   i, j, k, r, t;
+  OSQPInt   n = Kred->n;
+  OSQPFloat a;
+
+  //accumulate column j of the upper triangular part in the dense
+  //work vector, then gather it on the pattern of Kred (zeroing work)
+  for (j = 0; j < n; j++) {
+
+    for (k = P->p[j]; k < P->p[j+1]; k++) {
+      work[P->i[k]] += P->x[k];
+    }
+    work[j] += param1;
+
+    for (k = A->p[j]; k < A->p[j+1]; k++) {
+      r = A->i[k];
+      a = A->x[k] / (param2 ? param2[r] : param2_sc);
+      for (t = At->p[r]; t < At->p[r+1]; t++) {
+        i = At->i[t];
+        if (i <= j) work[i] += a * At->x[t];
+      }
+    }
+
+    for (k = Kred->p[j]; k < Kred->p[j+1]; k++) {
+      i = Kred->i[k];
+      KKT->x[KredtoKKT ? KredtoKKT[k] : k] = work[i];
+      work[i] = 0.0;
+    }
+  }
+}
+
 #endif // OSQP_EMBEDDED_MODE != 1
@@ -44,6 +44,40 @@ extern "C" {
                          OSQPInt*       PtoKKT,
                          OSQPInt*       AtoKKT,
                          OSQPInt*       param2toKKT);
+
+
+/**
+ * Count the nonzeros in the upper triangular part of the reduced KKT matrix
+ *
+ * P + param1 I + A' diag(param2)^-1 A
+ *
+ * i.e. the Schur complement of the lower right block of the KKT matrix
+ * formed by form_KKT. The sparsity pattern is the union of the patterns of
+ * P, of the identity and of A'A, so it does not depend on the parameters.
+ *
+ * @param  P   data for P in csc format (triu form)
+ * @param  A   data for A in csc format
+ * @param  At  transpose of A in csc format (only the pattern is used)
+ * @return     number of nonzeros (-1 if out of memory)
+ */
+OSQPInt count_reduced_KKT_nnz(const OSQPCscMatrix* P,
+                              const OSQPCscMatrix* A,
+                              const OSQPCscMatrix* At);
+
+/**
+ * Form the sparsity pattern of the upper triangular part of the reduced KKT
+ * matrix (see count_reduced_KKT_nnz). The diagonal element is the last one
+ * in every column. The values are allocated but not computed, use
+ * update_reduced_KKT to fill them in.
+ *
+ * @param  P   data for P in csc format (triu form)
+ * @param  A   data for A in csc format
+ * @param  At  transpose of A in csc format (only the pattern is used)
+ * @return     reduced KKT matrix in csc format (triu form)
+ */
+OSQPCscMatrix* form_reduced_KKT(const OSQPCscMatrix* P,
+                                const OSQPCscMatrix* A,
+                                const OSQPCscMatrix* At);
 # endif // ifndef OSQP_EMBEDDED_MODE
 
 
@@ -100,6 +134,39 @@ void update_KKT_param2(OSQPCscMatrix* KKT,
                        OSQPInt*       param2toKKT,
                        OSQPInt        m);
 
+
+/**
+ * Compute the values of the reduced KKT matrix
+ *
+ * P + param1 I + A' diag(param2)^-1 A
+ *
+ * on the sparsity pattern built by form_reduced_KKT. The pattern does not
+ * change with the parameters or the values of P and A, so this is all that is
+ * needed before a numeric refactorization.
+ *
+ * @param KKT        matrix whose values are overwritten
+ * @param Kred       sparsity pattern of the reduced KKT matrix
+ * @param KredtoKKT  index mapping from elements of Kred to KKT
+ *                   (OSQP_NULL if KKT has the same layout as Kred)
+ * @param P          data for P in csc format (triu form)
+ * @param A          data for A in csc format
+ * @param At         transpose of A in csc format (values in sync with A)
+ * @param param1     regularization parameter
+ * @param param2     regularization parameter (vector)
+ * @param param2_sc  regularization parameter (scalar, used if param2 is NULL)
+ * @param work       work vector of length n, all zeros on entry (and on exit)
+ */
+void update_reduced_KKT(OSQPCscMatrix*       KKT,
+                        const OSQPCscMatrix* Kred,
+                        const OSQPInt*       KredtoKKT,
+                        const OSQPCscMatrix* P,
+                        const OSQPCscMatrix* A,
+                        const OSQPCscMatrix* At,
+                        OSQPFloat            param1,
+                        const OSQPFloat*     param2,
+                        OSQPFloat            param2_sc,
+                        OSQPFloat*           work);
+
 # endif // OSQP_EMBEDDED_MODE != 1
 
 #ifdef __cplusplus
@@ -38,21 +38,28 @@ void warm_start_linsys_solver_qdldl(qdldl_solver*      s,
 
 #ifndef OSQP_EMBEDDED_MODE
 
+// Alignment (in bytes) of the arrays carved from the solver arena
+#define QDLDL_ARENA_ALIGN 64
+
+// Free the data used to assemble the reduced KKT matrix
+static void free_reduced_KKT(qdldl_solver* s) {
+    if (s->At)        csc_spfree(s->At);
+    if (s->AtoAt)     c_free(s->AtoAt);
+    if (s->Kred)      csc_spfree(s->Kred);
+    if (s->KredtoKKT) c_free(s->KredtoKKT);
+
+    s->At        = OSQP_NULL;
+    s->AtoAt     = OSQP_NULL;
+    s->Kred      = OSQP_NULL;
+    s->KredtoKKT = OSQP_NULL;
+}
+
 // Free LDL Factorization structure
 void free_linsys_solver_qdldl(qdldl_solver* s) {
     if (s) {
-        if (s->L) {
-            if (s->L->p) c_free(s->L->p);
-            if (s->L->i) c_free(s->L->i);
-            if (s->L->x) c_free(s->L->x);
-            c_free(s->L);
-        }
-
-        if (s->P)           c_free(s->P);
-        if (s->Dinv)        c_free(s->Dinv);
-        if (s->bp)          c_free(s->bp);
-        if (s->sol)         c_free(s->sol);
-        if (s->rho_inv_vec) c_free(s->rho_inv_vec);
+        // L, the solve vectors and the QDLDL workspace
+        if (s->arena) c_free(s->arena);
+        if (s->bpk)   c_free(s->bpk);
 
         // These are required for matrix updates
         if (s->KKT)       csc_spfree(s->KKT);
@@ -62,21 +69,111 @@ void free_linsys_solver_qdldl(qdldl_solver* s) {
 
         if (s->adj)         c_free(s->adj);
 
-        // QDLDL workspace
-        if (s->D)         c_free(s->D);
-        if (s->etree)     c_free(s->etree);
-        if (s->Lnz)       c_free(s->Lnz);
-        if (s->iwork)     c_free(s->iwork);
-        if (s->bwork)     c_free(s->bwork);
-        if (s->fwork)     c_free(s->fwork);
+        // Reduced KKT system
+        free_reduced_KKT(s);
+
         c_free(s);
 
     }
 }
 
 
+// Reserve size bytes at *offset in the arena starting at base (only advance *offset if base is null)
+static void* arena_block(char*   base,
+                         size_t* offset,
+                         size_t  size) {
+    void* block = base ? (void*)(base + *offset) : OSQP_NULL;
+
+    *offset += (size + QDLDL_ARENA_ALIGN - 1) / QDLDL_ARENA_ALIGN * QDLDL_ARENA_ALIGN;
+    return block;
+}
+
+
 /**
- * Compute LDL factorization of matrix A
+ * Lay out the solver arena.
+ *
+ * The arrays read in every solve (L, Dinv, P, bp and sol) are contiguous at the
+ * start of the arena, followed by the parameter vector and the workspace of the
+ * numeric factorization. Every array starts on a QDLDL_ARENA_ALIGN boundary.
+ *
+ * @param  s     Private workspace (its pointers are assigned only if base is not null)
+ * @param  base  Aligned start of the arena, or null to only compute its size
+ * @param  nKKT  Dimension of the factored matrix
+ * @param  Lnz   Number of nonzeros in L
+ * @return       Size of the arena in bytes
+ */
+static size_t arena_layout(qdldl_solver* s,
+                           char*         base,
+                           OSQPInt       nKKT,
+                           OSQPInt       Lnz) {
+
+    size_t         offset = 0;
+    OSQPCscMatrix* L;
+    OSQPInt       *Lp, *Li, *P, *etree, *Lnzv, *iwork;
+    OSQPFloat     *Lx, *Dinv, *bp, *sol, *rho_inv_vec, *D, *fwork, *rwork;
+    QDLDL_bool*    bwork;
+
+    // Solve
+    L     = (OSQPCscMatrix *)arena_block(base, &offset, sizeof(OSQPCscMatrix));
+    Lp    = (OSQPInt *)arena_block(base, &offset, (nKKT + 1) * sizeof(QDLDL_int));
+    Li    = (OSQPInt *)arena_block(base, &offset, Lnz * sizeof(QDLDL_int));
+    Lx    = (OSQPFloat *)arena_block(base, &offset, Lnz * sizeof(QDLDL_float));
+    Dinv  = (OSQPFloat *)arena_block(base, &offset, nKKT * sizeof(QDLDL_float));
+    P     = (OSQPInt *)arena_block(base, &offset, nKKT * sizeof(QDLDL_int));
+    bp    = (OSQPFloat *)arena_block(base, &offset, nKKT * sizeof(QDLDL_float));
+    sol   = (OSQPFloat *)arena_block(base, &offset, nKKT * sizeof(QDLDL_float));
+
+    // Parameter vector
+    rho_inv_vec = s->rho_inv_vec ? (OSQPFloat *)arena_block(base, &offset, s->m * sizeof(OSQPFloat)) : OSQP_NULL;
+
+    // Numeric factorization
+    D     = (OSQPFloat *)arena_block(base, &offset, nKKT * sizeof(QDLDL_float));
+    etree = (OSQPInt *)arena_block(base, &offset, nKKT * sizeof(QDLDL_int));
+    Lnzv  = (OSQPInt *)arena_block(base, &offset, nKKT * sizeof(QDLDL_int));
+    iwork = (OSQPInt *)arena_block(base, &offset, 3 * nKKT * sizeof(QDLDL_int));
+    bwork = (QDLDL_bool *)arena_block(base, &offset, nKKT * sizeof(QDLDL_bool));
+    fwork = (OSQPFloat *)arena_block(base, &offset, nKKT * sizeof(QDLDL_float));
+    rwork = s->reduced ? (OSQPFloat *)arena_block(base, &offset, s->n * sizeof(OSQPFloat)) : OSQP_NULL;
+
+    if (base) {
+        L->m     = nKKT;
+        L->n     = nKKT;
+        L->nz    = -1;
+        L->nzmax = Lnz;
+        L->p     = Lp;
+        L->i     = Li;
+        L->x     = Lx;
+
+        s->L           = L;
+        s->Dinv        = Dinv;
+        s->P           = P;
+        s->bp          = bp;
+        s->sol         = sol;
+        s->rho_inv_vec = rho_inv_vec;
+        s->D           = D;
+        s->etree       = etree;
+        s->Lnz         = Lnzv;
+        s->iwork       = iwork;
+        s->bwork       = bwork;
+        s->fwork       = fwork;
+        s->rwork       = rwork;
+    }
+
+    return offset;
+}
+
+
+// Memory used by a CSC matrix in bytes
+static size_t csc_memory(const OSQPCscMatrix* M) {
+    if (!M) return 0;
+    return sizeof(OSQPCscMatrix) + (M->n + 1) * sizeof(OSQPInt) +
+           M->nzmax * (sizeof(OSQPInt) + sizeof(OSQPFloat));
+}
+
+
+/**
+ * Compute the numeric LDL factorization of matrix A
+ * (the elimination tree and the memory for L are already in place)
  * @param  A    Matrix to be factorized
  * @param  p    Private workspace
  * @param  nvar Number of QP variables
@@ -86,31 +183,8 @@ static OSQPInt LDL_factor(OSQPCscMatrix* A,
                           qdldl_solver*  p,
                           OSQPInt        nvar) {
 
-    OSQPInt sum_Lnz;
     OSQPInt factor_status;
 
-    // Compute elimination tree
-    osqp_profiler_sec_push(OSQP_PROFILER_SEC_LINSYS_SYM_FAC);
-    sum_Lnz = QDLDL_etree(A->n, A->p, A->i, p->iwork, p->Lnz, p->etree);
-    osqp_profiler_sec_pop(OSQP_PROFILER_SEC_LINSYS_SYM_FAC);
-
-    if (sum_Lnz < 0){
-      // Error
-      c_eprint("Error in KKT matrix LDL factorization when computing the elimination tree.");
-      if(sum_Lnz == -1){
-        c_eprint("Matrix is not perfectly upper triangular.");
-      }
-      else if(sum_Lnz == -2){
-        c_eprint("Integer overflow in L nonzero count.");
-      }
-      return sum_Lnz;
-    }
-
-    // Allocate memory for Li and Lx
-    p->L->i = (OSQPInt *)c_malloc(sizeof(OSQPInt)*sum_Lnz);
-    p->L->x = (OSQPFloat *)c_malloc(sizeof(OSQPFloat)*sum_Lnz);
-    p->L->nzmax = sum_Lnz;
-
     // Factor matrix
     osqp_profiler_sec_push(OSQP_PROFILER_SEC_LINSYS_NUM_FAC);
     factor_status = QDLDL_factor(A->n, A->p, A->i, A->x,
@@ -134,6 +208,27 @@ static OSQPInt LDL_factor(OSQPCscMatrix* A,
 }
 
 
+// Compute the AMD fill-reducing ordering perm of the symmetric matrix K
+static OSQPInt amd_ordering(const OSQPCscMatrix* K,
+                            OSQPInt*             perm) {
+    OSQPFloat* info;
+    OSQPInt    amd_status;
+
+    info = (OSQPFloat *)c_malloc(AMD_INFO * sizeof(OSQPFloat));
+
+#ifdef OSQP_USE_LONG
+    amd_status = amd_l_order(K->n, K->p, K->i, perm, (OSQPFloat *)OSQP_NULL, info);
+#else
+    amd_status = amd_order(K->n, K->p, K->i, perm, (OSQPFloat *)OSQP_NULL, info);
+#endif
+
+    // Free Amd info
+    c_free(info);
+
+    return amd_status;
+}
+
+
 static OSQPInt permute_KKT(OSQPCscMatrix** KKT,
                            qdldl_solver*   p,
                            OSQPInt         Pnz,
@@ -142,7 +237,6 @@ static OSQPInt permute_KKT(OSQPCscMatrix** KKT,
                            OSQPInt*        PtoKKT,
                            OSQPInt*        AtoKKT,
                            OSQPInt*        rhotoKKT) {
-    OSQPFloat* info;
     OSQPInt    amd_status;
     OSQPInt*   Pinv;
     OSQPInt*   KtoPKPt;
@@ -150,17 +244,9 @@ static OSQPInt permute_KKT(OSQPCscMatrix** KKT,
 
     OSQPCscMatrix* KKT_temp;
 
-    info = (OSQPFloat *)c_malloc(AMD_INFO * sizeof(OSQPFloat));
-
     // Compute permutation matrix P using AMD
-#ifdef OSQP_USE_LONG
-    amd_status = amd_l_order((*KKT)->n, (*KKT)->p, (*KKT)->i, p->P, (OSQPFloat *)OSQP_NULL, info);
-#else
-    amd_status = amd_order((*KKT)->n, (*KKT)->p, (*KKT)->i, p->P, (OSQPFloat *)OSQP_NULL, info);
-#endif
+    amd_status = amd_ordering(*KKT, p->P);
     if (amd_status < 0) {
-        // Free Amd info and return an error
-        c_free(info);
         return amd_status;
     }
 
@@ -205,8 +291,108 @@ static OSQPInt permute_KKT(OSQPCscMatrix** KKT,
     (*KKT) = KKT_temp;
     // Free Pinv
     c_free(Pinv);
-    // Free Amd info
-    c_free(info);
+
+    return 0;
+}
+
+
+/**
+ * Replace the permuted KKT matrix with the reduced KKT matrix
+ *
+ *   P + sigma*I + A'*diag(rho)*A
+ *
+ * when its factor is estimated to be smaller. The factor sizes come from the
+ * elimination trees of both matrices in their AMD orderings, and the reduced
+ * system is charged with the extra products with A and A' in every solve.
+ *
+ * @param  s    Private workspace (KKT mappings already computed)
+ * @param  P    Objective function matrix (upper triangular form)
+ * @param  A    Constraints matrix
+ * @param  KKT  Permuted KKT matrix (replaced by the pattern of the reduced system if it is chosen)
+ * @return      exitstatus (0 is good, whichever matrix is chosen)
+ */
+static OSQPInt select_reduced_KKT(qdldl_solver*        s,
+                                  const OSQPCscMatrix* P,
+                                  const OSQPCscMatrix* A,
+                                  OSQPCscMatrix**      KKT) {
+
+    OSQPInt        i;
+    OSQPInt        n   = s->n;
+    OSQPInt        Anz = A->p[n];
+    OSQPInt        Lnz_full, Lnz_red, Kred_nnz;
+    OSQPInt*       Pred = OSQP_NULL;  // AMD ordering of the reduced KKT matrix
+    OSQPInt*       Pinv = OSQP_NULL;
+    OSQPCscMatrix* KKT_red;
+
+    // Factor size of the full KKT matrix
+    Lnz_full = QDLDL_etree((*KKT)->n, (*KKT)->p, (*KKT)->i, s->iwork, s->Lnz, s->etree);
+    if (Lnz_full < 0) return 0; // LDL_factor reports the error
+
+    // Rows of A are needed to assemble A'*diag(rho)*A
+    s->AtoAt = (OSQPInt *)c_malloc(c_max(Anz, 1) * sizeof(OSQPInt));
+    if (!s->AtoAt) return OSQP_MEM_ALLOC_ERROR;
+    s->At = csc_transpose(A, s->AtoAt);
+    if (!s->At) return OSQP_MEM_ALLOC_ERROR;
+
+    // The factor contains at least the strictly upper triangular part of the
+    // reduced matrix, which rules it out before computing an ordering
+    Kred_nnz = count_reduced_KKT_nnz(P, A, s->At);
+    if (Kred_nnz < 0) return OSQP_MEM_ALLOC_ERROR;
+    if (Kred_nnz - n + Anz >= Lnz_full) {
+        free_reduced_KKT(s);
+        return 0;
+    }
+
+    // Form and permute the reduced KKT matrix
+    s->Kred      = form_reduced_KKT(P, A, s->At);
+    s->KredtoKKT = (OSQPInt *)c_malloc(Kred_nnz * sizeof(OSQPInt));
+    Pred         = (OSQPInt *)c_malloc(n * sizeof(OSQPInt));
+    if (!s->Kred || !s->KredtoKKT || !Pred) {
+        c_free(Pred);
+        return OSQP_MEM_ALLOC_ERROR;
+    }
+
+    if (amd_ordering(s->Kred, Pred) < 0) {
+        c_free(Pred);
+        return OSQP_LINSYS_SOLVER_INIT_ERROR;
+    }
+
+    Pinv    = csc_pinv(Pred, n);
+    KKT_red = Pinv ? csc_symperm(s->Kred, Pinv, s->KredtoKKT, 1) : OSQP_NULL;
+    c_free(Pinv);
+    if (!KKT_red) {
+        c_free(Pred);
+        return OSQP_MEM_ALLOC_ERROR;
+    }
+
+    // Factor size of the reduced KKT matrix
+    Lnz_red = QDLDL_etree(n, KKT_red->p, KKT_red->i, s->iwork, s->Lnz, s->etree);
+    if ((Lnz_red < 0) || (Lnz_red + Anz >= Lnz_full)) {
+        c_free(Pred);
+        csc_spfree(KKT_red);
+        free_reduced_KKT(s);
+        return 0;
+    }
+
+    // Use the reduced KKT matrix from now on (its values are filled once the
+    // solver arena is allocated)
+    s->reduced = 1;
+    s->Pdata   = P;
+    s->Adata   = A;
+
+    for (i = 0; i < n; i++) s->P[i] = Pred[i];
+    c_free(Pred);
+
+    // The full KKT matrix and its mappings are not needed anymore
+    csc_spfree(*KKT);
+    *KKT = KKT_red;
+
+    c_free(s->PtoKKT);
+    c_free(s->AtoKKT);
+    c_free(s->rhotoKKT);
+    s->PtoKKT   = OSQP_NULL;
+    s->AtoKKT   = OSQP_NULL;
+    s->rhotoKKT = OSQP_NULL;
 
     return 0;
 }
@@ -221,12 +407,21 @@ OSQPInt init_linsys_solver_qdldl(qdldl_solver**      sp,
                                  OSQPInt             polishing) {
 
     // Define Variables
-    OSQPCscMatrix* KKT_temp; // Temporary KKT pointer
+    OSQPCscMatrix* KKT_temp = OSQP_NULL; // Temporary KKT pointer
     OSQPInt    i;         // Loop counter
     OSQPInt    m, n;      // Dimensions of A
     OSQPInt    n_plus_m;  // Define n_plus_m dimension
+    OSQPInt    nKKT;      // Dimension of the factored matrix
+    OSQPInt    sum_Lnz;   // Number of nonzeros in L
+    OSQPInt    exitflag = OSQP_LINSYS_SOLVER_INIT_ERROR;
     OSQPFloat* rhov;      // used for direct access to rho_vec data when polishing=false
     OSQPFloat  sigma = settings->sigma;
+    size_t     arena_size;
+    char*      arena_base;
+
+    // Symbolic analysis workspace, released once the solver arena is allocated
+    OSQPInt*   sym_iwork = OSQP_NULL;
+    OSQPFloat* sym_rho   = OSQP_NULL;
 
     // Allocate private structure to store KKT factorization
     qdldl_solver* s = c_calloc(1, sizeof(qdldl_solver));
@@ -255,7 +450,8 @@ OSQPInt init_linsys_solver_qdldl(qdldl_solver**      sp,
 
 
 #ifndef OSQP_EMBEDDED_MODE
-    s->free = &free_linsys_solver_qdldl;
+    s->free        = &free_linsys_solver_qdldl;
+    s->solve_multi = &solve_multi_linsys_qdldl;
 #endif
 
 #if OSQP_EMBEDDED_MODE != 1
@@ -269,59 +465,41 @@ OSQPInt init_linsys_solver_qdldl(qdldl_solver**      sp,
     // Set number of threads to 1 (single threaded)
     s->nthreads = 1;
 
-    // Sparse matrix L (lower triangular)
-    // NB: We don not allocate L completely (CSC elements)
-    //      L will be allocated during the factorization depending on the
-    //      resulting number of elements.
-    s->L = c_calloc(1, sizeof(OSQPCscMatrix));
-    s->L->m  = n_plus_m;
-    s->L->n  = n_plus_m;
-    s->L->nz = -1;
-    s->L->p  = (OSQPInt *)c_malloc((n_plus_m+1) * sizeof(QDLDL_int));
-
-    // Diagonal matrix stored as a vector D
-    s->Dinv = (QDLDL_float *)c_malloc(sizeof(QDLDL_float) * n_plus_m);
-    s->D    = (QDLDL_float *)c_malloc(sizeof(QDLDL_float) * n_plus_m);
-
-    // Permutation vector P
-    s->P    = (QDLDL_int *)c_malloc(sizeof(QDLDL_int) * n_plus_m);
-
-    // Working vector
-    s->bp   = (QDLDL_float *)c_malloc(sizeof(QDLDL_float) * n_plus_m);
-
-    // Solution vector
-    s->sol  = (QDLDL_float *)c_malloc(sizeof(QDLDL_float) * n_plus_m);
-
-    // Parameter vector
+    // The size of L is only known after the symbolic analysis, so the
+    // permutation, the elimination tree and the parameter vector live in a
+    // temporary workspace until the solver arena is allocated
+    sym_iwork = (OSQPInt *)c_malloc(6 * n_plus_m * sizeof(QDLDL_int));
     if (rho_vec)
-      s->rho_inv_vec = (OSQPFloat *)c_malloc(sizeof(OSQPFloat) * m);
+      sym_rho = (OSQPFloat *)c_malloc(c_max(m, 1) * sizeof(OSQPFloat));
     // else it is NULL
 
-    // Elimination tree workspace
-    s->etree = (QDLDL_int *)c_malloc(n_plus_m * sizeof(QDLDL_int));
-    s->Lnz   = (QDLDL_int *)c_malloc(n_plus_m * sizeof(QDLDL_int));
-
-    // Lx and Li are sparsity dependent, so set them to
-    // null initially so we don't try to free them prematurely
-    s->L->i = OSQP_NULL;
-    s->L->x = OSQP_NULL;
+    if (!sym_iwork || (rho_vec && !sym_rho)) {
+        c_eprint("Error allocating the KKT symbolic analysis workspace");
+        goto init_fail;
+    }
 
-    // Preallocate workspace
-    s->iwork = (QDLDL_int *)c_malloc(sizeof(QDLDL_int)*(3*n_plus_m));
-    s->bwork = (QDLDL_bool *)c_malloc(sizeof(QDLDL_bool)*n_plus_m);
-    s->fwork = (QDLDL_float *)c_malloc(sizeof(QDLDL_float)*n_plus_m);
+    s->P           = sym_iwork;
+    s->etree       = sym_iwork + n_plus_m;
+    s->Lnz         = sym_iwork + 2 * n_plus_m;
+    s->iwork       = sym_iwork + 3 * n_plus_m;
+    s->rho_inv_vec = sym_rho;
 
     // Form and permute KKT matrix
     if (polishing){ // Called from polish()
 
+        // Keep the indices of P and A so that polish() can refactor a
+        // cached factorization after the data change
+        s->PtoKKT = c_malloc(c_max(P->csc->p[n], 1) * sizeof(OSQPInt));
+        s->AtoKKT = c_malloc(c_max(A->csc->p[n], 1) * sizeof(OSQPInt));
+
         KKT_temp = form_KKT(P->csc,A->csc,
                             0, //format = 0 means CSC
                             sigma, s->rho_inv_vec, sigma,
-                            OSQP_NULL, OSQP_NULL, OSQP_NULL);
+                            s->PtoKKT, s->AtoKKT, OSQP_NULL);
 
         // Permute matrix
         if (KKT_temp)
-            permute_KKT(&KKT_temp, s, OSQP_NULL, OSQP_NULL, OSQP_NULL, OSQP_NULL, OSQP_NULL, OSQP_NULL);
+            permute_KKT(&KKT_temp, s, P->csc->p[n], A->csc->p[n], 0, s->PtoKKT, s->AtoKKT, OSQP_NULL);
     }
     else { // Called from ADMM algorithm
 
@@ -350,41 +528,107 @@ OSQPInt init_linsys_solver_qdldl(qdldl_solver**      sp,
         if (KKT_temp){
             permute_KKT(&KKT_temp, s, P->csc->p[n], A->csc->p[n], m, s->PtoKKT, s->AtoKKT, s->rhotoKKT);
         }
+
+        // Factor the reduced KKT matrix instead if it is cheaper
+        if (KKT_temp && (m > 0) && select_reduced_KKT(s, P->csc, A->csc, &KKT_temp)) {
+            c_eprint("Error forming the reduced KKT matrix");
+            goto init_fail;
+        }
     }
 
     // Check if matrix has been created
     if (!KKT_temp){
         c_eprint("Error forming and permuting KKT matrix");
-        free_linsys_solver_qdldl(s);
-        *sp = OSQP_NULL;
-        return OSQP_LINSYS_SOLVER_INIT_ERROR;
+        goto init_fail;
     }
 
-    // Factorize the KKT matrix
-    if (LDL_factor(KKT_temp, s, n) < 0) {
-        csc_spfree(KKT_temp);
-        free_linsys_solver_qdldl(s);
-        *sp = OSQP_NULL;
-        return OSQP_NONCVX_ERROR;
+    // Compute elimination tree
+    nKKT = KKT_temp->n;
+
+    osqp_profiler_sec_push(OSQP_PROFILER_SEC_LINSYS_SYM_FAC);
+    sum_Lnz = QDLDL_etree(nKKT, KKT_temp->p, KKT_temp->i, s->iwork, s->Lnz, s->etree);
+    osqp_profiler_sec_pop(OSQP_PROFILER_SEC_LINSYS_SYM_FAC);
+
+    if (sum_Lnz < 0){
+      // Error
+      c_eprint("Error in KKT matrix LDL factorization when computing the elimination tree.");
+      if(sum_Lnz == -1){
+        c_eprint("Matrix is not perfectly upper triangular.");
+      }
+      else if(sum_Lnz == -2){
+        c_eprint("Integer overflow in L nonzero count.");
+      }
+      exitflag = OSQP_NONCVX_ERROR;
+      goto init_fail;
     }
 
-    if (polishing){ // If KKT passed, assign it to KKT_temp
-        // Polish, no need for KKT_temp
-        csc_spfree(KKT_temp);
+    // Allocate the solver arena (padded so that its start can be aligned)
+    arena_size = arena_layout(s, OSQP_NULL, nKKT, sum_Lnz);
+    s->arena   = c_malloc(arena_size + QDLDL_ARENA_ALIGN - 1);
+    if (!s->arena) {
+        c_eprint("Error allocating the KKT factorization");
+        goto init_fail;
     }
-    else { // If not embedded option 1 copy pointer to KKT_temp. Do not free it.
-        s->KKT = KKT_temp;
+    arena_base = (char *)s->arena + (QDLDL_ARENA_ALIGN - (size_t)s->arena % QDLDL_ARENA_ALIGN) % QDLDL_ARENA_ALIGN;
+    arena_layout(s, arena_base, nKKT, sum_Lnz);
+
+    // Move the results of the symbolic analysis into the arena
+    for (i = 0; i < nKKT; i++) {
+        s->P[i]     = sym_iwork[i];
+        s->etree[i] = sym_iwork[n_plus_m + i];
+        s->Lnz[i]   = sym_iwork[2 * n_plus_m + i];
+    }
+    if (sym_rho) {
+        for (i = 0; i < m; i++) s->rho_inv_vec[i] = sym_rho[i];
+    }
+    c_free(sym_iwork);
+    c_free(sym_rho);
+    sym_iwork = OSQP_NULL;
+    sym_rho   = OSQP_NULL;
+
+    // Assemble the reduced KKT matrix on its pattern
+    if (s->reduced) {
+        for (i = 0; i < n; i++) s->rwork[i] = 0.0;
+        update_reduced_KKT(KKT_temp, s->Kred, s->KredtoKKT, P->csc, A->csc, s->At,
+                           s->sigma, s->rho_inv_vec, s->rho_inv, s->rwork);
+    }
+
+    // Factorize the KKT matrix
+    if (LDL_factor(KKT_temp, s, n) < 0) {
+        exitflag = OSQP_NONCVX_ERROR;
+        goto init_fail;
     }
 
+    // Memory used by the solver
+    s->memory = (OSQPFloat)(arena_size + QDLDL_ARENA_ALIGN - 1 + csc_memory(KKT_temp) +
+                            csc_memory(s->At) + csc_memory(s->Kred));
+    if (s->PtoKKT)    s->memory += P->csc->p[n] * sizeof(OSQPInt);
+    if (s->AtoKKT)    s->memory += A->csc->p[n] * sizeof(OSQPInt);
+    if (s->rhotoKKT)  s->memory += m * sizeof(OSQPInt);
+    if (s->AtoAt)     s->memory += A->csc->p[n] * sizeof(OSQPInt);
+    if (s->KredtoKKT) s->memory += s->Kred->p[n] * sizeof(OSQPInt);
+
+    // Keep the KKT matrix for matrix updates. Do not free it.
+    s->KKT = KKT_temp;
+
 
     // No error
     return 0;
+
+init_fail:
+    c_free(sym_iwork);
+    c_free(sym_rho);
+    csc_spfree(KKT_temp);
+    free_linsys_solver_qdldl(s);
+    *sp = OSQP_NULL;
+    return exitflag;
 }
 
 #endif  // OSQP_EMBEDDED_MODE
 
 const char* name_qdldl(qdldl_solver* s) {
-    OSQP_UnusedVar(s);
+    if (s->reduced)
+        return "QDLDL v" STRINGIZE(QDLDL_VERSION_MAJOR) "." STRINGIZE(QDLDL_VERSION_MINOR) "." STRINGIZE(QDLDL_VERSION_PATCH) " (reduced KKT)";
 
     return "QDLDL v" STRINGIZE(QDLDL_VERSION_MAJOR) "." STRINGIZE(QDLDL_VERSION_MINOR) "." STRINGIZE(QDLDL_VERSION_PATCH);
 }
@@ -415,13 +659,89 @@ static void LDLSolve(OSQPFloat*           x,
 }
 
 
+/* form the right-hand side of the reduced KKT system x = b1 + A'*diag(rho)*b2 */
+static void reduced_KKT_rhs(const qdldl_solver* s,
+                            const OSQPFloat*    bv,
+                            OSQPFloat*          x) {
+
+  OSQPInt    j, k;
+  OSQPInt    n  = s->n;
+  OSQPInt*   Ap = s->Adata->p;
+  OSQPInt*   Ai = s->Adata->i;
+  OSQPFloat* Ax = s->Adata->x;
+
+  for (j = 0 ; j < n ; j++) {
+    x[j] = bv[j];
+    if (s->rho_inv_vec) {
+      for (k = Ap[j] ; k < Ap[j+1] ; k++) {
+        x[j] += Ax[k] * bv[n + Ai[k]] / s->rho_inv_vec[Ai[k]];
+      }
+    }
+    else {
+      for (k = Ap[j] ; k < Ap[j+1] ; k++) {
+        x[j] += Ax[k] * bv[n + Ai[k]] / s->rho_inv;
+      }
+    }
+  }
+}
+
+
+/* store (x_tilde, z_tilde) = (x, A*x) in b from the solution x of the reduced KKT system */
+static void reduced_KKT_sol(const qdldl_solver* s,
+                            const OSQPFloat*    x,
+                            OSQPFloat*          bv) {
+
+  OSQPInt    j, k;
+  OSQPInt    n  = s->n;
+  OSQPInt    m  = s->m;
+  OSQPInt*   Ap = s->Adata->p;
+  OSQPInt*   Ai = s->Adata->i;
+  OSQPFloat* Ax = s->Adata->x;
+
+  for (j = 0 ; j < m ; j++) {
+    bv[n + j] = 0.0;
+  }
+  for (j = 0 ; j < n ; j++) {
+    bv[j] = x[j];
+    for (k = Ap[j] ; k < Ap[j+1] ; k++) {
+      bv[n + Ai[k]] += Ax[k] * x[j];
+    }
+  }
+}
+
+
+/* store (x_tilde, z_tilde) in b from the solution sol of the KKT system */
+static void full_KKT_sol(const qdldl_solver* s,
+                         const OSQPFloat*    sol,
+                         OSQPFloat*          bv) {
+
+  OSQPInt j;
+  OSQPInt n = s->n;
+  OSQPInt m = s->m;
+
+  /* copy x_tilde from sol */
+  for (j = 0 ; j < n ; j++) {
+    bv[j] = sol[j];
+  }
+
+  /* compute z_tilde from b and sol */
+  if (s->rho_inv_vec) {
+    for (j = 0 ; j < m ; j++) {
+      bv[j + n] += s->rho_inv_vec[j] * sol[j + n];
+    }
+  }
+  else {
+    for (j = 0 ; j < m ; j++) {
+      bv[j + n] += s->rho_inv * sol[j + n];
+    }
+  }
+}
+
+
 OSQPInt solve_linsys_qdldl(qdldl_solver* s,
                            OSQPVectorf*  b,
                            OSQPInt       admm_iter) {
 
-  OSQPInt    j;
-  OSQPInt    n = s->n;
-  OSQPInt    m = s->m;
   OSQPFloat* bv = b->values;
 
   // Direct solver doesn't care about the ADMM iteration
@@ -433,34 +753,126 @@ OSQPInt solve_linsys_qdldl(qdldl_solver* s,
   if (s->polishing) {
     /* stores solution to the KKT system in b */
     LDLSolve(bv, bv, s->L, s->Dinv, s->P, s->bp);
-  } else {
+  } else
 #endif
+  if (s->reduced) {
+    /* solve (P + sigma*I + A'*diag(rho)*A) x = b1 + A'*diag(rho)*b2 in s->sol */
+    reduced_KKT_rhs(s, bv, s->sol);
+    LDLSolve(s->sol, s->sol, s->L, s->Dinv, s->P, s->bp);
+    reduced_KKT_sol(s, s->sol, bv);
+  } else {
     /* stores solution to the KKT system in s->sol */
     LDLSolve(s->sol, bv, s->L, s->Dinv, s->P, s->bp);
+    full_KKT_sol(s, s->sol, bv);
+  }
+  osqp_profiler_sec_pop(OSQP_PROFILER_SEC_LINSYS_SOLVE);
+  return 0;
+}
+
 
-    /* copy x_tilde from s->sol */
-    for (j = 0 ; j < n ; j++) {
-      bv[j] = s->sol[j];
+#ifndef OSQP_EMBEDDED_MODE
+
+// Number of right-hand sides solved together in solve_multi_linsys_qdldl
+#define QDLDL_RHS_BLOCK 8
+
+/* solve LDL' X = X for the nb columns of X, stored row by row (X[i*nb + j]) */
+static void LDLSolve_block(const OSQPCscMatrix* L,
+                           const OSQPFloat*     Dinv,
+                           OSQPFloat*           X,
+                           OSQPInt              nb) {
+
+  OSQPInt    i, j, p;
+  OSQPInt    n = L->n;
+  OSQPFloat  Lx;
+  OSQPFloat* Xi;
+  OSQPFloat* Xr;
+
+  /* L solve */
+  for (i = 0 ; i < n ; i++) {
+    Xi = X + i * nb;
+    for (p = L->p[i] ; p < L->p[i+1] ; p++) {
+      Xr = X + L->i[p] * nb;
+      Lx = L->x[p];
+      for (j = 0 ; j < nb ; j++) Xr[j] -= Lx * Xi[j];
     }
+  }
 
-    /* compute z_tilde from b and s->sol */
-    if (s->rho_inv_vec) {
-      for (j = 0 ; j < m ; j++) {
-        bv[j + n] += s->rho_inv_vec[j] * s->sol[j + n];
+  /* D solve */
+  for (i = 0 ; i < n ; i++) {
+    Xi = X + i * nb;
+    for (j = 0 ; j < nb ; j++) Xi[j] *= Dinv[i];
+  }
+
+  /* L' solve */
+  for (i = n - 1 ; i >= 0 ; i--) {
+    Xi = X + i * nb;
+    for (p = L->p[i] ; p < L->p[i+1] ; p++) {
+      Xr = X + L->i[p] * nb;
+      Lx = L->x[p];
+      for (j = 0 ; j < nb ; j++) Xi[j] -= Lx * Xr[j];
+    }
+  }
+}
+
+
+OSQPInt solve_multi_linsys_qdldl(qdldl_solver* s,
+                                 OSQPVectorf*  b,
+                                 OSQPInt       k) {
+
+  OSQPInt    i, j, j0, nb;
+  OSQPInt    nKKT = s->L->n;
+  OSQPInt    len  = s->n + s->m;
+  OSQPFloat* bv;
+  OSQPFloat* v;
+
+  if (k <= 0) return 0;
+  if (OSQPVectorf_length(b) < k * len) return 1;
+
+  /* workspace for one block of permuted right-hand sides */
+  if (!s->bpk) {
+    s->bpk = (OSQPFloat *)c_malloc(nKKT * QDLDL_RHS_BLOCK * sizeof(OSQPFloat));
+    if (!s->bpk) return osqp_error(OSQP_MEM_ALLOC_ERROR);
+  }
+
+  osqp_profiler_sec_push(OSQP_PROFILER_SEC_LINSYS_SOLVE);
+
+  for (j0 = 0 ; j0 < k ; j0 += QDLDL_RHS_BLOCK) {
+    nb = c_min(QDLDL_RHS_BLOCK, k - j0);
+
+    /* gather the permuted right-hand sides of the factored system */
+    for (j = 0 ; j < nb ; j++) {
+      bv = b->values + (j0 + j) * len;
+      v  = bv;
+      if (!s->polishing && s->reduced) {
+        reduced_KKT_rhs(s, bv, s->sol);
+        v = s->sol;
       }
+      for (i = 0 ; i < nKKT ; i++) s->bpk[i * nb + j] = v[s->P[i]];
     }
-    else {
-      for (j = 0 ; j < m ; j++) {
-        bv[j + n] += s->rho_inv * s->sol[j + n];
+
+    osqp_profiler_sec_push(OSQP_PROFILER_SEC_LINSYS_BACKSOLVE);
+    LDLSolve_block(s->L, s->Dinv, s->bpk, nb);
+    osqp_profiler_sec_pop(OSQP_PROFILER_SEC_LINSYS_BACKSOLVE);
+
+    /* scatter the solutions as solve_linsys_qdldl does */
+    for (j = 0 ; j < nb ; j++) {
+      bv = b->values + (j0 + j) * len;
+      v  = s->polishing ? bv : s->sol;
+      for (i = 0 ; i < nKKT ; i++) v[s->P[i]] = s->bpk[i * nb + j];
+
+      if (!s->polishing) {
+        if (s->reduced) reduced_KKT_sol(s, s->sol, bv);
+        else            full_KKT_sol(s, s->sol, bv);
       }
     }
-#ifndef OSQP_EMBEDDED_MODE
   }
-#endif
+
   osqp_profiler_sec_pop(OSQP_PROFILER_SEC_LINSYS_SOLVE);
   return 0;
 }
 
+#endif
+
 
 #if OSQP_EMBEDDED_MODE != 1
 
@@ -473,13 +885,27 @@ OSQPInt update_linsys_solver_matrices_qdldl(qdldl_solver*     s,
                                             const OSQPInt*    Ax_new_idx,
                                             OSQPInt           A_new_n) {
 
+    OSQPInt j, Aidx;
     OSQPInt pos_D_count;
 
-    // Update KKT matrix with new P
-    update_KKT_P(s->KKT, P->csc, Px_new_idx, P_new_n, s->PtoKKT, s->sigma, 0);
+    if (s->reduced) {
+        // Update rows of A (if Ax_new_idx is null, all elements are replaced)
+        for (j = 0; j < A_new_n; j++) {
+            Aidx = Ax_new_idx ? Ax_new_idx[j] : j;
+            s->At->x[s->AtoAt[Aidx]] = A->csc->x[Aidx];
+        }
+
+        // Recompute the reduced KKT matrix on its fixed pattern
+        update_reduced_KKT(s->KKT, s->Kred, s->KredtoKKT, P->csc, A->csc, s->At,
+                           s->sigma, s->rho_inv_vec, s->rho_inv, s->rwork);
+    }
+    else {
+        // Update KKT matrix with new P
+        update_KKT_P(s->KKT, P->csc, Px_new_idx, P_new_n, s->PtoKKT, s->sigma, 0);
 
-    // Update KKT matrix with new A
-    update_KKT_A(s->KKT, A->csc, Ax_new_idx, A_new_n, s->AtoKKT);
+        // Update KKT matrix with new A
+        update_KKT_A(s->KKT, A->csc, Ax_new_idx, A_new_n, s->AtoKKT);
+    }
 
     osqp_profiler_sec_push(OSQP_PROFILER_SEC_LINSYS_NUM_FAC);
     pos_D_count = QDLDL_factor(s->KKT->n, s->KKT->p, s->KKT->i, s->KKT->x,
@@ -514,7 +940,13 @@ OSQPInt update_linsys_solver_rho_vec_qdldl(qdldl_solver*      s,
     }
 
     // Update KKT matrix with new rho_vec
-    update_KKT_param2(s->KKT, s->rho_inv_vec, s->rho_inv, s->rhotoKKT, s->m);
+    if (s->reduced) {
+        update_reduced_KKT(s->KKT, s->Kred, s->KredtoKKT, s->Pdata, s->Adata, s->At,
+                           s->sigma, s->rho_inv_vec, s->rho_inv, s->rwork);
+    }
+    else {
+        update_KKT_param2(s->KKT, s->rho_inv_vec, s->rho_inv, s->rhotoKKT, s->m);
+    }
 
     osqp_profiler_sec_push(OSQP_PROFILER_SEC_LINSYS_NUM_FAC);
     retval = QDLDL_factor(s->KKT->n, s->KKT->p, s->KKT->i, s->KKT->x,
@@ -44,6 +44,10 @@ struct qdldl {
                                         OSQPVectorf* rhs);
 
     void (*free)(struct qdldl* self); ///< Free workspace (only if desktop)
+
+    OSQPInt (*solve_multi)(struct qdldl* self,
+                           OSQPVectorf*  b,
+                           OSQPInt       k);  ///< Solve for k stacked right-hand sides
 #endif
 
     // This used only in non embedded or embedded 2 version
@@ -63,6 +67,10 @@ struct qdldl {
 
     OSQPInt nthreads;
 
+#ifndef OSQP_EMBEDDED_MODE
+    OSQPFloat memory;  ///< memory used by the solver in bytes
+#endif
+
     /** @} */
 
     /**
@@ -79,6 +87,8 @@ struct qdldl {
     OSQPFloat      rho_inv;       ///< scalar parameter (used if rho_inv_vec == NULL)
 #ifndef OSQP_EMBEDDED_MODE
     OSQPInt        polishing;     ///< polishing flag
+    void*          arena;         ///< single allocation holding L, the solve vectors and the QDLDL workspace
+    OSQPFloat*     bpk;           ///< workspace for blocked multi-RHS solves (allocated on first use)
 #endif
     OSQPInt        n;             ///< number of QP variables
     OSQPInt        m;             ///< number of QP constraints
@@ -101,6 +111,18 @@ struct qdldl {
     OSQPCscMatrix* adj;
 #endif
 
+    // Reduced KKT system P + sigma*I + A'*diag(rho)*A (factored instead of the full KKT if reduced != 0)
+    OSQPInt              reduced;   ///< flag: the reduced KKT system is factored
+    const OSQPCscMatrix* Adata;     ///< A matrix provided by OSQP (just a pointer, don't free it)
+#if OSQP_EMBEDDED_MODE != 1
+    const OSQPCscMatrix* Pdata;     ///< P matrix provided by OSQP (just a pointer, don't free it)
+    OSQPCscMatrix*       At;        ///< transpose of A (rows of A for the reduced KKT assembly)
+    OSQPInt*             AtoAt;     ///< Index of elements from A to At
+    OSQPCscMatrix*       Kred;      ///< Sparsity pattern of the unpermuted reduced KKT matrix
+    OSQPInt*             KredtoKKT; ///< Index of elements from Kred to the permuted KKT matrix
+    OSQPFloat*           rwork;     ///< workspace for the reduced KKT assembly (kept at zero)
+#endif
+
     /** @} */
 };
 
@@ -190,6 +212,22 @@ OSQPInt update_linsys_solver_rho_vec_qdldl(qdldl_solver*      s,
  */
 void free_linsys_solver_qdldl(qdldl_solver* s);
 
+/**
+ * Solve the linear system for k right-hand sides and store the results in b
+ *
+ * Each right-hand side is processed as in solve_linsys_qdldl, but the
+ * triangular solves are blocked so that L is read once per block of
+ * right-hand sides.
+ *
+ * @param  s  Linear system solver structure
+ * @param  b  Right-hand sides stacked one after the other (length k*(n+m))
+ * @param  k  Number of right-hand sides
+ * @return    Exitflag
+ */
+OSQPInt solve_multi_linsys_qdldl(qdldl_solver* s,
+                                 OSQPVectorf*  b,
+                                 OSQPInt       k);
+
 OSQPInt adjoint_derivative_qdldl(qdldl_solver**     s,
                                  const OSQPMatrix*  P,
                                  const OSQPMatrix*  G,
@@ -1,6 +1,7 @@
 #include "reduced_kkt.h"
 #include "algebra_matrix.h"
 #include "algebra_vector.h"
+#include "glob_opts.h"
 
 
 /*
@@ -63,3 +64,31 @@ void reduced_kkt_compute_rhs(const OSQPMatrix*  A,
   /* 2nd part: Compute b1 = b1 + A' (rho.*b2) */
   OSQPMatrix_Atxpy(A, work, b1, 1.0, 1.0);
 }
+
+
+OSQPFloat cg_compute_tolerance(OSQPInt    admm_iter,
+                               OSQPFloat  rhs_norm,
+                               OSQPFloat  scaled_prim_res,
+                               OSQPFloat  scaled_dual_res,
+                               OSQPFloat  reduction_factor,
+                               OSQPFloat* eps_prev) {
+
+  OSQPFloat eps = 1.0;
+
+  if (admm_iter == 1) {
+    // In case rhs = 0.0 we don't want to set eps_prev to 0.0
+    if (rhs_norm < OSQP_CG_TOL_MIN)
+      *eps_prev = 1.0;
+    else
+      *eps_prev = rhs_norm * reduction_factor;
+
+    // Return early since scaled_prim_res and scaled_dual_res are meaningless before the first ADMM iteration
+    return *eps_prev;
+  }
+
+  eps = reduction_factor * sqrt(scaled_prim_res * scaled_dual_res);
+  eps = c_max(c_min(eps, (*eps_prev)), OSQP_CG_TOL_MIN);
+  *eps_prev = eps;
+
+  return eps;
+}
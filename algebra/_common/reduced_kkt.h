@@ -72,6 +72,29 @@ void reduced_kkt_compute_rhs(const OSQPMatrix*  A,
                              const OSQPVectorf* b2,
                                    OSQPVectorf* work);
 
+/**
+ * Compute the tolerance of a CG solve of the reduced KKT system in an
+ * ADMM iteration.
+ *
+ * In the first ADMM iteration the tolerance is a fraction of the norm of
+ * the right-hand side, afterwards it follows the geometric mean of the
+ * scaled ADMM residuals and never increases between iterations.
+ *
+ * @param admm_iter        The current ADMM iteration
+ * @param rhs_norm         Infinity norm of the right-hand side
+ * @param scaled_prim_res  Scaled primal residual of the previous iteration
+ * @param scaled_dual_res  Scaled dual residual of the previous iteration
+ * @param reduction_factor Fraction of the residuals to use as tolerance
+ * @param eps_prev         Tolerance of the previous iteration (updated)
+ * @return                 The CG tolerance
+ */
+OSQPFloat cg_compute_tolerance(OSQPInt    admm_iter,
+                               OSQPFloat  rhs_norm,
+                               OSQPFloat  scaled_prim_res,
+                               OSQPFloat  scaled_dual_res,
+                               OSQPFloat  reduction_factor,
+                               OSQPFloat* eps_prev);
+
 #ifdef __cplusplus
 }
 #endif
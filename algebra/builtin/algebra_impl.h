@@ -35,9 +35,23 @@ struct OSQPVectorf_ {
  */
 typedef enum OSQPMatrix_symmetry_type {NONE,TRIU} OSQPMatrix_symmetry_type;
 
+#ifndef OSQP_EMBEDDED_MODE
+/**
+ *  A matrix-free operator wrapping the user callbacks. Operators are never
+ *  scaled, since the data scaling is off for them.
+ */
+typedef struct {
+  OSQPOperator op;     /* copy of the user operator */
+  OSQPFloat*   ywork;  /* work vector of length max(m,n) */
+} OSQPMatrixOperator;
+#endif
+
 struct OSQPMatrix_ {
   OSQPCscMatrix*           csc;
   OSQPMatrix_symmetry_type symmetry;
+#ifndef OSQP_EMBEDDED_MODE
+  OSQPMatrixOperator*      op;   /* matrix-free operator (csc is then OSQP_NULL) */
+#endif
 };
 
 #ifdef __cplusplus
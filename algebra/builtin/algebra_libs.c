@@ -1,16 +1,26 @@
 #include "osqp_api_constants.h"
 #include "osqp_api_types.h"
 #include "qdldl_interface.h"
+#ifndef OSQP_EMBEDDED_MODE
+#include "pcg_interface.h"
+#endif
 #include "profilers.h"
 #include "util.h"
 
 OSQPInt osqp_algebra_linsys_supported(void) {
-  /* Only has QDLDL (direct solver) */
+#ifndef OSQP_EMBEDDED_MODE
+  /* Has QDLDL (direct solver) and a PCG solver (indirect solver),
+     which also runs on matrix-free operators */
+  return OSQP_CAPABILITY_DIRECT_SOLVER | OSQP_CAPABILITY_INDIRECT_SOLVER |
+         OSQP_CAPABILITY_MATRIX_FREE;
+#else
+  /* Only QDLDL (direct solver) is available in embedded code */
   return OSQP_CAPABILITY_DIRECT_SOLVER;
+#endif
 }
 
 enum osqp_linsys_solver_type osqp_algebra_default_linsys(void) {
-  /* Prefer QDLDL (it is also the only one available) */
+  /* Prefer QDLDL */
   return OSQP_DIRECT_SOLVER;
 }
 
@@ -61,13 +71,13 @@ OSQPInt osqp_algebra_init_linsys_solver(LinSysSolver**      s,
                                         OSQPInt             polishing) {
   OSQPInt retval = 0;
 
-  // Don't use the scaled residuals right now
-  OSQP_UnusedVar(scaled_prim_res);
-  OSQP_UnusedVar(scaled_dual_res);
-
   osqp_profiler_sec_push(OSQP_PROFILER_SEC_LINSYS_INIT);
 
   switch (settings->linsys_solver) {
+  case OSQP_INDIRECT_SOLVER:
+    retval = init_linsys_pcg((pcg_solver **)s, P, A, rho_vec, settings, scaled_prim_res, scaled_dual_res, polishing);
+    break;
+
   default:
   case OSQP_DIRECT_SOLVER:
     retval = init_linsys_solver_qdldl((qdldl_solver **)s, P, A, rho_vec, settings, polishing);
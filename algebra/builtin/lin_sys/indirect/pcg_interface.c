@@ -0,0 +1,1093 @@
+#include "glob_opts.h"
+#include "algebra_impl.h"
+#include "error.h"
+#include "printing.h"
+#include "algebra_vector.h"
+#include "reduced_kkt.h"
+#include "csc_utils.h"
+#include "pcg_interface.h"
+#include "util.h"
+
+#include "profilers.h"
+
+#ifdef OSQP_ENABLE_OPENMP
+# include <omp.h>
+#endif
+
+
+/* Preconditioner in use: the requested one, or the diagonal preconditioner if
+ * its factorization failed for the current matrices and rho */
+static osqp_precond_type pcg_active_precond(const pcg_solver* s) {
+
+  if (s->precond_type == s->precond_failed)
+    return OSQP_DIAGONAL_PRECONDITIONER;
+
+  return s->precond_type;
+}
+
+
+/* Recompute the preconditioner of the reduced KKT matrix */
+static void pcg_update_precond(pcg_solver* s) {
+
+  switch(pcg_active_precond(s)) {
+  /* No preconditioner, just initialize the inverse vector to all 1s */
+  case OSQP_NO_PRECONDITIONER:
+    OSQPVectorf_set_scalar(s->precond, 1.0);
+    OSQPVectorf_set_scalar(s->precond_inv, 1.0);
+    break;
+
+  /* Diagonal preconditioner computation */
+  case OSQP_DIAGONAL_PRECONDITIONER:
+    reduced_kkt_diagonal(s->P, s->A, s->rho_vec, s->sigma, s->precond, s->precond_inv);
+    break;
+
+  /* Factored preconditioners, recomputed lazily before the next solve */
+  case OSQP_IC0_PRECONDITIONER:
+  case OSQP_BLOCK_JACOBI_PRECONDITIONER:
+    s->precond_dirty = 1;
+    break;
+  }
+}
+
+
+/* Compute the factor of the incomplete Cholesky or block-Jacobi preconditioner,
+ * falling back to the diagonal preconditioner if it cannot be allocated or computed */
+static void pcg_factor_precond(pcg_solver* s) {
+
+  OSQPInt    exitflag = 1;
+  OSQPFloat* rho      = OSQPVectorf_data(s->rho_vec);
+
+  s->precond_dirty = 0;
+
+  // Operators only provide the diagonal of P and A'*A
+  if (OSQPMatrix_is_operator(s->P) || OSQPMatrix_is_operator(s->A)) {
+    s->precond_failed = s->precond_type;
+    pcg_update_precond(s);
+    return;
+  }
+
+  if (s->precond_type == OSQP_IC0_PRECONDITIONER) {
+    if (!s->ic0) {
+      s->ic0 = ic0_new(s->P->csc, s->A->csc);
+      if (s->ic0)
+        s->memory += (OSQPFloat)(s->ic0->U->p[s->n] * (sizeof(OSQPFloat) + sizeof(OSQPInt)));
+    }
+
+    if (s->ic0)
+      exitflag = ic0_factor(s->ic0, s->P->csc, s->A->csc, s->sigma, rho);
+  } else if (s->precond_type == OSQP_BLOCK_JACOBI_PRECONDITIONER) {
+    if (!s->bjac) {
+      s->bjac = block_jacobi_new(s->P->csc, s->A->csc, s->block_size);
+      if (s->bjac)
+        s->memory += (OSQPFloat)(s->bjac->L_ptr[s->bjac->nblocks] * sizeof(OSQPFloat));
+    }
+
+    if (s->bjac)
+      exitflag = block_jacobi_factor(s->bjac, s->P->csc, s->A->csc, s->sigma, rho);
+  } else {
+    // The preconditioner type changed since the factor was marked stale
+    return;
+  }
+
+  // Not retried before P, A or rho change
+  if (exitflag) {
+    c_eprint("Preconditioner factorization failed, using the diagonal preconditioner");
+    s->precond_failed = s->precond_type;
+    pcg_update_precond(s);
+  }
+}
+
+
+/* y = M \ r */
+static void pcg_apply_precond(pcg_solver*        s,
+                              OSQPVectorf*       y,
+                              const OSQPVectorf* r) {
+
+  switch(pcg_active_precond(s)) {
+  case OSQP_IC0_PRECONDITIONER:
+    OSQPVectorf_copy(y, r);
+    ic0_solve(s->ic0, OSQPVectorf_data(y));
+    break;
+
+  case OSQP_BLOCK_JACOBI_PRECONDITIONER:
+    OSQPVectorf_copy(y, r);
+    block_jacobi_solve(s->bjac, OSQPVectorf_data(y));
+    break;
+
+  default:
+    OSQPVectorf_ew_prod(y, s->precond_inv, r);
+    break;
+  }
+}
+
+
+/* Run PCG on the reduced KKT system with right-hand side s->r1 starting from s->x,
+ * return the number of iterations performed */
+static OSQPInt pcg_alg(pcg_solver* s,
+                       OSQPFloat   eps) {
+
+  OSQPInt   iter = 0;
+  OSQPFloat rTy, rTy_prev, pKp, alpha;
+
+  /* r = K*x - rhs */
+  osqp_profiler_sec_push(OSQP_PROFILER_SEC_LINSYS_MVM);
+  reduced_kkt_mv_times(s->P, s->A, s->rho_vec, s->sigma, s->x, s->r, s->ywork);
+  osqp_profiler_sec_pop(OSQP_PROFILER_SEC_LINSYS_MVM);
+  OSQPVectorf_minus(s->r, s->r, s->r1);
+
+  /* Make r orthogonal to the deflation basis */
+  if (s->defl)
+    deflation_project(s->defl, OSQPVectorf_data(s->x), OSQPVectorf_data(s->r));
+
+  /* y = M \ r, p = -y */
+  pcg_apply_precond(s, s->y, s->r);
+  OSQPVectorf_copy(s->p, s->y);
+  OSQPVectorf_mult_scalar(s->p, -1.0);
+  if (s->defl)
+    deflation_direction(s->defl, OSQPVectorf_data(s->p), OSQPVectorf_data(s->y));
+  rTy = OSQPVectorf_dot_prod(s->r, s->y);
+
+  while ((OSQPVectorf_norm_inf(s->r) > eps) && (iter < s->max_iter)) {
+
+    /* Kp = K*p */
+    osqp_profiler_sec_push(OSQP_PROFILER_SEC_LINSYS_MVM);
+    reduced_kkt_mv_times(s->P, s->A, s->rho_vec, s->sigma, s->p, s->Kp, s->ywork);
+    osqp_profiler_sec_pop(OSQP_PROFILER_SEC_LINSYS_MVM);
+
+    if (s->defl)
+      deflation_collect(s->defl, OSQPVectorf_data(s->p), OSQPVectorf_data(s->Kp));
+
+    pKp = OSQPVectorf_dot_prod(s->p, s->Kp);
+    if (pKp <= 0.0) break;  /* breakdown: K is not positive definite along p */
+
+    alpha = rTy / pKp;
+
+    /* x += alpha*p, r += alpha*Kp */
+    OSQPVectorf_add_scaled(s->x, 1.0, s->x, alpha, s->p);
+    OSQPVectorf_add_scaled(s->r, 1.0, s->r, alpha, s->Kp);
+
+    /* y = M \ r */
+    pcg_apply_precond(s, s->y, s->r);
+
+    rTy_prev = rTy;
+    rTy      = OSQPVectorf_dot_prod(s->r, s->y);
+
+    /* p = -y + (rTy / rTy_prev)*p */
+    OSQPVectorf_add_scaled(s->p, rTy / rTy_prev, s->p, -1.0, s->y);
+    if (s->defl)
+      deflation_direction(s->defl, OSQPVectorf_data(s->p), OSQPVectorf_data(s->y));
+
+    iter++;
+  }
+
+  return iter;
+}
+
+
+/* Build the row-wise copies of P and A used by the pipelined method,
+ * return 1 if out of memory */
+static OSQPInt pipelined_matrices_new(pcg_solver* s) {
+
+  OSQPInt        i, j, k, q;
+  OSQPInt        n  = s->n;
+  OSQPCscMatrix* P  = s->P->csc;
+  OSQPCscMatrix* Pf;
+  OSQPInt*       w;
+
+  s->pl_Amap = (OSQPInt *)c_malloc(c_max(s->A->csc->p[n], 1) * sizeof(OSQPInt));
+  if (!s->pl_Amap) return 1;
+
+  s->pl_At = csc_transpose(s->A->csc, s->pl_Amap);
+  if (!s->pl_At) return 1;
+
+  /* Column counts of the full symmetric P from its upper triangle */
+  w = (OSQPInt *)c_calloc(n + 1, sizeof(OSQPInt));
+  if (!w) return 1;
+
+  for (j = 0; j < n; j++) {
+    for (k = P->p[j]; k < P->p[j + 1]; k++) {
+      w[j]++;
+      if (P->i[k] != j) w[P->i[k]]++;
+    }
+  }
+
+  Pf = csc_spalloc(n, n, c_max(2 * P->p[n], 1), 1, 0);
+  s->pl_P    = Pf;
+  s->pl_Pmap = (OSQPInt *)c_malloc(c_max(2 * P->p[n], 1) * sizeof(OSQPInt));
+  if (!Pf || !s->pl_Pmap) {
+    c_free(w);
+    return 1;
+  }
+
+  /* Column pointers, then w holds the next free position of each column */
+  Pf->p[0] = 0;
+  for (j = 0; j < n; j++) {
+    Pf->p[j + 1] = Pf->p[j] + w[j];
+    w[j]         = Pf->p[j];
+  }
+
+  for (j = 0; j < n; j++) {
+    for (k = P->p[j]; k < P->p[j + 1]; k++) {
+      i = P->i[k];
+
+      q = w[j]++;
+      Pf->i[q]              = i;
+      s->pl_Pmap[2 * k]     = q;
+      s->pl_Pmap[2 * k + 1] = -1;
+
+      if (i != j) {
+        q = w[i]++;
+        Pf->i[q]              = j;
+        s->pl_Pmap[2 * k + 1] = q;
+      }
+    }
+  }
+  c_free(w);
+
+  s->memory += (OSQPFloat)((Pf->p[n] + s->pl_At->p[s->m]) * (sizeof(OSQPFloat) + sizeof(OSQPInt)) +
+                           (2 * P->p[n] + s->A->csc->p[n]) * sizeof(OSQPInt));
+
+  return 0;
+}
+
+
+/* Copy the values of P and A into their row-wise copies */
+static void pipelined_matrices_update(pcg_solver* s) {
+
+  OSQPInt        k;
+  OSQPCscMatrix* P = s->P->csc;
+  OSQPCscMatrix* A = s->A->csc;
+
+  for (k = 0; k < P->p[s->n]; k++) {
+    s->pl_P->x[s->pl_Pmap[2 * k]] = P->x[k];
+    if (s->pl_Pmap[2 * k + 1] >= 0)
+      s->pl_P->x[s->pl_Pmap[2 * k + 1]] = P->x[k];
+  }
+
+  for (k = 0; k < A->p[s->n]; k++)
+    s->pl_At->x[s->pl_Amap[k]] = A->x[k];
+}
+
+
+/* v = K*x, and with gamma and delta also the dot products gamma = r'*u and
+ * delta = w'*u of a pipelined CG iteration. The dot products do not depend on
+ * v, so the threads compute their partial sums and move on to the rows of
+ * A*x without waiting; the reduction completes with the matrix-vector product. */
+static void pipelined_mv(pcg_solver*        s,
+                         const OSQPVectorf* xv,
+                               OSQPVectorf* vv,
+                               OSQPFloat*   gamma,
+                               OSQPFloat*   delta) {
+
+  OSQPInt    i, j, k;
+  OSQPInt    n   = s->n;
+  OSQPInt    m   = s->m;
+  OSQPInt    dot = (gamma != OSQP_NULL);
+  OSQPFloat  g   = 0.0;
+  OSQPFloat  d   = 0.0;
+  OSQPFloat  acc;
+  OSQPFloat* x   = OSQPVectorf_data(xv);
+  OSQPFloat* v   = OSQPVectorf_data(vv);
+  OSQPFloat* t   = OSQPVectorf_data(s->ywork);
+  OSQPFloat* rho = OSQPVectorf_data(s->rho_vec);
+  OSQPFloat* r   = OSQPVectorf_data(s->r);
+  OSQPFloat* u   = OSQPVectorf_data(s->y);
+  OSQPFloat* w   = OSQPVectorf_data(s->pl_w);
+
+  osqp_profiler_sec_push(OSQP_PROFILER_SEC_LINSYS_MVM);
+
+  /* Operators are applied serially */
+  if (!s->pl_P) {
+    reduced_kkt_mv_times(s->P, s->A, s->rho_vec, s->sigma, xv, vv, s->ywork);
+    if (dot) {
+      *gamma = OSQPVectorf_dot_prod(s->r, s->y);
+      *delta = OSQPVectorf_dot_prod(s->pl_w, s->y);
+    }
+    osqp_profiler_sec_pop(OSQP_PROFILER_SEC_LINSYS_MVM);
+    return;
+  }
+
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp parallel private(i, j, k, acc) num_threads(s->nthreads)
+#endif
+  {
+    if (dot) {
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp for nowait reduction(+:g,d)
+#endif
+      for (i = 0; i < n; i++) {
+        g += r[i] * u[i];
+        d += w[i] * u[i];
+      }
+    }
+
+    /* t = rho.*(A*x) */
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp for
+#endif
+    for (i = 0; i < m; i++) {
+      acc = 0.0;
+      for (k = s->pl_At->p[i]; k < s->pl_At->p[i + 1]; k++)
+        acc += s->pl_At->x[k] * x[s->pl_At->i[k]];
+      t[i] = rho[i] * acc;
+    }
+
+    /* v = (P + sigma*I)*x + A'*t */
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp for
+#endif
+    for (j = 0; j < n; j++) {
+      acc = s->sigma * x[j];
+      for (k = s->pl_P->p[j]; k < s->pl_P->p[j + 1]; k++)
+        acc += s->pl_P->x[k] * x[s->pl_P->i[k]];
+      for (k = s->A->csc->p[j]; k < s->A->csc->p[j + 1]; k++)
+        acc += s->A->csc->x[k] * t[s->A->csc->i[k]];
+      v[j] = acc;
+    }
+  }
+
+  if (dot) {
+    *gamma = g;
+    *delta = d;
+  }
+
+  osqp_profiler_sec_pop(OSQP_PROFILER_SEC_LINSYS_MVM);
+}
+
+
+/* Vector updates of a pipelined CG iteration in a single pass:
+ *
+ *   z = n + beta*z,  q = m + beta*q,  s = w + beta*s,  p = u + beta*p
+ *   x += alpha*p,    r -= alpha*s,    u -= alpha*q,    w -= alpha*z
+ *
+ * With first set the recurrences are restarted (beta = 0). With diag set the
+ * preconditioner is diagonal and m = M \ w of the next iteration is computed in
+ * the same pass. Returns ||r||_inf.
+ */
+static OSQPFloat pipelined_update(pcg_solver* s,
+                                  OSQPFloat   alpha,
+                                  OSQPFloat   beta,
+                                  OSQPInt     first,
+                                  OSQPInt     diag) {
+
+  OSQPInt    i;
+  OSQPInt    n  = s->n;
+  OSQPFloat* x  = OSQPVectorf_data(s->x);
+  OSQPFloat* r  = OSQPVectorf_data(s->r);
+  OSQPFloat* u  = OSQPVectorf_data(s->y);
+  OSQPFloat* p  = OSQPVectorf_data(s->p);
+  OSQPFloat* sv = OSQPVectorf_data(s->Kp);
+  OSQPFloat* w  = OSQPVectorf_data(s->pl_w);
+  OSQPFloat* mv = OSQPVectorf_data(s->pl_m);
+  OSQPFloat* nv = OSQPVectorf_data(s->pl_n);
+  OSQPFloat* z  = OSQPVectorf_data(s->pl_z);
+  OSQPFloat* q  = OSQPVectorf_data(s->pl_q);
+  OSQPFloat* mi = OSQPVectorf_data(s->precond_inv);
+  OSQPFloat  rn = 0.0;
+
+  if (first) beta = 0.0;
+
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp parallel for reduction(max:rn) num_threads(s->nthreads)
+#endif
+  for (i = 0; i < n; i++) {
+    if (first) {
+      z[i]  = nv[i];
+      q[i]  = mv[i];
+      sv[i] = w[i];
+      p[i]  = u[i];
+    } else {
+      z[i]  = nv[i] + beta * z[i];
+      q[i]  = mv[i] + beta * q[i];
+      sv[i] = w[i]  + beta * sv[i];
+      p[i]  = u[i]  + beta * p[i];
+    }
+
+    x[i] += alpha * p[i];
+    r[i] -= alpha * sv[i];
+    u[i] -= alpha * q[i];
+    w[i] -= alpha * z[i];
+
+    if (diag) mv[i] = mi[i] * w[i];
+
+    rn = c_max(rn, c_absval(r[i]));
+  }
+
+  return rn;
+}
+
+
+/* Run the pipelined CG method of Ghysels and Vanroose on the reduced KKT system
+ * with right-hand side s->r1 starting from s->x, return the number of
+ * iterations. In each iteration the dot products r'*u and w'*u are reduced in
+ * the same parallel region as the product n = K*m, which does not depend on
+ * them. */
+static OSQPInt pipelined_alg(pcg_solver* s,
+                             OSQPFloat   eps) {
+
+  OSQPInt   iter = 0;
+  OSQPInt   first;
+  OSQPInt   diag;
+  OSQPFloat gamma, delta, rnorm;
+  OSQPFloat gamma_prev = 1.0;
+  OSQPFloat alpha      = 1.0;
+  OSQPFloat beta       = 0.0;
+
+  diag = (pcg_active_precond(s) == OSQP_NO_PRECONDITIONER ||
+          pcg_active_precond(s) == OSQP_DIAGONAL_PRECONDITIONER);
+
+  /* The recursively updated residual drifts away from the true one, so the
+   * method is restarted from the true residual until it has converged */
+  while (iter < s->max_iter) {
+
+    /* r = rhs - K*x, u = M \ r, w = K*u, m = M \ w */
+    pipelined_mv(s, s->x, s->r, OSQP_NULL, OSQP_NULL);
+    OSQPVectorf_minus(s->r, s->r1, s->r);
+
+    rnorm = OSQPVectorf_norm_inf(s->r);
+    if (rnorm <= eps) break;
+
+    pcg_apply_precond(s, s->y, s->r);
+    pipelined_mv(s, s->y, s->pl_w, OSQP_NULL, OSQP_NULL);
+    pcg_apply_precond(s, s->pl_m, s->pl_w);
+    first = 1;
+
+    while ((rnorm > eps) && (iter < s->max_iter)) {
+
+      /* n = K*m, overlapped with gamma = r'*u and delta = w'*u */
+      pipelined_mv(s, s->pl_m, s->pl_n, &gamma, &delta);
+
+      if (!first) {
+        beta  = gamma / gamma_prev;
+        alpha = gamma / (delta - beta * gamma / alpha);
+      } else {
+        alpha = gamma / delta;
+      }
+      if (!(alpha > 0.0)) return iter;  /* breakdown: K is not positive definite */
+
+      gamma_prev = gamma;
+      rnorm      = pipelined_update(s, alpha, beta, first, diag);
+
+      /* m = M \ w for the factored preconditioners */
+      if (!diag) pcg_apply_precond(s, s->pl_m, s->pl_w);
+
+      first = 0;
+      iter++;
+    }
+  }
+
+  return iter;
+}
+
+
+/* v = K*x with the full KKT matrix K = [P + sigma*I, A'; A, -diag(1/rho)] */
+static void minres_kkt_mv_times(pcg_solver*        s,
+                                const OSQPVectorf* x,
+                                OSQPVectorf*       v) {
+
+  OSQPVectorf_view_update(s->in1,  x, 0,    s->n);
+  OSQPVectorf_view_update(s->in2,  x, s->n, s->m);
+  OSQPVectorf_view_update(s->out1, v, 0,    s->n);
+  OSQPVectorf_view_update(s->out2, v, s->n, s->m);
+
+  osqp_profiler_sec_push(OSQP_PROFILER_SEC_LINSYS_MVM);
+
+  /* v1 = (P + sigma*I)*x1 + A'*x2 */
+  OSQPVectorf_copy(s->out1, s->in1);
+  OSQPMatrix_Axpy(s->P, s->in1, s->out1, 1.0, s->sigma);
+  OSQPMatrix_Atxpy(s->A, s->in2, s->out1, 1.0, 1.0);
+
+  /* v2 = A*x1 - x2./rho */
+  OSQPVectorf_ew_prod(s->ywork, s->in2, s->rho_inv_vec);
+  OSQPMatrix_Axpy(s->A, s->in1, s->out2, 1.0, 0.0);
+  OSQPVectorf_minus(s->out2, s->out2, s->ywork);
+
+  osqp_profiler_sec_pop(OSQP_PROFILER_SEC_LINSYS_MVM);
+}
+
+
+/* y = blkdiag(M, diag(1/rho)) \ r */
+static void minres_apply_precond(pcg_solver*        s,
+                                 OSQPVectorf*       y,
+                                 const OSQPVectorf* r) {
+
+  OSQPVectorf_view_update(s->in1,  r, 0,    s->n);
+  OSQPVectorf_view_update(s->in2,  r, s->n, s->m);
+  OSQPVectorf_view_update(s->out1, y, 0,    s->n);
+  OSQPVectorf_view_update(s->out2, y, s->n, s->m);
+
+  pcg_apply_precond(s, s->out1, s->in1);
+  OSQPVectorf_ew_prod(s->out2, s->in2, s->rho_vec);
+}
+
+
+/* Run preconditioned MINRES on the full KKT system with right-hand side b
+ * starting from (s->x, nu of the previous solve), return the number of
+ * iterations performed. The residual is updated with a recurrence, which can
+ * drift away from the true residual, so once it is below eps the true residual
+ * is computed and MINRES is restarted from the current iterate if it is not. */
+static OSQPInt minres_alg(pcg_solver*        s,
+                          const OSQPVectorf* b,
+                          OSQPFloat          eps) {
+
+  OSQPInt      iter  = 0;
+  OSQPInt      start;
+  OSQPFloat    cs, sn, dbar, epsln;
+  OSQPFloat    alpha, beta, beta_prev, epsln_prev, delta, gbar, gamma, phi, phibar;
+  OSQPVectorf* x  = s->kkt_x;
+  OSQPVectorf* r  = s->kkt_r;
+  OSQPVectorf* v  = s->kkt_v;
+  OSQPVectorf* y  = s->kkt_y;
+  OSQPVectorf* q1 = s->kkt_q1;
+  OSQPVectorf* q2 = s->kkt_q2;
+  OSQPVectorf* w  = s->kkt_w;
+  OSQPVectorf* w1 = s->kkt_w1;
+  OSQPVectorf* w2 = s->kkt_w2;
+  OSQPVectorf* tmp;
+
+  /* Warm start x from the last solution */
+  OSQPVectorf_view_update(s->out1, x, 0, s->n);
+  OSQPVectorf_copy(s->out1, s->x);
+
+  while (iter < s->max_iter) {
+
+    /* r = rhs - K*x */
+    minres_kkt_mv_times(s, x, r);
+    OSQPVectorf_minus(r, b, r);
+
+    if (OSQPVectorf_norm_inf(r) <= eps) break;
+
+    /* y = M \ r, beta = sqrt(r'*y) */
+    OSQPVectorf_copy(q2, r);
+    minres_apply_precond(s, y, q2);
+    beta = OSQPVectorf_dot_prod(q2, y);
+    if (beta <= 0.0) break;  /* the preconditioner is not positive definite */
+
+    beta      = c_sqrt(beta);
+    beta_prev = beta;
+    phibar    = beta;
+    cs        = -1.0;
+    sn        = 0.0;
+    dbar      = 0.0;
+    epsln     = 0.0;
+
+    OSQPVectorf_set_scalar(w,  0.0);
+    OSQPVectorf_set_scalar(w1, 0.0);
+    OSQPVectorf_set_scalar(w2, 0.0);
+
+    start = iter;
+    while ((OSQPVectorf_norm_inf(r) > eps) && (iter < s->max_iter)) {
+
+      /* Lanczos step: v = y/beta, y = K*v - alpha/beta*q2 - beta/beta_prev*q1 */
+      OSQPVectorf_copy(v, y);
+      OSQPVectorf_mult_scalar(v, 1.0 / beta);
+      minres_kkt_mv_times(s, v, y);
+      if (iter > start)
+        OSQPVectorf_add_scaled(y, 1.0, y, -beta / beta_prev, q1);
+
+      alpha = OSQPVectorf_dot_prod(v, y);
+      OSQPVectorf_add_scaled(y, 1.0, y, -alpha / beta, q2);
+
+      /* q1 = q2, q2 = y, y = M \ q2 */
+      tmp = q1; q1 = q2; q2 = y; y = tmp;
+      minres_apply_precond(s, y, q2);
+
+      beta_prev = beta;
+      beta      = OSQPVectorf_dot_prod(q2, y);
+      if (beta < 0.0) return iter;
+      beta = c_sqrt(beta);
+
+      /* Apply the previous rotation and compute the next one */
+      epsln_prev = epsln;
+      delta      = cs * dbar + sn * alpha;
+      gbar       = sn * dbar - cs * alpha;
+      epsln      = sn * beta;
+      dbar       = -cs * beta;
+      gamma      = c_sqrt(gbar * gbar + beta * beta);
+      if (gamma == 0.0) return iter;  /* K is singular */
+
+      cs     = gbar / gamma;
+      sn     = beta / gamma;
+      phi    = cs * phibar;
+      phibar = sn * phibar;
+
+      /* w = (v - epsln_prev*w1 - delta*w2)/gamma, x += phi*w */
+      tmp = w1; w1 = w2; w2 = w; w = tmp;
+      OSQPVectorf_add_scaled3(w, 1.0 / gamma, v, -epsln_prev / gamma, w1, -delta / gamma, w2);
+      OSQPVectorf_add_scaled(x, 1.0, x, phi, w);
+
+      /* r = sn^2*r - phibar*cs/beta*q2 */
+      iter++;
+      if (beta == 0.0) break;  /* the Krylov subspace is invariant and x is exact */
+      OSQPVectorf_add_scaled(r, sn * sn, r, -phibar * cs / beta, q2);
+    }
+  }
+
+  return iter;
+}
+
+
+/* Tolerance of the next solve, following the ADMM residuals */
+static OSQPFloat pcg_tolerance(pcg_solver* s,
+                               OSQPFloat   rhs_norm,
+                               OSQPInt     admm_iter) {
+
+  if (s->polish)
+    return c_max(rhs_norm * OSQP_CG_POLISH_TOL, OSQP_CG_TOL_MIN);
+
+  if (admm_iter == 1) {
+    // On the first iteration, set reduction_factor to its default value
+    s->reduction_factor = s->tol_fraction;
+  } else if (s->cg_zero_iters >= s->reduction_interval) {
+    // Otherwise. check to see if the tolerance reduction factor should be adapted.
+    // This is done if CG is consistently never having to actually run.
+    s->reduction_factor /= 2;
+    s->cg_zero_iters = 0;
+  }
+
+  // Compute the new tolerance
+  return cg_compute_tolerance(admm_iter, rhs_norm,
+                              *(s->scaled_prim_res), *(s->scaled_dual_res),
+                              s->reduction_factor, &(s->eps_prev));
+}
+
+
+OSQPInt init_linsys_pcg(pcg_solver**        sp,
+                        const OSQPMatrix*   P,
+                        const OSQPMatrix*   A,
+                        const OSQPVectorf*  rho_vec,
+                        const OSQPSettings* settings,
+                              OSQPFloat*    scaled_prim_res,
+                              OSQPFloat*    scaled_dual_res,
+                              OSQPInt       polish) {
+
+  OSQPInt m = OSQPMatrix_get_m(A);
+  OSQPInt n = OSQPMatrix_get_n(P);
+  pcg_solver* s = (pcg_solver *)c_calloc(1, sizeof(pcg_solver));
+  *sp = s;
+
+  if (!s) return osqp_error(OSQP_MEM_ALLOC_ERROR);
+
+  //Just hold on to pointers to the problem
+  //data, no copies or processing required
+  s->P       = *(OSQPMatrix**)(&P);
+  s->A       = *(OSQPMatrix**)(&A);
+  s->sigma   = settings->sigma;
+  s->polish  = polish;
+  s->m       = m;
+  s->n       = n;
+
+  s->scaled_prim_res = scaled_prim_res;
+  s->scaled_dual_res = scaled_dual_res;
+
+  //Link functions
+  s->name            = &name_pcg;
+  s->solve           = &solve_linsys_pcg;
+  s->warm_start      = &warm_start_linsys_pcg;
+  s->free            = &free_linsys_pcg;
+  s->update_matrices = &update_matrices_linsys_pcg;
+  s->update_rho_vec  = &update_rho_linsys_pcg;
+  s->update_settings = &update_settings_linsys_solver_pcg;
+
+  // Assign type
+  s->type     = OSQP_INDIRECT_SOLVER;
+#ifdef OSQP_ENABLE_OPENMP
+  s->nthreads = (settings->cg_method == OSQP_CG_PIPELINED) ? omp_get_max_threads() : 1;
+#else
+  s->nthreads = 1;
+#endif
+
+  // Assign Krylov method, preconditioner and iteration limit
+  s->method         = settings->cg_method;
+  s->precond_type   = settings->cg_precond;
+  s->precond_failed = OSQP_NO_PRECONDITIONER;
+  s->block_size     = settings->cg_block_size;
+  s->max_iter       = settings->cg_max_iter;
+
+  // Assign tolerance-related settings
+  s->reduction_interval = settings->cg_tol_reduction;
+  s->tol_fraction       = settings->cg_tol_fraction;
+  s->reduction_factor   = settings->cg_tol_fraction;
+  s->cg_zero_iters      = 0;
+
+  //Initialise solver state to zero since it provides
+  //cold start condition for the CG inner solver
+  s->x     = OSQPVectorf_calloc(n);
+  s->r     = OSQPVectorf_malloc(n);
+  s->y     = OSQPVectorf_malloc(n);
+  s->p     = OSQPVectorf_malloc(n);
+  s->Kp    = OSQPVectorf_malloc(n);
+  s->ywork = OSQPVectorf_malloc(m);
+
+  //if polish is false, use the rho_vec we get.
+  //Otherwise, use rho_vec = ones.*(1/sigma)
+  s->rho_vec = OSQPVectorf_malloc(m);
+
+  //make subviews for the rhs.   OSQP passes
+  //a different RHS pointer at every iteration,
+  //so we will need to update these views every
+  //time we solve. Just point them at x for now.
+  s->r1 = OSQPVectorf_view(s->x, 0, 0);
+  s->r2 = OSQPVectorf_view(s->x, 0, 0);
+
+  s->precond     = OSQPVectorf_malloc(n);
+  s->precond_inv = OSQPVectorf_malloc(n);
+
+  if (!s->x || !s->r || !s->y || !s->p || !s->Kp || !s->ywork || !s->rho_vec ||
+      !s->r1 || !s->r2 || !s->precond || !s->precond_inv) {
+    free_linsys_pcg(s);
+    *sp = OSQP_NULL;
+    return osqp_error(OSQP_MEM_ALLOC_ERROR);
+  }
+
+  if (polish)
+    OSQPVectorf_set_scalar(s->rho_vec, 1. / settings->sigma);
+  else if (rho_vec)
+    OSQPVectorf_copy(s->rho_vec, rho_vec);
+  else
+    OSQPVectorf_set_scalar(s->rho_vec, settings->rho);
+
+  // Vectors of length n (x, r, y, p, Kp and the preconditioner) and m
+  s->memory = (OSQPFloat)((7 * n + 2 * m) * sizeof(OSQPFloat));
+
+  if (s->method == OSQP_CG_MINRES) {
+    s->kkt_x  = OSQPVectorf_calloc(n + m);
+    s->kkt_r  = OSQPVectorf_malloc(n + m);
+    s->kkt_v  = OSQPVectorf_malloc(n + m);
+    s->kkt_y  = OSQPVectorf_malloc(n + m);
+    s->kkt_q1 = OSQPVectorf_malloc(n + m);
+    s->kkt_q2 = OSQPVectorf_malloc(n + m);
+    s->kkt_w  = OSQPVectorf_malloc(n + m);
+    s->kkt_w1 = OSQPVectorf_malloc(n + m);
+    s->kkt_w2 = OSQPVectorf_malloc(n + m);
+    s->rho_inv_vec = OSQPVectorf_malloc(m);
+
+    s->in1  = OSQPVectorf_view(s->x, 0, 0);
+    s->in2  = OSQPVectorf_view(s->x, 0, 0);
+    s->out1 = OSQPVectorf_view(s->x, 0, 0);
+    s->out2 = OSQPVectorf_view(s->x, 0, 0);
+
+    if (!s->kkt_x || !s->kkt_r || !s->kkt_v || !s->kkt_y || !s->kkt_q1 || !s->kkt_q2 ||
+        !s->kkt_w || !s->kkt_w1 || !s->kkt_w2 || !s->rho_inv_vec ||
+        !s->in1 || !s->in2 || !s->out1 || !s->out2) {
+      free_linsys_pcg(s);
+      *sp = OSQP_NULL;
+      return osqp_error(OSQP_MEM_ALLOC_ERROR);
+    }
+
+    OSQPVectorf_ew_reciprocal(s->rho_inv_vec, s->rho_vec);
+    s->memory += (OSQPFloat)((9 * (n + m) + m) * sizeof(OSQPFloat));
+  }
+
+  if (s->method == OSQP_CG_DEFLATED) {
+    s->defl = deflation_new(n);
+    if (!s->defl) {
+      free_linsys_pcg(s);
+      *sp = OSQP_NULL;
+      return osqp_error(OSQP_MEM_ALLOC_ERROR);
+    }
+    s->memory += (OSQPFloat)(2 * (DEFLATION_SIZE + DEFLATION_DIRS) * n * sizeof(OSQPFloat));
+  }
+
+  if (s->method == OSQP_CG_PIPELINED) {
+    s->pl_w = OSQPVectorf_malloc(n);
+    s->pl_m = OSQPVectorf_malloc(n);
+    s->pl_n = OSQPVectorf_malloc(n);
+    s->pl_z = OSQPVectorf_malloc(n);
+    s->pl_q = OSQPVectorf_malloc(n);
+
+    if (!s->pl_w || !s->pl_m || !s->pl_n || !s->pl_z || !s->pl_q) {
+      free_linsys_pcg(s);
+      *sp = OSQP_NULL;
+      return osqp_error(OSQP_MEM_ALLOC_ERROR);
+    }
+    s->memory += (OSQPFloat)(5 * n * sizeof(OSQPFloat));
+
+    if (!OSQPMatrix_is_operator(s->P) && !OSQPMatrix_is_operator(s->A)) {
+      if (pipelined_matrices_new(s)) {
+        free_linsys_pcg(s);
+        *sp = OSQP_NULL;
+        return osqp_error(OSQP_MEM_ALLOC_ERROR);
+      }
+      pipelined_matrices_update(s);
+    }
+  }
+
+  // Compute the preconditioner
+  pcg_update_precond(s);
+
+  return 0;
+}
+
+
+const char* name_pcg(pcg_solver* s) {
+  if (s->method == OSQP_CG_MINRES) {
+    switch(s->precond_type) {
+    case OSQP_NO_PRECONDITIONER:
+      return "Built-in MINRES - No preconditioner";
+    case OSQP_DIAGONAL_PRECONDITIONER:
+      return "Built-in MINRES - Diagonal preconditioner";
+    case OSQP_IC0_PRECONDITIONER:
+      return "Built-in MINRES - Incomplete Cholesky preconditioner";
+    case OSQP_BLOCK_JACOBI_PRECONDITIONER:
+      return "Built-in MINRES - Block-Jacobi preconditioner";
+    }
+
+    return "Built-in MINRES - Unknown preconditioner";
+  }
+
+  if (s->method == OSQP_CG_DEFLATED) {
+    switch(s->precond_type) {
+    case OSQP_NO_PRECONDITIONER:
+      return "Built-in Deflated Conjugate Gradient - No preconditioner";
+    case OSQP_DIAGONAL_PRECONDITIONER:
+      return "Built-in Deflated Conjugate Gradient - Diagonal preconditioner";
+    case OSQP_IC0_PRECONDITIONER:
+      return "Built-in Deflated Conjugate Gradient - Incomplete Cholesky preconditioner";
+    case OSQP_BLOCK_JACOBI_PRECONDITIONER:
+      return "Built-in Deflated Conjugate Gradient - Block-Jacobi preconditioner";
+    }
+
+    return "Built-in Deflated Conjugate Gradient - Unknown preconditioner";
+  }
+
+  if (s->method == OSQP_CG_PIPELINED) {
+    switch(s->precond_type) {
+    case OSQP_NO_PRECONDITIONER:
+      return "Built-in Pipelined Conjugate Gradient - No preconditioner";
+    case OSQP_DIAGONAL_PRECONDITIONER:
+      return "Built-in Pipelined Conjugate Gradient - Diagonal preconditioner";
+    case OSQP_IC0_PRECONDITIONER:
+      return "Built-in Pipelined Conjugate Gradient - Incomplete Cholesky preconditioner";
+    case OSQP_BLOCK_JACOBI_PRECONDITIONER:
+      return "Built-in Pipelined Conjugate Gradient - Block-Jacobi preconditioner";
+    }
+
+    return "Built-in Pipelined Conjugate Gradient - Unknown preconditioner";
+  }
+
+  switch(s->precond_type) {
+  case OSQP_NO_PRECONDITIONER:
+    return "Built-in Conjugate Gradient - No preconditioner";
+  case OSQP_DIAGONAL_PRECONDITIONER:
+    return "Built-in Conjugate Gradient - Diagonal preconditioner";
+  case OSQP_IC0_PRECONDITIONER:
+    return "Built-in Conjugate Gradient - Incomplete Cholesky preconditioner";
+  case OSQP_BLOCK_JACOBI_PRECONDITIONER:
+    return "Built-in Conjugate Gradient - Block-Jacobi preconditioner";
+  }
+
+  return "Built-in Conjugate Gradient - Unknown preconditioner";
+}
+
+
+OSQPInt solve_linsys_pcg(pcg_solver*  s,
+                         OSQPVectorf* b,
+                         OSQPInt      admm_iter) {
+
+  OSQPFloat rhs_norm = 0.0;
+  OSQPFloat eps      = 1.0;
+
+  osqp_profiler_sec_push(OSQP_PROFILER_SEC_LINSYS_SOLVE);
+
+  //Point our subviews at the OSQP RHS
+  OSQPVectorf_view_update(s->r1, b,    0, s->n);
+  OSQPVectorf_view_update(s->r2, b, s->n, s->m);
+
+  // Refresh the factored preconditioners after rho or matrix updates
+  if (s->precond_dirty)
+    pcg_factor_precond(s);
+
+  if (s->method == OSQP_CG_MINRES) {
+    // MINRES tests the residual of the full KKT system, so the tolerance is
+    // relative to the norm of its rhs b and not of the reduced rhs used by PCG
+    rhs_norm = OSQPVectorf_norm_inf(b);
+    eps      = pcg_tolerance(s, rhs_norm, admm_iter);
+
+    // Solve the full KKT system, warm starting from (s->x, nu)
+    s->cg_iters = minres_alg(s, b, eps);
+
+    // b = (x, nu)
+    OSQPVectorf_copy(b, s->kkt_x);
+    OSQPVectorf_copy(s->x, s->r1);
+
+    //OSQP wants us to return (x,Ax) in place, or (x,nu) when polishing
+    if (!s->polish)
+      OSQPMatrix_Axpy(s->A, s->x, s->r2, 1.0, 0.0);
+  } else {
+    // Compute the RHS for the CG solve and its norm
+    reduced_kkt_compute_rhs(s->A, s->rho_vec, s->r1, s->r2, s->ywork);
+    rhs_norm = OSQPVectorf_norm_inf(s->r1);
+
+    // Compute the desired solution precision
+    eps = pcg_tolerance(s, rhs_norm, admm_iter);
+
+    // Solve the CG system, warm starting from s->x
+    if (s->method == OSQP_CG_PIPELINED)
+      s->cg_iters = pipelined_alg(s, eps);
+    else
+      s->cg_iters = pcg_alg(s, eps);
+
+    // Refine the deflation basis with the directions of this solve
+    if (s->defl)
+      deflation_update(s->defl);
+
+    OSQPVectorf_copy(s->r1, s->x);
+
+    if (!s->polish) {
+      //OSQP wants us to return (x,Ax) in place
+      OSQPMatrix_Axpy(s->A, s->x, s->r2, 1.0, 0.0);
+    } else {
+      //OSQP wants us to return (x,\nu) in place,
+      // where r2 = \nu = rho.*(Ax - r2)
+      OSQPMatrix_Axpy(s->A, s->x, s->r2, 1.0, -1.0);
+      OSQPVectorf_ew_prod(s->r2, s->r2, s->rho_vec);
+    }
+  }
+
+  // Record if no CG iterations were performed
+  if (s->cg_iters == 0)
+    s->cg_zero_iters++;
+  else
+    s->cg_zero_iters = 0;
+
+  osqp_profiler_sec_pop(OSQP_PROFILER_SEC_LINSYS_SOLVE);
+
+  return 0;
+}
+
+
+void update_settings_linsys_solver_pcg(pcg_solver*         s,
+                                       const OSQPSettings* settings) {
+
+  // New block partition requested
+  if (s->block_size != settings->cg_block_size) {
+    s->block_size = settings->cg_block_size;
+
+    if (s->bjac) {
+      s->memory -= (OSQPFloat)(s->bjac->L_ptr[s->bjac->nblocks] * sizeof(OSQPFloat));
+      block_jacobi_free(s->bjac);
+      s->bjac = OSQP_NULL;
+    }
+
+    if (pcg_active_precond(s) == OSQP_BLOCK_JACOBI_PRECONDITIONER)
+      s->precond_dirty = 1;
+  }
+
+  // New precoditioner type requested
+  if (s->precond_type != settings->cg_precond) {
+    s->precond_type = settings->cg_precond;
+    pcg_update_precond(s);
+  }
+
+  // Maximum number of iterations
+  s->max_iter = settings->cg_max_iter;
+
+  // Update adaptive tolerance parameters
+  s->reduction_interval = settings->cg_tol_reduction;
+  s->tol_fraction       = settings->cg_tol_fraction;
+}
+
+
+void warm_start_linsys_pcg(pcg_solver*        s,
+                           const OSQPVectorf* x) {
+  OSQPVectorf_copy(s->x, x);
+}
+
+
+OSQPInt update_matrices_linsys_pcg(pcg_solver*       s,
+                                   const OSQPMatrix* P,
+                                   const OSQPInt*    Px_new_idx,
+                                   OSQPInt           P_new_n,
+                                   const OSQPMatrix* A,
+                                   const OSQPInt*    Ax_new_idx,
+                                   OSQPInt           A_new_n) {
+  /* The PCG solver holds pointers to the matrices A and P, so it already has
+     access to the updated matrices at this point. The only task remaining is to
+     recompute the preconditioner */
+  OSQP_UnusedVar(P);
+  OSQP_UnusedVar(Px_new_idx);
+  OSQP_UnusedVar(P_new_n);
+  OSQP_UnusedVar(A);
+  OSQP_UnusedVar(Ax_new_idx);
+  OSQP_UnusedVar(A_new_n);
+
+  s->precond_failed = OSQP_NO_PRECONDITIONER;
+  pcg_update_precond(s);
+
+  if (s->pl_P)
+    pipelined_matrices_update(s);
+
+  // The deflation basis belongs to the previous matrices
+  if (s->defl)
+    deflation_reset(s->defl);
+
+  return 0;
+}
+
+
+OSQPInt update_rho_linsys_pcg(pcg_solver*        s,
+                              const OSQPVectorf* rho_vec,
+                              OSQPFloat          rho_sc) {
+  if (rho_vec)
+    OSQPVectorf_copy(s->rho_vec, rho_vec);
+  else
+    OSQPVectorf_set_scalar(s->rho_vec, rho_sc);
+
+  if (s->rho_inv_vec)
+    OSQPVectorf_ew_reciprocal(s->rho_inv_vec, s->rho_vec);
+
+  // Update the preconditioner (rho-only update)
+  s->precond_failed = OSQP_NO_PRECONDITIONER;
+  pcg_update_precond(s);
+
+  if (s->defl)
+    deflation_reset(s->defl);
+
+  return 0;
+}
+
+
+void free_linsys_pcg(pcg_solver* s) {
+
+  if (s) {
+    OSQPVectorf_free(s->x);
+    OSQPVectorf_free(s->r);
+    OSQPVectorf_free(s->y);
+    OSQPVectorf_free(s->p);
+    OSQPVectorf_free(s->Kp);
+    OSQPVectorf_free(s->ywork);
+    OSQPVectorf_free(s->rho_vec);
+    OSQPVectorf_free(s->precond);
+    OSQPVectorf_free(s->precond_inv);
+    OSQPVectorf_view_free(s->r1);
+    OSQPVectorf_view_free(s->r2);
+    OSQPVectorf_free(s->kkt_x);
+    OSQPVectorf_free(s->kkt_r);
+    OSQPVectorf_free(s->kkt_v);
+    OSQPVectorf_free(s->kkt_y);
+    OSQPVectorf_free(s->kkt_q1);
+    OSQPVectorf_free(s->kkt_q2);
+    OSQPVectorf_free(s->kkt_w);
+    OSQPVectorf_free(s->kkt_w1);
+    OSQPVectorf_free(s->kkt_w2);
+    OSQPVectorf_free(s->rho_inv_vec);
+    OSQPVectorf_view_free(s->in1);
+    OSQPVectorf_view_free(s->in2);
+    OSQPVectorf_view_free(s->out1);
+    OSQPVectorf_view_free(s->out2);
+    OSQPVectorf_free(s->pl_w);
+    OSQPVectorf_free(s->pl_m);
+    OSQPVectorf_free(s->pl_n);
+    OSQPVectorf_free(s->pl_z);
+    OSQPVectorf_free(s->pl_q);
+    csc_spfree(s->pl_P);
+    csc_spfree(s->pl_At);
+    c_free(s->pl_Pmap);
+    c_free(s->pl_Amap);
+    ic0_free(s->ic0);
+    block_jacobi_free(s->bjac);
+    deflation_free(s->defl);
+    c_free(s);
+  }
+}
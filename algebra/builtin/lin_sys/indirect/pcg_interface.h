@@ -0,0 +1,248 @@
+#ifndef PCG_INTERFACE_H
+#define PCG_INTERFACE_H
+
+
+#include "osqp.h"
+#include "types.h"    //OSQPMatrix and OSQPVector[fi] types
+#include "ic0.h"
+#include "block_jacobi.h"
+#include "deflation.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Builtin preconditioned conjugate gradient solver structure
+ *
+ * The solver works on the reduced KKT system
+ *
+ *   (P + sigma*I + A'*diag(rho)*A) x = b1 + A'*diag(rho)*b2
+ *
+ * using only products with the problem matrices. With OSQP_CG_MINRES it runs
+ * MINRES on the full quasi-definite KKT system
+ *
+ *   [P + sigma*I        A'     ] [x ]   [b1]
+ *   [     A      -diag(1/rho) ] [nu] = [b2]
+ *
+ * instead, preconditioned by blkdiag(M, diag(1/rho)) where M is the
+ * preconditioner of the reduced system. With OSQP_CG_DEFLATED the conjugate
+ * gradient iterates are deflated with a basis of approximate eigenvectors of
+ * the reduced system recycled across solves. OSQP_CG_PIPELINED runs the
+ * pipelined conjugate gradient method of Ghysels and Vanroose. Its single
+ * reduction per iteration does not depend on the matrix-vector product of the
+ * same iteration, so both are computed in one parallel region using row-wise
+ * copies of P and A.
+ */
+typedef struct pcg_solver_ {
+
+  enum osqp_linsys_solver_type type;
+
+  /**
+   * @name Functions
+   * @{
+   */
+  const char* (*name)(struct pcg_solver_* self);
+  OSQPInt (*solve)(struct pcg_solver_* self, OSQPVectorf* b, OSQPInt admm_iter);
+  void    (*update_settings)(struct pcg_solver_* self, const OSQPSettings* settings);
+  void    (*warm_start)(struct pcg_solver_* self, const OSQPVectorf* x);
+  OSQPInt (*adjoint_derivative)(struct pcg_solver_* self);
+  void    (*free)(struct pcg_solver_* self);
+  OSQPInt (*solve_multi)(struct pcg_solver_* self, OSQPVectorf* b, OSQPInt k);
+  OSQPInt (*update_matrices)(struct pcg_solver_* self,
+                             const  OSQPMatrix*  P,
+                             const  OSQPInt*     Px_new_idx,
+                                    OSQPInt      P_new_n,
+                             const  OSQPMatrix*  A,
+                             const  OSQPInt*     Ax_new_idx,
+                                    OSQPInt      A_new_n);
+  OSQPInt (*update_rho_vec)(struct pcg_solver_* self,
+                            const OSQPVectorf* rho_vec,
+                                  OSQPFloat    rho_sc);
+
+  //threads count (pipelined method only)
+  OSQPInt nthreads;
+
+  // Memory usage in bytes
+  OSQPFloat memory;
+
+  /** @} */
+
+  /**
+   * @name Attributes
+   * @{
+   */
+  OSQPMatrix*  P;               ///< The P matrix provided by OSQP (just a pointer, don't delete it!)
+  OSQPMatrix*  A;               ///< The A matrix provided by OSQP (just a pointer, don't delete it!)
+  OSQPVectorf* rho_vec;         ///< Copy of the rho vector (1/sigma when polishing)
+  OSQPFloat*   scaled_prim_res; ///< The primal residual provided by OSQP (just a pointer)
+  OSQPFloat*   scaled_dual_res; ///< The dual residual provided by OSQP (just a pointer)
+  OSQPFloat    sigma;           ///< The sigma value provided by OSQP
+  OSQPInt      m;               ///< Number of constraints
+  OSQPInt      n;               ///< Number of variables
+  OSQPInt      polish;          ///< Polishing or not?
+
+  osqp_cg_method_type method;   ///< Krylov method (fixed at setup)
+  osqp_precond_type precond_type; ///< Preconditioner to use
+  osqp_precond_type precond_failed; ///< Preconditioner whose factorization failed for the current P, A and rho (OSQP_NO_PRECONDITIONER if none)
+  OSQPInt      block_size;      ///< Block size of the block-Jacobi preconditioner (0 = automatic)
+
+  OSQPInt      max_iter;        ///< Maximum number of CG iterations per solve
+
+  // Adaptable termination variables
+  OSQPFloat eps_prev;           ///< Tolerance for previous ADMM iteration
+  OSQPInt   reduction_interval; ///< Number of iterations between reduction factor updates
+  OSQPFloat reduction_factor;   ///< Amount to change tolerance by each iteration
+  OSQPFloat tol_fraction;       ///< Tolerance (fraction of ADMM residuals)
+
+  OSQPInt   cg_zero_iters;      ///< Consecutive solves that required no CG iterations
+  OSQPInt   cg_iters;           ///< CG iterations performed in the last solve
+
+  // Internal copy of the solution x to warm start successive solves
+  OSQPVectorf* x;
+
+  // CG iterates
+  OSQPVectorf* r;               ///< residual K*x - rhs
+  OSQPVectorf* y;               ///< preconditioned residual
+  OSQPVectorf* p;               ///< search direction
+  OSQPVectorf* Kp;              ///< K*p
+  OSQPVectorf* ywork;           ///< work vector for products with A (length m)
+
+  // Views of the right-hand side passed by OSQP
+  OSQPVectorf* r1;
+  OSQPVectorf* r2;
+
+  // Jacobi preconditioner
+  OSQPVectorf* precond;         ///< diagonal of the reduced KKT matrix
+  OSQPVectorf* precond_inv;     ///< inverse of precond
+
+  // Factored preconditioners (OSQP_NULL until first used)
+  ic0_precond*          ic0;    ///< incomplete Cholesky factor of the reduced KKT matrix
+  block_jacobi_precond* bjac;   ///< factors of the diagonal blocks of the reduced KKT matrix
+  OSQPInt               precond_dirty; ///< factor must be recomputed before the next solve
+
+  // Deflation basis (OSQP_NULL unless method = OSQP_CG_DEFLATED)
+  cg_deflation*         defl;
+
+  // MINRES iterates on the full KKT system (OSQP_NULL unless method = OSQP_CG_MINRES)
+  OSQPVectorf* kkt_x;           ///< solution (x, nu); nu warm starts the next solve
+  OSQPVectorf* kkt_r;           ///< residual rhs - K*(x, nu)
+  OSQPVectorf* kkt_v;           ///< preconditioned Lanczos vector
+  OSQPVectorf* kkt_y;           ///< work vector
+  OSQPVectorf* kkt_q1;          ///< previous Lanczos vector (not preconditioned)
+  OSQPVectorf* kkt_q2;          ///< current Lanczos vector (not preconditioned)
+  OSQPVectorf* kkt_w;           ///< search directions of the last three iterations
+  OSQPVectorf* kkt_w1;
+  OSQPVectorf* kkt_w2;
+  OSQPVectorf* rho_inv_vec;     ///< 1./rho_vec
+
+  // Views of the x and nu parts of the MINRES vectors
+  OSQPVectorf* in1;
+  OSQPVectorf* in2;
+  OSQPVectorf* out1;
+  OSQPVectorf* out2;
+
+  // Pipelined CG iterates (OSQP_NULL unless method = OSQP_CG_PIPELINED).
+  // r holds rhs - K*x, y = M \ r, p the search direction and Kp = K*p.
+  OSQPVectorf* pl_w;            ///< K*y
+  OSQPVectorf* pl_m;            ///< M \ pl_w
+  OSQPVectorf* pl_n;            ///< K*pl_m
+  OSQPVectorf* pl_z;            ///< K*pl_q
+  OSQPVectorf* pl_q;            ///< M \ Kp
+
+  // Copies of P and A whose columns are the rows of P and A, so that each
+  // thread gathers its entries of K*x (OSQP_NULL for operators)
+  OSQPCscMatrix* pl_P;          ///< full symmetric P
+  OSQPInt*       pl_Pmap;       ///< positions in pl_P of each entry of P (-1 for the diagonal mirror)
+  OSQPCscMatrix* pl_At;         ///< A'
+  OSQPInt*       pl_Amap;       ///< positions in pl_At of each entry of A
+  /** @} */
+
+} pcg_solver;
+
+
+/**
+ * Initialize the builtin PCG solver
+ *
+ * @param  sp              Pointer to a private structure
+ * @param  P               Objective function matrix (upper triangular form)
+ * @param  A               Constraints matrix
+ * @param  rho_vec         Algorithm parameter. If polish, then rho_vec = OSQP_NULL.
+ * @param  settings        Solver settings
+ * @param  scaled_prim_res Pointer to the scaled primal residual of OSQP
+ * @param  scaled_dual_res Pointer to the scaled dual residual of OSQP
+ * @param  polish          Flag whether we are initializing for polishing or not
+ * @return                 Exitflag for error (0 if no errors)
+ */
+OSQPInt init_linsys_pcg(pcg_solver**        sp,
+                        const OSQPMatrix*   P,
+                        const OSQPMatrix*   A,
+                        const OSQPVectorf*  rho_vec,
+                        const OSQPSettings* settings,
+                              OSQPFloat*    scaled_prim_res,
+                              OSQPFloat*    scaled_dual_res,
+                              OSQPInt       polish);
+
+/**
+ * Get the user-friendly name of the PCG solver.
+ * @return The user-friendly name
+ */
+const char* name_pcg(pcg_solver* s);
+
+/**
+ * Solve the linear system and store the result in b
+ * @param  s         Linear system solver structure
+ * @param  b         Right-hand side
+ * @param  admm_iter Current ADMM iteration (used to pick the CG tolerance)
+ * @return           Exitflag
+ */
+OSQPInt solve_linsys_pcg(pcg_solver*  s,
+                         OSQPVectorf* b,
+                         OSQPInt      admm_iter);
+
+void update_settings_linsys_solver_pcg(pcg_solver*         s,
+                                       const OSQPSettings* settings);
+
+/**
+ * Warm start the next solve from x
+ * @param s Linear system solver structure
+ * @param x Initial guess of the x part of the solution
+ */
+void warm_start_linsys_pcg(pcg_solver*        s,
+                           const OSQPVectorf* x);
+
+/**
+ * Update the linear system solver after P or A changed
+ * (only the preconditioner depends on their values)
+ * @return Exitflag
+ */
+OSQPInt update_matrices_linsys_pcg(pcg_solver*       s,
+                                   const OSQPMatrix* P,
+                                   const OSQPInt*    Px_new_idx,
+                                   OSQPInt           P_new_n,
+                                   const OSQPMatrix* A,
+                                   const OSQPInt*    Ax_new_idx,
+                                   OSQPInt           A_new_n);
+
+/**
+ * Update rho_vec parameter in the linear system solver structure
+ * @param  s        Linear system solver structure
+ * @param  rho_vec  new rho_vec value
+ * @param  rho_sc   new scalar rho value
+ * @return          exitflag
+ */
+OSQPInt update_rho_linsys_pcg(pcg_solver*        s,
+                              const OSQPVectorf* rho_vec,
+                              OSQPFloat          rho_sc);
+
+/**
+ * Free linear system solver
+ * @param s linear system solver object
+ */
+void free_linsys_pcg(pcg_solver* s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PCG_INTERFACE_H */
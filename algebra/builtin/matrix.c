@@ -14,11 +14,64 @@ OSQPInt OSQPMatrix_is_eq(const OSQPMatrix* A,
                          const OSQPMatrix* B,
                          OSQPFloat         tol) {
 
+  if (A->op || B->op) return 0;
+
   return (A->symmetry == B->symmetry &&
           csc_is_eq(A->csc, B->csc, tol) );
 }
 
 
+/*  matrix-free operators ----------------------------------------------------*/
+
+static void op_free(OSQPMatrixOperator* o) {
+  if (o) {
+    c_free(o->ywork);
+    c_free(o);
+  }
+}
+
+static OSQPMatrixOperator* op_new(const OSQPOperator* op) {
+
+  OSQPMatrixOperator* o = c_calloc(1, sizeof(OSQPMatrixOperator));
+  if (!o) return OSQP_NULL;
+
+  o->op    = *op;
+  o->ywork = c_malloc(c_max(c_max(op->m, op->n), 1) * sizeof(OSQPFloat));
+
+  if (!o->ywork) {
+    op_free(o);
+    return OSQP_NULL;
+  }
+
+  return o;
+}
+
+static OSQPMatrixOperator* op_copy(const OSQPMatrixOperator* o) {
+  return op_new(&o->op);
+}
+
+//y = alpha*M*x + beta*y (or M' when trans)
+static void op_Axpy(const OSQPMatrixOperator* o,
+                    OSQPInt                   trans,
+                    const OSQPFloat*          x,
+                          OSQPFloat*          y,
+                          OSQPFloat           alpha,
+                          OSQPFloat           beta) {
+
+  OSQPInt i;
+  OSQPInt nout = trans ? o->op.n : o->op.m;
+
+  if (trans && o->op.mult_t) o->op.mult_t(o->op.data, x, o->ywork);
+  else                       o->op.mult(o->op.data, x, o->ywork);
+
+  if (beta == 0.0) {
+    for (i = 0; i < nout; i++) y[i] = alpha * o->ywork[i];
+  } else {
+    for (i = 0; i < nout; i++) y[i] = beta * y[i] + alpha * o->ywork[i];
+  }
+}
+
+
 /*  Non-embeddable functions (using malloc) ----------------------------------*/
 
 //Make a copy from a csc matrix.  Returns OSQP_NULL on failure
@@ -31,6 +84,7 @@ OSQPMatrix* OSQPMatrix_new_from_csc(const OSQPCscMatrix* A,
   if(is_triu) out->symmetry = TRIU;
   else        out->symmetry = NONE;
 
+  out->op  = OSQP_NULL;
   out->csc = csc_copy(A);
 
   if(!out->csc){
@@ -42,7 +96,30 @@ OSQPMatrix* OSQPMatrix_new_from_csc(const OSQPCscMatrix* A,
   }
 }
 
-OSQPCscMatrix* OSQPMatrix_get_csc(const OSQPMatrix* M) {return csc_copy(M->csc);}
+//Wrap a matrix-free operator.  Returns OSQP_NULL on failure
+OSQPMatrix* OSQPMatrix_new_from_operator(const OSQPOperator* op,
+                                               OSQPInt       is_triu) {
+
+  OSQPMatrix* out = c_malloc(sizeof(OSQPMatrix));
+  if(!out) return OSQP_NULL;
+
+  out->symmetry = is_triu ? TRIU : NONE;
+  out->csc      = OSQP_NULL;
+  out->op       = op_new(op);
+
+  if(!out->op){
+    c_free(out);
+    return OSQP_NULL;
+  }
+  return out;
+}
+
+OSQPInt OSQPMatrix_is_operator(const OSQPMatrix* M) {return M->op != OSQP_NULL;}
+
+OSQPCscMatrix* OSQPMatrix_get_csc(const OSQPMatrix* M) {
+  if (M->op) return OSQP_NULL;
+  return csc_copy(M->csc);
+}
 
 // Make of a copy of a matrix
 OSQPMatrix* OSQPMatrix_copy_new(const OSQPMatrix* A) {
@@ -50,9 +127,13 @@ OSQPMatrix* OSQPMatrix_copy_new(const OSQPMatrix* A) {
     if(!out) return OSQP_NULL;
 
     out->symmetry = A->symmetry;
-    out->csc = csc_copy(A->csc);
+    out->csc = OSQP_NULL;
+    out->op  = OSQP_NULL;
+
+    if (A->op) out->op  = op_copy(A->op);
+    else       out->csc = csc_copy(A->csc);
 
-    if(!out->csc){
+    if(!out->csc && !out->op){
         c_free(out);
         return OSQP_NULL;
     }
@@ -64,11 +145,17 @@ OSQPMatrix* OSQPMatrix_copy_new(const OSQPMatrix* A) {
 // Convert an upper triangular matrix into a fully populated matrix
 OSQPMatrix* OSQPMatrix_triu_to_symm(const OSQPMatrix* A) {
 
+    if (A->op) {
+      c_eprint("conversion not implemented for matrix-free operators");
+      return OSQP_NULL;
+    }
+
     if (A->symmetry == TRIU) {
         OSQPMatrix* out = c_malloc(sizeof(OSQPMatrix));
         if(!out) return OSQP_NULL;
 
         out->symmetry = NONE;
+        out->op  = OSQP_NULL;
         out->csc = triu_to_csc(A->csc);
 
         if (!out->csc) {
@@ -85,11 +172,17 @@ OSQPMatrix* OSQPMatrix_triu_to_symm(const OSQPMatrix* A) {
 
 OSQPMatrix* OSQPMatrix_vstack(const OSQPMatrix* A,
                               const OSQPMatrix* B) {
+    if (A->op || B->op) {
+        c_eprint("Can not vstack matrix-free operators");
+        return OSQP_NULL;
+    }
+
     if ((A->symmetry == NONE) && (B->symmetry == NONE)) {
         OSQPMatrix* out = c_malloc(sizeof(OSQPMatrix));
         if(!out) return OSQP_NULL;
 
         out->symmetry = NONE;
+        out->op  = OSQP_NULL;
         out->csc = vstack(A->csc, B->csc);
 
         if (!out->csc) {
@@ -112,43 +205,100 @@ void OSQPMatrix_update_values(OSQPMatrix*      M,
                               const OSQPFloat* Mx_new,
                               const OSQPInt*   Mx_new_idx,
                               OSQPInt          M_new_n) {
+#ifndef OSQP_EMBEDDED_MODE
+  // Operators have no stored values
+  if (M->op) return;
+#endif
   csc_update_values(M->csc, Mx_new, Mx_new_idx, M_new_n);
 }
 
 /* Matrix dimensions and data access */
+#ifndef OSQP_EMBEDDED_MODE
+OSQPInt    OSQPMatrix_get_m(const OSQPMatrix* M)  {return M->op ? M->op->op.m : M->csc->m;}
+OSQPInt    OSQPMatrix_get_n(const OSQPMatrix* M)  {return M->op ? M->op->op.n : M->csc->n;}
+OSQPFloat* OSQPMatrix_get_x(const OSQPMatrix* M)  {return M->op ? OSQP_NULL : M->csc->x;}
+OSQPInt*   OSQPMatrix_get_i(const OSQPMatrix* M)  {return M->op ? OSQP_NULL : M->csc->i;}
+OSQPInt*   OSQPMatrix_get_p(const OSQPMatrix* M)  {return M->op ? OSQP_NULL : M->csc->p;}
+OSQPInt    OSQPMatrix_get_nz(const OSQPMatrix* M) {return M->op ? 0 : M->csc->p[M->csc->n];}
+#else
 OSQPInt    OSQPMatrix_get_m(const OSQPMatrix* M)  {return M->csc->m;}
 OSQPInt    OSQPMatrix_get_n(const OSQPMatrix* M)  {return M->csc->n;}
 OSQPFloat* OSQPMatrix_get_x(const OSQPMatrix* M)  {return M->csc->x;}
 OSQPInt*   OSQPMatrix_get_i(const OSQPMatrix* M)  {return M->csc->i;}
 OSQPInt*   OSQPMatrix_get_p(const OSQPMatrix* M)  {return M->csc->p;}
 OSQPInt    OSQPMatrix_get_nz(const OSQPMatrix* M) {return M->csc->p[M->csc->n];}
+#endif
 
 /* math functions ----------------------------------------------------------*/
 
 //A = sc*A
 void OSQPMatrix_mult_scalar(OSQPMatrix *A,
                             OSQPFloat   sc){
+#ifndef OSQP_EMBEDDED_MODE
+  if (A->op) {
+    c_eprint("scaling not implemented for matrix-free operators");
+    return;
+  }
+#endif
   csc_scale(A->csc,sc);
 }
 
 void OSQPMatrix_lmult_diag(OSQPMatrix*        A,
                            const OSQPVectorf* L) {
+#ifndef OSQP_EMBEDDED_MODE
+  if (A->op) {
+    c_eprint("scaling not implemented for matrix-free operators");
+    return;
+  }
+#endif
   csc_lmult_diag(A->csc, OSQPVectorf_data(L));
 }
 
 void OSQPMatrix_rmult_diag(OSQPMatrix* A,
                            const OSQPVectorf* R) {
+#ifndef OSQP_EMBEDDED_MODE
+  if (A->op) {
+    c_eprint("scaling not implemented for matrix-free operators");
+    return;
+  }
+#endif
   csc_rmult_diag(A->csc, R->values);
 }
 
 void OSQPMatrix_AtDA_extract_diag(const OSQPMatrix*  A,
                                   const OSQPVectorf* D,
                                         OSQPVectorf* d) {
+#ifndef OSQP_EMBEDDED_MODE
+  OSQPInt i;
+  OSQPFloat Dmean = 0.0;
+  const OSQPMatrixOperator* o = A->op;
+
+  if (o) {
+    /* Only the squared column norms of the operator are known, so the row
+       weights D are replaced by their mean (exact for uniform weights) */
+    for (i = 0; i < o->op.m; i++) Dmean += D->values[i];
+    if (o->op.m) Dmean /= o->op.m;
+
+    for (i = 0; i < o->op.n; i++)
+      d->values[i] = o->op.diag ? Dmean * o->op.diag[i] : 0.0;
+    return;
+  }
+#endif
     csc_AtDA_extract_diag(A->csc, OSQPVectorf_data(D), OSQPVectorf_data(d));
 }
 
 void OSQPMatrix_extract_diag(const OSQPMatrix*  A,
                                    OSQPVectorf* d) {
+#ifndef OSQP_EMBEDDED_MODE
+  OSQPInt i;
+  const OSQPMatrixOperator* o = A->op;
+
+  if (o) {
+    for (i = 0; i < o->op.n; i++)
+      d->values[i] = o->op.diag ? o->op.diag[i] : 0.0;
+    return;
+  }
+#endif
   csc_extract_diag(A->csc, OSQPVectorf_data(d));
 }
 
@@ -159,6 +309,13 @@ void OSQPMatrix_Axpy(const OSQPMatrix*  A,
                            OSQPFloat    alpha,
                            OSQPFloat    beta) {
 
+#ifndef OSQP_EMBEDDED_MODE
+  if(A->op){
+    op_Axpy(A->op, 0, x->values, y->values, alpha, beta);
+    return;
+  }
+#endif
+
   if(A->symmetry == NONE){
     //full matrix
     csc_Axpy(A->csc, x->values, y->values, alpha, beta);
@@ -175,6 +332,13 @@ void OSQPMatrix_Atxpy(const OSQPMatrix*  A,
                             OSQPFloat    alpha,
                             OSQPFloat    beta) {
 
+#ifndef OSQP_EMBEDDED_MODE
+   if(A->op){
+     op_Axpy(A->op, A->symmetry == NONE, x->values, y->values, alpha, beta);
+     return;
+   }
+#endif
+
    if(A->symmetry == NONE) csc_Atxpy(A->csc, x->values, y->values, alpha, beta);
    else            csc_Axpy_sym_triu(A->csc, x->values, y->values, alpha, beta);
 }
@@ -193,11 +357,24 @@ void OSQPMatrix_Atxpy(const OSQPMatrix*  A,
 
 void OSQPMatrix_col_norm_inf(const OSQPMatrix*  M,
                                    OSQPVectorf* E) {
+#ifndef OSQP_EMBEDDED_MODE
+   // Norms of operators are unknown, and the data scaling is off for them
+   if(M->op){
+     OSQPVectorf_set_scalar(E, 1.0);
+     return;
+   }
+#endif
    csc_col_norm_inf(M->csc, OSQPVectorf_data(E));
 }
 
 void OSQPMatrix_row_norm_inf(const OSQPMatrix*  M,
                                    OSQPVectorf* E) {
+#ifndef OSQP_EMBEDDED_MODE
+   if(M->op){
+     OSQPVectorf_set_scalar(E, 1.0);
+     return;
+   }
+#endif
    if(M->symmetry == NONE) csc_row_norm_inf(M->csc, OSQPVectorf_data(E));
    else                    csc_row_norm_inf_sym_triu(M->csc, OSQPVectorf_data(E));
 }
@@ -207,7 +384,10 @@ void OSQPMatrix_row_norm_inf(const OSQPMatrix*  M,
 #ifndef OSQP_EMBEDDED_MODE
 
 void OSQPMatrix_free(OSQPMatrix* M){
-  if (M) csc_spfree(M->csc);
+  if (M) {
+    csc_spfree(M->csc);
+    op_free(M->op);
+  }
   c_free(M);
 }
 
@@ -223,6 +403,11 @@ OSQPMatrix* OSQPMatrix_submatrix_byrows(const OSQPMatrix*  A,
     return OSQP_NULL;
   }
 
+  if(A->op){
+    c_eprint("row selection not implemented for matrix-free operators");
+    return OSQP_NULL;
+  }
+
 
   M = csc_submatrix_byrows(A->csc, rows->values);
 
@@ -237,6 +422,7 @@ OSQPMatrix* OSQPMatrix_submatrix_byrows(const OSQPMatrix*  A,
 
   out->symmetry = NONE;
   out->csc      = M;
+  out->op       = OSQP_NULL;
 
   return out;
 
@@ -277,8 +277,11 @@ void cuda_pcg_update_precond(cudapcg_solver* s,
     cuda_vec_set_sc(s->d_diag_precond_inv, 1.0, s->n);
     break;
 
-  /* Diagonal preconditioner computation */
+  /* Diagonal preconditioner computation
+     (the factored preconditioners are not available on the GPU) */
   case OSQP_DIAGONAL_PRECONDITIONER:
+  case OSQP_IC0_PRECONDITIONER:
+  case OSQP_BLOCK_JACOBI_PRECONDITIONER:
     cuda_pcg_update_precond_diagonal(s, P_updated, A_updated, R_updated);
     break;
   }
@@ -219,6 +219,8 @@ const char* name_cudapcg(cudapcg_solver* s) {
   case OSQP_NO_PRECONDITIONER:
     return "CUDA Conjugate Gradient - No preconditioner";
   case OSQP_DIAGONAL_PRECONDITIONER:
+  case OSQP_IC0_PRECONDITIONER:
+  case OSQP_BLOCK_JACOBI_PRECONDITIONER:
     return "CUDA Conjugate Gradient - Diagonal preconditioner";
   }
 
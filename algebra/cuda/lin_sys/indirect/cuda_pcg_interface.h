@@ -52,6 +52,10 @@ typedef struct cudapcg_solver_ {
 
   void (*free)(struct cudapcg_solver_* self);
 
+  OSQPInt (*solve_multi)(struct cudapcg_solver_* self,
+                         OSQPVectorf*            b,
+                         OSQPInt                 k);
+
   OSQPInt (*update_matrices)(struct cudapcg_solver_* self,
                              const  OSQPMatrix*      P,
                              const  OSQPInt*         Px_new_idx,
@@ -67,6 +71,9 @@ typedef struct cudapcg_solver_ {
   /* threads count */
   OSQPInt nthreads;
 
+  /* Memory usage (not reported) */
+  OSQPFloat memory;
+
   /* Dimensions */
   OSQPInt n;                  ///<  dimension of the linear system
   OSQPInt m;                  ///<  number of rows in A
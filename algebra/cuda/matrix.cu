@@ -56,6 +56,16 @@ OSQPMatrix* OSQPMatrix_new_from_csc(const OSQPCscMatrix* M,
   return out;
 }
 
+/* Matrix-free operators are not supported by the CUDA algebra */
+OSQPMatrix* OSQPMatrix_new_from_operator(const OSQPOperator* /*op*/,
+                                               OSQPInt       /*is_triu*/) {
+  return OSQP_NULL;
+}
+
+OSQPInt OSQPMatrix_is_operator(const OSQPMatrix* /*mat*/) {
+  return 0;
+}
+
 void OSQPMatrix_update_values(OSQPMatrix*      mat,
                               const OSQPFloat* Mx_new,
                               const OSQPInt*   Mx_new_idx,
@@ -179,6 +179,17 @@ OSQPVectorf* OSQPVectorf_view(const OSQPVectorf* a,
   return view;
 }
 
+void OSQPVectorf_view_update(OSQPVectorf*       a,
+                             const OSQPVectorf* b,
+                             OSQPInt            head,
+                             OSQPInt            length) {
+
+  cuda_vec_destroy(a->vec);
+  a->length = length;
+  a->d_val  = b->d_val + head;
+  cuda_vec_create(&a->vec, a->d_val, length);
+}
+
 void OSQPVectorf_view_free(OSQPVectorf* a) {
   c_free(a);
 }
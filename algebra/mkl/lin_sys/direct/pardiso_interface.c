@@ -123,10 +123,16 @@ OSQPInt init_linsys_solver_pardiso(pardiso_solver**    sp,
 
   // Form KKT matrix
   if (polishing){ // Called from polish()
+
+    // Keep the indices of P and A so that polish() can refactor a
+    // cached factorization after the data change
+    s->PtoKKT = c_malloc(c_max(P->csc->p[n], 1) * sizeof(OSQPInt));
+    s->AtoKKT = c_malloc(c_max(A->csc->p[n], 1) * sizeof(OSQPInt));
+
     s->KKT = form_KKT(P->csc,A->csc,
                       1,  //format = 1 means CSR
                       sigma, s->rho_inv_vec, sigma,
-                      OSQP_NULL, OSQP_NULL, OSQP_NULL);
+                      s->PtoKKT, s->AtoKKT, OSQP_NULL);
   }
   else { // Called from ADMM algorithm
 
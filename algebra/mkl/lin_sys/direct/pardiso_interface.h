@@ -35,6 +35,10 @@ struct pardiso {
 
     void (*free)(struct pardiso* self);
 
+    OSQPInt (*solve_multi)(struct pardiso* self,
+                           OSQPVectorf*    b,
+                           OSQPInt         k);
+
     OSQPInt (*update_matrices)(struct pardiso*   self,
                                const OSQPMatrix* P,
                                const OSQPInt*    Px_new_idx,
@@ -48,6 +52,8 @@ struct pardiso {
                               OSQPFloat          rho_sc);
 
     OSQPInt nthreads;
+
+    OSQPFloat memory;
     /** @} */
 
 
@@ -3,38 +3,11 @@
 #include "reduced_kkt.h"
 #include "mkl-cg_interface.h"
 #include "util.h"
+#include "printing.h"
 #include <mkl_rci.h>
 
 #include "profilers.h"
 
-OSQPFloat cg_compute_tolerance(OSQPInt    admm_iter,
-                               OSQPFloat  rhs_norm,
-                               OSQPFloat  scaled_prim_res,
-                               OSQPFloat  scaled_dual_res,
-                               OSQPFloat  reduction_factor,
-                               OSQPFloat* eps_prev) {
-
-  OSQPFloat eps = 1.0;
-
-  if (admm_iter == 1) {
-    // In case rhs = 0.0 we don't want to set eps_prev to 0.0
-    if (rhs_norm < OSQP_CG_TOL_MIN)
-      *eps_prev = 1.0;
-    else
-      *eps_prev = rhs_norm * reduction_factor;
-
-    // Return early since scaled_prim_res and scaled_dual_res are meaningless before the first ADMM iteration
-    return *eps_prev;
-  }
-
-  eps = reduction_factor * sqrt(scaled_prim_res * scaled_dual_res);
-  eps = c_max(c_min(eps, (*eps_prev)), OSQP_CG_TOL_MIN);
-  *eps_prev = eps;
-
-  return eps;
-}
-
-
 MKL_INT cg_solver_init(mklcg_solver* s) {
 
   MKL_INT mkln = s->n;
@@ -64,9 +37,20 @@ MKL_INT cg_solver_init(mklcg_solver* s) {
 }
 
 
+/* Preconditioner in use: the requested one, or the diagonal preconditioner if
+ * its factorization failed for the current matrices and rho */
+static osqp_precond_type cg_active_precond(const mklcg_solver* s) {
+
+  if (s->precond_type == s->precond_failed)
+    return OSQP_DIAGONAL_PRECONDITIONER;
+
+  return s->precond_type;
+}
+
+
 void cg_update_precond(mklcg_solver* s) {
 
-  switch(s->precond_type) {
+  switch(cg_active_precond(s)) {
   /* No preconditioner, just initialize the inverse vector to all 1s */
   case OSQP_NO_PRECONDITIONER:
     OSQPVectorf_set_scalar(s->precond, 1.0);
@@ -76,6 +60,44 @@ void cg_update_precond(mklcg_solver* s) {
   case OSQP_DIAGONAL_PRECONDITIONER:
     reduced_kkt_diagonal(s->P, s->A, s->rho_vec, s->sigma, s->precond, s->precond_inv);
     break;
+
+  /* Factored preconditioners, recomputed before the next solve */
+  case OSQP_IC0_PRECONDITIONER:
+  case OSQP_BLOCK_JACOBI_PRECONDITIONER:
+    s->precond_dirty = 1;
+    break;
+  }
+}
+
+
+static void cg_factor_precond(mklcg_solver* s) {
+
+  OSQPInt    exitflag = 1;
+  OSQPFloat* rho      = OSQPVectorf_data(s->rho_vec);
+
+  s->precond_dirty = 0;
+
+  if (s->precond_type == OSQP_IC0_PRECONDITIONER) {
+    if (!s->ic0)
+      s->ic0 = ic0_new(s->P->csc, s->A->csc);
+
+    if (s->ic0)
+      exitflag = ic0_factor(s->ic0, s->P->csc, s->A->csc, s->sigma, rho);
+  } else if (s->precond_type == OSQP_BLOCK_JACOBI_PRECONDITIONER) {
+    if (!s->bjac)
+      s->bjac = block_jacobi_new(s->P->csc, s->A->csc, s->block_size);
+
+    if (s->bjac)
+      exitflag = block_jacobi_factor(s->bjac, s->P->csc, s->A->csc, s->sigma, rho);
+  } else {
+    return;
+  }
+
+  // Not retried before P, A or rho change
+  if (exitflag) {
+    c_eprint("Preconditioner factorization failed, using the diagonal preconditioner");
+    s->precond_failed = s->precond_type;
+    cg_update_precond(s);
   }
 }
 
@@ -121,6 +143,7 @@ OSQPInt init_linsys_mklcg(mklcg_solver**     sp,
   s->solve           = &solve_linsys_mklcg;
   s->warm_start      = &warm_start_linys_mklcg;
   s->free            = &free_linsys_mklcg;
+  s->solve_multi     = OSQP_NULL;
   s->update_matrices = &update_matrices_linsys_mklcg;
   s->update_rho_vec  = &update_rho_linsys_mklcg;
   s->update_settings = &update_settings_linsys_solver_mklcg;
@@ -129,7 +152,9 @@ OSQPInt init_linsys_mklcg(mklcg_solver**     sp,
   s->type = OSQP_INDIRECT_SOLVER;
 
   // Assign preconditioner
-  s->precond_type = settings->cg_precond;
+  s->precond_type   = settings->cg_precond;
+  s->precond_failed = OSQP_NO_PRECONDITIONER;
+  s->block_size     = settings->cg_block_size;
 
   // Assign iteration limit
   s->max_iter = settings->cg_max_iter;
@@ -143,6 +168,11 @@ OSQPInt init_linsys_mklcg(mklcg_solver**     sp,
   //Don't know the thread count.  Just use
   //the same thing as the pardiso solver
   s->nthreads = mkl_get_max_threads();
+  s->memory   = 0;
+
+  s->ic0           = OSQP_NULL;
+  s->bjac          = OSQP_NULL;
+  s->precond_dirty = 0;
 
   //Initialise solver state to zero since it provides
   //cold start condition for the CG inner solver
@@ -190,6 +220,10 @@ const char* name_mklcg(mklcg_solver* s) {
     return "MKL RCI Conjugate Gradient - No preconditioner";
   case OSQP_DIAGONAL_PRECONDITIONER:
     return "MKL RCI Conjugate Gradient - Diagonal preconditioner";
+  case OSQP_IC0_PRECONDITIONER:
+    return "MKL RCI Conjugate Gradient - Incomplete Cholesky preconditioner";
+  case OSQP_BLOCK_JACOBI_PRECONDITIONER:
+    return "MKL RCI Conjugate Gradient - Block-Jacobi preconditioner";
   }
 
   return "MKL RCI Conjugate Gradient - Unknown preconditioner";
@@ -216,6 +250,10 @@ OSQPInt solve_linsys_mklcg(mklcg_solver* s,
   reduced_kkt_compute_rhs(s->A, s->rho_vec, s->r1, s->r2, s->ywork);
   rhs_norm = OSQPVectorf_norm_inf(s->r1);
 
+  // Refresh the factored preconditioners after rho or matrix updates
+  if (s->precond_dirty)
+    cg_factor_precond(s);
+
   // Compute the desired solution precision
   if (s->polish) {
     eps = c_max(rhs_norm * OSQP_CG_POLISH_TOL, OSQP_CG_TOL_MIN);
@@ -261,8 +299,18 @@ OSQPInt solve_linsys_mklcg(mklcg_solver* s,
       if (res_norm < eps)
         break;
     } else if (rci_request == 3) {
-      // Apply the preconditioner as (precond_post = precond.*precond_pre)
-      OSQPVectorf_ew_prod(s->precond_post, s->precond_inv, s->precond_pre);
+      if (cg_active_precond(s) == OSQP_IC0_PRECONDITIONER) {
+        // Apply the preconditioner as (precond_post = (U'*U) \ precond_pre)
+        OSQPVectorf_copy(s->precond_post, s->precond_pre);
+        ic0_solve(s->ic0, OSQPVectorf_data(s->precond_post));
+      } else if (cg_active_precond(s) == OSQP_BLOCK_JACOBI_PRECONDITIONER) {
+        // Apply the factored diagonal blocks
+        OSQPVectorf_copy(s->precond_post, s->precond_pre);
+        block_jacobi_solve(s->bjac, OSQPVectorf_data(s->precond_post));
+      } else {
+        // Apply the preconditioner as (precond_post = precond.*precond_pre)
+        OSQPVectorf_ew_prod(s->precond_post, s->precond_inv, s->precond_pre);
+      }
     } else {
       break;
     }
@@ -301,6 +349,16 @@ void update_settings_linsys_solver_mklcg(struct mklcg_solver_* s,
   MKL_INT mkln = s->n;
   MKL_INT rci_request = 1;
 
+  // New block partition requested
+  if (s->block_size != settings->cg_block_size) {
+    s->block_size = settings->cg_block_size;
+    block_jacobi_free(s->bjac);
+    s->bjac = OSQP_NULL;
+
+    if (cg_active_precond(s) == OSQP_BLOCK_JACOBI_PRECONDITIONER)
+      s->precond_dirty = 1;
+  }
+
   // New precoditioner type requested
   if (s->precond_type != settings->cg_precond) {
     s->precond_type = settings->cg_precond;
@@ -355,6 +413,7 @@ OSQPInt update_matrices_linsys_mklcg(mklcg_solver*     s,
   OSQP_UnusedVar(A_new_n);
 
   // Update the preconditioner (matrix-only update)
+  s->precond_failed = OSQP_NO_PRECONDITIONER;
   cg_update_precond(s);
 
   return 0;
@@ -367,6 +426,7 @@ OSQPInt update_rho_linsys_mklcg(mklcg_solver*    s,
   OSQPVectorf_copy(s->rho_vec, rho_vec);
 
   // Update the preconditioner (rho-only update)
+  s->precond_failed = OSQP_NO_PRECONDITIONER;
   cg_update_precond(s);
 
   return 0;
@@ -388,6 +448,8 @@ void free_linsys_mklcg(mklcg_solver* s) {
     OSQPVectorf_view_free(s->mvm_post);
     OSQPVectorf_view_free(s->precond_pre);
     OSQPVectorf_view_free(s->precond_post);
+    ic0_free(s->ic0);
+    block_jacobi_free(s->bjac);
   }
   c_free(s);
 }
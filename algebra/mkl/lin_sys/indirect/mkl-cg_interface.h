@@ -4,6 +4,8 @@
 
 #include "osqp.h"
 #include "types.h"    //OSQPMatrix and OSQPVector[fi] types
+#include "ic0.h"
+#include "block_jacobi.h"
 #include <mkl_rci.h>  //MKL_INT
 
 
@@ -21,6 +23,7 @@ typedef struct mklcg_solver_ {
   void    (*warm_start)(struct mklcg_solver_* self, const OSQPVectorf* x);
   OSQPInt (*adjoint_derivative)(struct mklcg_solver_* self);
   void    (*free)(struct mklcg_solver_* self);
+  OSQPInt (*solve_multi)(struct mklcg_solver_* self, OSQPVectorf* b, OSQPInt k);
   OSQPInt (*update_matrices)(struct mklcg_solver_* self,
                              const  OSQPMatrix*    P,
                              const  OSQPInt*       Px_new_idx,
@@ -35,6 +38,9 @@ typedef struct mklcg_solver_ {
   //threads count
   OSQPInt nthreads;
 
+  // Memory usage (not reported)
+  OSQPFloat memory;
+
   // Maximum number of iterations
   OSQPInt max_iter;
 
@@ -52,7 +58,9 @@ typedef struct mklcg_solver_ {
   OSQPInt      n;               // Number of variables
   OSQPInt      polish;          // Polishing or not?
 
-  osqp_precond_type precond_type; // Preconditioner to use
+  osqp_precond_type precond_type;   // Preconditioner to use
+  osqp_precond_type precond_failed; // Preconditioner whose factorization failed for the current P, A and rho
+  OSQPInt           block_size;   // Block size of the block-Jacobi preconditioner (0 = automatic)
 
   // Adaptable termination variables
   OSQPFloat eps_prev;   // Tolerance for previous ADMM iteration
@@ -95,6 +103,11 @@ typedef struct mklcg_solver_ {
   // Preconditioner vector
   OSQPVectorf* precond;
   OSQPVectorf* precond_inv;
+
+  // Factored preconditioners (computed lazily before a solve)
+  ic0_precond*          ic0;
+  block_jacobi_precond* bjac;
+  OSQPInt               precond_dirty;
 } mklcg_solver;
 
 
@@ -4,6 +4,7 @@
 #include "csc_math.h"
 #include "csc_utils.h"
 #include "printing.h"
+#include "util.h"
 
 #include "blas_helpers.h"
 
@@ -52,6 +53,19 @@ static void mkl_csc_spfree(OSQPCscMatrix* M) {
   }
 }
 
+//Matrix-free operators are not supported by the MKL algebra
+OSQPMatrix* OSQPMatrix_new_from_operator(const OSQPOperator* op,
+                                               OSQPInt       is_triu) {
+  OSQP_UnusedVar(op);
+  OSQP_UnusedVar(is_triu);
+  return OSQP_NULL;
+}
+
+OSQPInt OSQPMatrix_is_operator(const OSQPMatrix* M) {
+  OSQP_UnusedVar(M);
+  return 0;
+}
+
 //Make a copy from a csc matrix.  Returns OSQP_NULL on failure
 OSQPMatrix* OSQPMatrix_new_from_csc(const OSQPCscMatrix* A,
                                           OSQPInt        is_triu) {
@@ -0,0 +1,137 @@
+#include "osqp.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+#ifdef OSQP_ENABLE_OPENMP
+# include <omp.h>
+#endif
+
+/*
+ * Thread scaling of the conjugate gradient methods of the built-in indirect
+ * solver. A random sparse QP is solved with a fixed number of ADMM iterations
+ * for 1, 2, 4, ..., 64 threads with the standard and the pipelined method.
+ *
+ * Usage: osqp_cg_bench [n] [max_threads]
+ *
+ * Threads are only used when the library is built with OSQP_ENABLE_OPENMP,
+ * otherwise a single thread count is measured.
+ */
+
+static OSQPInt bench_seed = 1;
+
+/* Uniform random number in [0, 1) from a linear congruential generator */
+static OSQPFloat bench_rand(void) {
+  bench_seed = (1103515245 * bench_seed + 12345) % 2147483648LL;
+  return (OSQPFloat)bench_seed / 2147483648.0;
+}
+
+int main(int argc, char** argv) {
+
+  OSQPInt n       = (argc > 1) ? atol(argv[1]) : 20000;
+  OSQPInt threads = (argc > 2) ? atol(argv[2]) : 64;
+  OSQPInt m       = n + n / 2;
+  OSQPInt A_nnz   = 2 * n;
+  OSQPInt i, j, k, t, meth;
+
+  const osqp_cg_method_type methods[2] = { OSQP_CG_STANDARD, OSQP_CG_PIPELINED };
+  const char*               names[2]   = { "standard", "pipelined" };
+
+  OSQPSolver*    solver   = NULL;
+  OSQPSettings*  settings = malloc(sizeof(OSQPSettings));
+  OSQPCscMatrix* P        = malloc(sizeof(OSQPCscMatrix));
+  OSQPCscMatrix* A        = malloc(sizeof(OSQPCscMatrix));
+
+  /* P = tridiagonal (upper part), A = [I; random rows] */
+  OSQPFloat* P_x = malloc((2 * n) * sizeof(OSQPFloat));
+  OSQPInt*   P_i = malloc((2 * n) * sizeof(OSQPInt));
+  OSQPInt*   P_p = malloc((n + 1) * sizeof(OSQPInt));
+  OSQPFloat* A_x = malloc(A_nnz * sizeof(OSQPFloat));
+  OSQPInt*   A_i = malloc(A_nnz * sizeof(OSQPInt));
+  OSQPInt*   A_p = malloc((n + 1) * sizeof(OSQPInt));
+  OSQPFloat* q   = malloc(n * sizeof(OSQPFloat));
+  OSQPFloat* l   = malloc(m * sizeof(OSQPFloat));
+  OSQPFloat* u   = malloc(m * sizeof(OSQPFloat));
+
+  OSQPInt exitflag = 0;
+
+  if (!settings || !P || !A || !P_x || !P_i || !P_p || !A_x || !A_i || !A_p ||
+      !q || !l || !u) {
+    printf("Out of memory\n");
+    return 1;
+  }
+
+  k = 0;
+  for (j = 0; j < n; j++) {
+    P_p[j] = k;
+    if (j > 0) {
+      P_i[k]   = j - 1;
+      P_x[k++] = -1.0 + 0.5 * bench_rand();
+    }
+    P_i[k]   = j;
+    P_x[k++] = 4.0 + bench_rand();
+    q[j]     = bench_rand() - 0.5;
+  }
+  P_p[n] = k;
+
+  k = 0;
+  for (j = 0; j < n; j++) {
+    A_p[j]   = k;
+    A_i[k]   = j;
+    A_x[k++] = 1.0;
+    A_i[k]   = n + (OSQPInt)(bench_rand() * (m - n));
+    A_x[k++] = bench_rand() - 0.5;
+  }
+  A_p[n] = k;
+
+  for (i = 0; i < m; i++) {
+    l[i] = -1.0;
+    u[i] =  1.0;
+  }
+
+  csc_set_data(P, n, n, P_p[n], P_x, P_i, P_p);
+  csc_set_data(A, m, n, A_nnz, A_x, A_i, A_p);
+
+  osqp_set_default_settings(settings);
+  settings->linsys_solver     = OSQP_INDIRECT_SOLVER;
+  settings->verbose           = 0;
+  settings->polishing         = 0;
+  settings->adaptive_rho      = 0;
+  settings->max_iter          = 100;
+  settings->eps_abs           = 1e-12;
+  settings->eps_rel           = 1e-12;
+  settings->check_termination = 0;
+
+#ifndef OSQP_ENABLE_OPENMP
+  printf("OpenMP is disabled, measuring a single thread\n");
+  threads = 1;
+#endif
+
+  printf("n = %lld, m = %lld, %lld ADMM iterations\n\n",
+         (long long)n, (long long)m, (long long)settings->max_iter);
+  printf("threads     method    solve time [s]\n");
+
+  for (t = 1; t <= threads && !exitflag; t *= 2) {
+#ifdef OSQP_ENABLE_OPENMP
+    omp_set_num_threads((int)t);
+#endif
+
+    for (meth = 0; meth < 2 && !exitflag; meth++) {
+      settings->cg_method = methods[meth];
+
+      exitflag = osqp_setup(&solver, P, q, A, l, u, m, n, settings);
+      if (!exitflag) exitflag = osqp_solve(solver);
+      if (!exitflag)
+        printf("%7lld  %9s  %16.4e\n", (long long)t, names[meth], solver->info->solve_time);
+
+      osqp_cleanup(solver);
+      solver = NULL;
+    }
+  }
+
+  free(P_x); free(P_i); free(P_p);
+  free(A_x); free(A_i); free(A_p);
+  free(q); free(l); free(u);
+  free(P); free(A); free(settings);
+
+  return (int)exitflag;
+}
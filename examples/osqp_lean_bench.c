@@ -0,0 +1,155 @@
+#include "osqp.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+/*
+ * Fixed cost per call of osqp_solve and osqp_solve_lean on a small
+ * MPC-like QP. The problem is solved repeatedly with a drifting linear cost
+ * and warm starting, once with a single ADMM iteration per call (the fixed
+ * overhead dominates) and once until convergence.
+ *
+ * Usage: osqp_lean_bench [n] [calls]
+ */
+
+static OSQPInt bench_seed = 1;
+
+/* Uniform random number in [0, 1) from a linear congruential generator */
+static OSQPFloat bench_rand(void) {
+  bench_seed = (1103515245 * bench_seed + 12345) % 2147483648LL;
+  return (OSQPFloat)bench_seed / 2147483648.0;
+}
+
+/* Average time per call in nanoseconds */
+static double bench_calls(OSQPSolver*   solver,
+                          OSQPSolution* solution,
+                          OSQPFloat*    q,
+                          OSQPInt       n,
+                          OSQPInt       calls,
+                          OSQPInt       lean,
+                          OSQPInt*      iter) {
+  OSQPInt k, j;
+  clock_t start;
+
+  *iter = 0;
+  start = clock();
+  for (k = 0; k < calls; k++) {
+    for (j = 0; j < n; j++) q[j] += (k % 2 ? 1e-3 : -1e-3);
+    osqp_update_data_vec(solver, q, NULL, NULL);
+
+    if (lean)
+      osqp_solve_lean(solver, solution);
+    else
+      osqp_solve(solver);
+    *iter += solver->info->iter;
+  }
+
+  return 1e9 * (double)(clock() - start) / CLOCKS_PER_SEC / (double)calls;
+}
+
+int main(int argc, char** argv) {
+
+  OSQPInt n     = (argc > 1) ? atol(argv[1]) : 10;
+  OSQPInt calls = (argc > 2) ? atol(argv[2]) : 100000;
+  OSQPInt m     = 2 * n;
+  OSQPInt A_nnz = 2 * n;
+  OSQPInt i, j, k, mode, iter;
+  double  t_solve, t_lean;
+
+  const OSQPInt max_iter[2] = { 1, 4000 };
+  const char*   names[2]    = { "1 iteration", "converged" };
+
+  OSQPSolver*    solver   = NULL;
+  OSQPSolution   solution;
+  OSQPSettings*  settings = malloc(sizeof(OSQPSettings));
+  OSQPCscMatrix* P        = malloc(sizeof(OSQPCscMatrix));
+  OSQPCscMatrix* A        = malloc(sizeof(OSQPCscMatrix));
+
+  /* P = tridiagonal (upper part), A = [I; random diagonal] */
+  OSQPFloat* P_x = malloc((2 * n) * sizeof(OSQPFloat));
+  OSQPInt*   P_i = malloc((2 * n) * sizeof(OSQPInt));
+  OSQPInt*   P_p = malloc((n + 1) * sizeof(OSQPInt));
+  OSQPFloat* A_x = malloc(A_nnz * sizeof(OSQPFloat));
+  OSQPInt*   A_i = malloc(A_nnz * sizeof(OSQPInt));
+  OSQPInt*   A_p = malloc((n + 1) * sizeof(OSQPInt));
+  OSQPFloat* q   = malloc(n * sizeof(OSQPFloat));
+  OSQPFloat* l   = malloc(m * sizeof(OSQPFloat));
+  OSQPFloat* u   = malloc(m * sizeof(OSQPFloat));
+
+  OSQPInt exitflag = 0;
+
+  solution.x             = malloc(n * sizeof(OSQPFloat));
+  solution.y             = malloc(m * sizeof(OSQPFloat));
+  solution.prim_inf_cert = malloc(m * sizeof(OSQPFloat));
+  solution.dual_inf_cert = malloc(n * sizeof(OSQPFloat));
+
+  if (!settings || !P || !A || !P_x || !P_i || !P_p || !A_x || !A_i || !A_p ||
+      !q || !l || !u || !solution.x || !solution.y || !solution.prim_inf_cert ||
+      !solution.dual_inf_cert) {
+    printf("Out of memory\n");
+    return 1;
+  }
+
+  k = 0;
+  for (j = 0; j < n; j++) {
+    P_p[j] = k;
+    if (j > 0) {
+      P_i[k]   = j - 1;
+      P_x[k++] = -1.0;
+    }
+    P_i[k]   = j;
+    P_x[k++] = 4.0;
+    q[j]     = bench_rand() - 0.5;
+  }
+  P_p[n] = k;
+
+  k = 0;
+  for (j = 0; j < n; j++) {
+    A_p[j]   = k;
+    A_i[k]   = j;
+    A_x[k++] = 1.0;
+    A_i[k]   = n + j;
+    A_x[k++] = bench_rand() + 0.5;
+  }
+  A_p[n] = k;
+
+  for (i = 0; i < m; i++) {
+    l[i] = -0.1;
+    u[i] =  0.1;
+  }
+
+  csc_set_data(P, n, n, P_p[n], P_x, P_i, P_p);
+  csc_set_data(A, m, n, A_nnz, A_x, A_i, A_p);
+
+  osqp_set_default_settings(settings);
+  settings->verbose               = 0;
+  settings->polishing             = 0;
+  settings->adaptive_rho_interval = 25;
+
+  printf("n = %lld, m = %lld, %lld calls\n\n", (long long)n, (long long)m, (long long)calls);
+  printf("%16s  %17s  %22s  %10s\n", "max_iter", "osqp_solve [ns]", "osqp_solve_lean [ns]", "avg iter");
+
+  for (mode = 0; mode < 2 && !exitflag; mode++) {
+    settings->max_iter = max_iter[mode];
+
+    exitflag = osqp_setup(&solver, P, q, A, l, u, m, n, settings);
+    if (!exitflag) {
+      t_solve = bench_calls(solver, &solution, q, n, calls, 0, &iter);
+      t_lean  = bench_calls(solver, &solution, q, n, calls, 1, &iter);
+      printf("%16s  %17.1f  %22.1f  %10.1f\n", names[mode], t_solve, t_lean,
+             (double)iter / (double)calls);
+    }
+
+    osqp_cleanup(solver);
+    solver = NULL;
+  }
+
+  free(P_x); free(P_i); free(P_p);
+  free(A_x); free(A_i); free(A_p);
+  free(q); free(l); free(u);
+  free(solution.x); free(solution.y);
+  free(solution.prim_inf_cert); free(solution.dual_inf_cert);
+  free(P); free(A); free(settings);
+
+  return (int)exitflag;
+}
@@ -46,6 +46,14 @@ OSQPMatrix* OSQPMatrix_triu_to_symm(const OSQPMatrix* A);
 // Vertically stack two matrices
 OSQPMatrix* OSQPMatrix_vstack(const OSQPMatrix* A, const OSQPMatrix* B);
 
+//Wrap a matrix-free operator (the callbacks are not copied).
+//Returns OSQP_NULL on failure or if the algebra has no operator support
+OSQPMatrix* OSQPMatrix_new_from_operator(const OSQPOperator* op,
+                                               OSQPInt       is_triu);
+
+/* Is the matrix only available through a matrix-free operator? */
+OSQPInt OSQPMatrix_is_operator(const OSQPMatrix* M);
+
 #endif //OSQP_EMBEDDED_MODE
 
 
@@ -0,0 +1,70 @@
+/* Anderson acceleration of the ADMM fixed-point iteration */
+#ifndef ANDERSON_H
+#define ANDERSON_H
+
+
+#include "osqp.h"
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Allocate the Anderson acceleration memory
+ *
+ * @param  mem  Memory depth (number of stored differences)
+ * @param  n    Number of variables
+ * @param  m    Number of constraints
+ * @return      Anderson structure (OSQP_NULL if out of memory)
+ */
+OSQPAnderson* anderson_new(OSQPInt mem,
+                           OSQPInt n,
+                           OSQPInt m);
+
+/**
+ * Forget all stored differences, e.g. after rho changed the fixed-point map
+ *
+ * @param aa  Anderson structure
+ */
+void anderson_reset(OSQPAnderson* aa);
+
+/**
+ * Form the z block of the fixed-point residual z - z_prev right after the
+ * ADMM step, before the residual computations reuse z_prev as workspace
+ *
+ * @param aa    Anderson structure
+ * @param work  OSQP workspace
+ */
+void anderson_residual(OSQPAnderson*  aa,
+                       OSQPWorkspace* work);
+
+/**
+ * Type-II Anderson step after an ADMM iteration
+ *
+ * The ADMM step computed g(s) = (x, z, y) from s = (x_prev, z_prev,
+ * y - delta_y), with the fixed-point residual g(s) - s stored in delta_x,
+ * the result of anderson_residual and delta_y. The step is recorded in
+ * memory and (x, z, y) is replaced by
+ * the extrapolation g(s) - dG*gamma, where gamma minimizes
+ * ||(g(s) - s) - dF*gamma|| in the norm weighted by sigma, rho and 1/rho.
+ * Unless the previous extrapolation lowered that residual below the one of
+ * the plain ADMM step taken before it, the iterate falls back to that step,
+ * the newest difference is dropped and the next step is not extrapolated.
+ *
+ * @param solver  OSQP solver
+ */
+void anderson_step(OSQPSolver* solver);
+
+/**
+ * Free the Anderson structure
+ *
+ * @param aa  Anderson structure
+ */
+void anderson_free(OSQPAnderson* aa);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ifndef ANDERSON_H */
@@ -143,6 +143,10 @@ void update_status(OSQPInfo* info,
  * If the boolean flag is ON, it checks for approximate conditions (10 x larger
  * tolerances than the ones set)
  *
+ * The infeasibility criteria are evaluated only at the checks scheduled by
+ * check_infeasibility and infeasibility_stall, and at every approximate check
+ * unless check_infeasibility is 0.
+ *
  * @param  solver      Solver
  * @param  approximate Boolean
  * @return             Residuals check
@@ -151,6 +155,64 @@ OSQPInt check_termination(OSQPSolver* solver,
                           OSQPInt     approximate);
 
 
+# ifndef OSQP_EMBEDDED_MODE
+
+/**
+ * Check if the residuals in the information meet the termination tolerances,
+ * without infeasibility checks and without changing the status
+ *
+ * @param  solver Solver
+ * @return        Residuals check
+ */
+OSQPInt check_solved(OSQPSolver* solver);
+
+# endif /* ifndef OSQP_EMBEDDED_MODE */
+
+
+# if OSQP_EMBEDDED_MODE != 1
+
+/**
+ * Number of iterations until the next termination check when
+ * adaptive_termination is enabled
+ *
+ * The convergence rate of the residuals is estimated from the distances to the
+ * tolerances at this and the previous check, and the next check is scheduled
+ * where the distance is predicted to drop below one. The interval is kept
+ * between OSQP_CHECK_TERMINATION_MIN and check_termination.
+ *
+ * @param  solver  Solver
+ * @param  iter    Current iteration, just checked by check_termination
+ * @return         Interval to the next check
+ */
+OSQPInt termination_check_interval(OSQPSolver* solver,
+                                   OSQPInt     iter);
+
+# endif /* if OSQP_EMBEDDED_MODE != 1 */
+
+# ifdef OSQP_ENABLE_PROFILING
+
+/**
+ * Number of iterations until the timer is read again in osqp_solve
+ *
+ * Reading the timer is a noticeable part of an iteration on small problems,
+ * so it is only read when the next deadline (time_limit or the end of the
+ * automatic adaptive_rho_interval measurement) could have been reached. The
+ * interval is half the number of iterations that fit in the time left at the
+ * average iteration cost so far, and at most the number of iterations so far,
+ * so the reads become more frequent as the deadline approaches.
+ *
+ * @param  solve_time  Time since the start of the solve
+ * @param  iter        Current iteration
+ * @param  time_left   Time until the next deadline
+ * @return             Interval to the next read
+ */
+OSQPInt time_check_interval(OSQPFloat solve_time,
+                            OSQPInt   iter,
+                            OSQPFloat time_left);
+
+# endif /* ifdef OSQP_ENABLE_PROFILING */
+
+
 # ifndef OSQP_EMBEDDED_MODE
 
 /**
@@ -172,6 +234,25 @@ OSQPInt validate_data(const OSQPCscMatrix* P,
                             OSQPInt        m,
                             OSQPInt        n);
 
+/**
+ * Validate problem data given with operators
+ * @param  P  Problem data (quadratic cost operator)
+ * @param  q  Problem data (linear cost term)
+ * @param  A  Problem data (constraint operator)
+ * @param  l  Problem data (constraint lower bound)
+ * @param  u  Problem data (constraint upper bound)
+ * @param  m  Problem data (number of constraints)
+ * @param  n  Problem data (number of variables)
+ * @return    Exitflag to check
+ */
+OSQPInt validate_operator_data(const OSQPOperator* P,
+                               const OSQPFloat*    q,
+                               const OSQPOperator* A,
+                               const OSQPFloat*    l,
+                               const OSQPFloat*    u,
+                                     OSQPInt       m,
+                                     OSQPInt       n);
+
 # endif /* ifndef OSQP_EMBEDDED_MODE */
 
 
@@ -58,9 +58,11 @@ extern "C" {
 #  ifndef OSQP_USE_FLOAT // Doubles
 #   define c_sqrt sqrt
 #   define c_fmod fmod
+#   define c_log  log
 #  else          // Floats
 #   define c_sqrt sqrtf
 #   define c_fmod fmodf
+#   define c_log  logf
 #  endif /* ifndef OSQP_USE_FLOAT */
 
 # endif // end OSQP_EMBEDDED_MODE
@@ -0,0 +1,63 @@
+/* Nesterov momentum of the ADMM iteration with adaptive restart */
+#ifndef NESTEROV_H
+#define NESTEROV_H
+
+
+#include "osqp.h"
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Allocate the momentum state
+ *
+ * @param  n  Number of variables
+ * @param  m  Number of constraints
+ * @return    Nesterov structure (OSQP_NULL if out of memory)
+ */
+OSQPNesterov* nesterov_new(OSQPInt n,
+                           OSQPInt m);
+
+/**
+ * Restart the momentum sequence, e.g. after rho changed the fixed-point map
+ *
+ * @param nest  Nesterov structure
+ */
+void nesterov_reset(OSQPNesterov* nest);
+
+/**
+ * Store the combined residual sqrt(||delta_y||^2/rho + rho*||z - z_prev||^2)
+ * right after the ADMM step, before the residual computations reuse z_prev
+ * as workspace
+ *
+ * @param solver  OSQP solver
+ */
+void nesterov_residual(OSQPSolver* solver);
+
+/**
+ * Momentum step after an ADMM iteration
+ *
+ * The ADMM output g_k = (x, z, y) is replaced by g_k + beta_k*(g_k - g_{k-1})
+ * with beta_k = (a_k - 1)/a_{k+1} and a_{k+1} = (1 + sqrt(1 + 4*a_k^2))/2.
+ * If the combined residual did not decrease sufficiently, the momentum is
+ * restarted and the iteration continues from the last ADMM output computed
+ * without momentum.
+ *
+ * @param solver  OSQP solver
+ */
+void nesterov_step(OSQPSolver* solver);
+
+/**
+ * Free the Nesterov structure
+ *
+ * @param nest  Nesterov structure
+ */
+void nesterov_free(OSQPNesterov* nest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ifndef NESTEROV_H */
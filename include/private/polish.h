@@ -18,6 +18,48 @@ extern "C" {
  */
 OSQPInt polish(OSQPSolver* solver);
 
+/**
+ * Free the polishing workspace
+ * @param  ws Polishing workspace
+ */
+void polish_scratch_free(OSQPPolishScratch* ws);
+
+/**
+ * Prepare the speculative polishing for a new solve
+ *
+ * Allocates the state on the first call and forgets the active sets guessed
+ * during the previous solve.
+ * @param  solver OSQP solver
+ * @return        Exitflag
+ */
+OSQPInt polish_speculative_init(OSQPSolver* solver);
+
+/**
+ * Speculative polishing at a termination check that did not stop the ADMM
+ *
+ * Tracks the active set guessed from the current iterate. Once the guess did
+ * not change for settings->polish_speculative checks, the polish of a copy of
+ * the iterate is started as an OpenMP task, so that it runs while the ADMM
+ * continues (and at once without OpenMP). If a finished polish met the
+ * termination tolerances, its solution becomes the current iterate and the
+ * status is set to OSQP_SOLVED.
+ * @param  solver OSQP solver
+ * @return        1 if the ADMM can stop with the polished solution, 0 otherwise
+ */
+OSQPInt polish_speculative(OSQPSolver* solver);
+
+/**
+ * Wait for a running speculative polish and drop its result
+ * @param  solver OSQP solver
+ */
+void polish_speculative_wait(OSQPSolver* solver);
+
+/**
+ * Free the speculative polishing state
+ * @param  spec Speculative polishing state
+ */
+void polish_speculative_free(OSQPPolishSpec* spec);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,64 @@
+/* Warm start prediction for sequences of solves with changing q, l and u */
+#ifndef PREDICT_H
+#define PREDICT_H
+
+
+#include "osqp.h"
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Allocate the prediction state
+ *
+ * @param  n  Number of variables
+ * @param  m  Number of constraints
+ * @return    Prediction structure (OSQP_NULL if out of memory)
+ */
+OSQPPredict* predict_new(OSQPInt n,
+                         OSQPInt m);
+
+/**
+ * Forget the stored solutions, e.g. after P or A changed
+ *
+ * @param pred  Prediction structure (may be OSQP_NULL)
+ */
+void predict_reset(OSQPPredict* pred);
+
+/**
+ * Set the start of a warm-started solve
+ *
+ * With two stored solutions s_1, s_2 of the data vectors p_1, p_2 = (q, l, u),
+ * the new data p is projected on the last change, t = <p - p_2, p_2 - p_1> /
+ * ||p_2 - p_1||^2, and the start s_2 + t*(s_2 - s_1) is taken if its initial
+ * residual max(||Ax - z||, ||Px + q + A'y||) is not larger than the one of
+ * the iterate of the previous solve. The outcome and the estimated number of
+ * iterations saved are stored in the solver information. Nothing is done if
+ * the start of the current solve was already set.
+ *
+ * @param solver  OSQP solver
+ */
+void predict_start(OSQPSolver* solver);
+
+/**
+ * Store the solution of the current solve, if it was solved, together with
+ * its data vectors and the residual reduction per iteration
+ *
+ * @param solver  OSQP solver
+ */
+void predict_record(OSQPSolver* solver);
+
+/**
+ * Free the prediction structure
+ *
+ * @param pred  Prediction structure
+ */
+void predict_free(OSQPPredict* pred);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ifndef PREDICT_H */
@@ -0,0 +1,101 @@
+/* Race of ADMM replicas with different initial rho */
+#ifndef RACE_H
+#define RACE_H
+
+
+#include "osqp.h"
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Prepare a race among settings->rho_racing solvers for the next solve
+ *
+ * The main solver takes part with its current rho. The replicas share the
+ * scaled problem data with it and keep their own iterates, work vectors and
+ * factorization. Replica k starts from the iterate of the main solver with
+ * rho multiplied (k odd) or divided (k even) by 10^ceil(k/2). The replicas
+ * are allocated on the first race and kept for the next ones.
+ * @param  solver Main solver
+ * @return        Exitflag
+ */
+OSQPInt race_init(OSQPSolver* solver);
+
+/**
+ * Replica k of the prepared race, with its linear system solver factorized at
+ * its rho. Called on the thread that runs the replica.
+ * @param  solver Main solver
+ * @param  k      Index of the replica (1 <= k < settings->rho_racing)
+ * @return        Replica solver (OSQP_NULL on failure or if the race is over)
+ */
+OSQPSolver* race_replica(OSQPSolver* solver,
+                         OSQPInt     k);
+
+/**
+ * Whether another solver already finished the race
+ * @param  work Workspace of the main solver or of a replica
+ * @return      1 if the race is over for this solver, 0 otherwise
+ */
+OSQPInt race_stopped(const OSQPWorkspace* work);
+
+/**
+ * End the part of a solver in the race after its ADMM loop
+ *
+ * A replica finishes the race only if it terminated with a solution or an
+ * infeasibility certificate. The main solver always finishes it, so that the
+ * replicas stop once it is done.
+ * @param  solver Main solver or replica
+ * @return        1 if this is the main solver and a replica finished first
+ */
+OSQPInt race_finish(OSQPSolver* solver);
+
+/**
+ * Continue the main solver from the replica that won the race
+ *
+ * The iterate, the infeasibility certificates, the residuals and the status
+ * of the winner are copied, and its rho becomes the rho of the main solver
+ * (with a refactorization), so that later solves start from it.
+ * @param  solver Main solver
+ * @return        Exitflag
+ */
+OSQPInt race_adopt(OSQPSolver* solver);
+
+/**
+ * Mark the end of the race, once all replicas returned
+ * @param  work Workspace of the main solver
+ */
+void race_end(OSQPWorkspace* work);
+
+/**
+ * Number of solvers that started the last race, including the main solver
+ * @param  race Race structure (may be OSQP_NULL)
+ * @return      Number of solvers (0 if there was no race)
+ */
+OSQPInt race_started(const OSQPRace* race);
+
+/**
+ * Solver that won the last race
+ * @param  race Race structure (may be OSQP_NULL)
+ * @return      Index of the winner (0 for the main solver, -1 if none)
+ */
+OSQPInt race_winner(const OSQPRace* race);
+
+/**
+ * Drop the factorizations of the replicas, e.g. after P or A changed
+ * @param  race Race structure (may be OSQP_NULL)
+ */
+void race_reset(OSQPRace* race);
+
+/**
+ * Free the replicas
+ * @param  race Race structure (may be OSQP_NULL)
+ */
+void race_free(OSQPRace* race);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ifndef RACE_H */
@@ -26,6 +26,21 @@ typedef struct linsys_solver LinSysSolver;
  */
 typedef struct OSQPTimer_ OSQPTimer;
 
+/**
+ * Workspace of the solution polishing (defined in polish.c)
+ */
+typedef struct OSQPPolishScratch_ OSQPPolishScratch;
+
+/**
+ * State of the speculative polishing (defined in polish.c)
+ */
+typedef struct OSQPPolishSpec_ OSQPPolishSpec;
+
+/**
+ * Rho race among solver replicas (defined in race.c)
+ */
+typedef struct OSQPRace_ OSQPRace;
+
 /**
  * Problem scaling matrices stored as vectors
  */
@@ -48,16 +63,77 @@ typedef struct {
  */
 
 typedef struct {
-  OSQPMatrix*  Ared;          ///< active rows of A; Ared = vstack[Alow, Aupp]
-  OSQPInt      n_active;      ///< number of active constraints
-  OSQPVectori* active_flags;  ///< -1/0/1 to indicate  lower/ inactive / upper active constraints
-  OSQPVectorf* x;             ///< optimal x-solution obtained by polish
-  OSQPVectorf* z;             ///< optimal z-solution obtained by polish
-  OSQPVectorf* y;             ///< optimal y-solution obtained by polish
-  OSQPFloat    obj_val;       ///< objective value at polished solution
-  OSQPFloat    prim_res;      ///< primal residual at polished solution
-  OSQPFloat    dual_res;      ///< dual residual at polished solution
+  OSQPMatrix*        Ared;         ///< active rows of A; Ared = vstack[Alow, Aupp]
+  OSQPInt            n_active;     ///< number of active constraints
+  OSQPVectori*       active_flags; ///< -1/0/1 to indicate  lower/ inactive / upper active constraints
+  OSQPVectori*       Ared_flags;   ///< active_flags that Ared was formed with, kept between solves
+  OSQPInt            data_changed; ///< boolean; P, A or delta changed since Ared was formed
+  LinSysSolver*      plsh;         ///< factorization of the reduced KKT matrix of Ared (OSQP_NULL if none)
+  OSQPPolishScratch* scratch;      ///< workspace allocated on the first polish (OSQP_NULL before)
+  OSQPPolishSpec*    spec;         ///< speculative polishing state (OSQP_NULL if never enabled)
+  OSQPVectorf*       x;            ///< optimal x-solution obtained by polish
+  OSQPVectorf*       z;            ///< optimal z-solution obtained by polish
+  OSQPVectorf*       y;            ///< optimal y-solution obtained by polish
+  OSQPFloat          obj_val;      ///< objective value at polished solution
+  OSQPFloat          prim_res;     ///< primal residual at polished solution
+  OSQPFloat          dual_res;     ///< dual residual at polished solution
 } OSQPPolish;
+
+
+/**
+ * Anderson acceleration of the ADMM iteration
+ *
+ * The fixed-point state s = (x, z, y) is stored in three blocks, so every
+ * difference kept in memory is made of one vector per block.
+ */
+typedef struct {
+  OSQPInt       mem;         ///< memory depth
+  OSQPInt       ncols;       ///< number of stored differences, oldest first
+  OSQPInt       depth;       ///< number of differences kept, lowered from mem after a rejected extrapolation
+  OSQPInt       has_prev;    ///< f_prev and g_prev hold the previous ADMM step
+  OSQPInt       accelerated; ///< the current iterate was extrapolated
+  OSQPInt       rejected;    ///< the last extrapolation was rejected, the next step is plain
+  OSQPFloat     f_norm;      ///< fixed-point residual norm when the last extrapolation was taken
+  OSQPFloat     weight[3];   ///< weights sigma, rho and 1/rho of the x, z and y blocks in the residual norm
+  OSQPVectorf** dF;          ///< differences of fixed-point residuals g(s) - s (3*mem vectors)
+  OSQPVectorf** dG;          ///< differences of ADMM outputs g(s) (3*mem vectors)
+  OSQPVectorf*  f_prev[3];   ///< previous fixed-point residual
+  OSQPVectorf*  g_prev[3];   ///< previous ADMM output
+  OSQPVectorf*  fz;          ///< z block of the current fixed-point residual
+  OSQPFloat*    gram;        ///< dF'*dF (mem x mem, column major)
+  OSQPFloat*    chol;        ///< Cholesky factor of the regularized dF'*dF
+  OSQPFloat*    gamma;       ///< combination coefficients
+} OSQPAnderson;
+
+/**
+ * Nesterov momentum of the ADMM iteration with adaptive restart
+ */
+typedef struct {
+  OSQPInt      has_prev;  ///< whether g_prev holds the previous ADMM output
+  OSQPFloat    a;         ///< momentum sequence a_k, with a_0 = 1
+  OSQPFloat    f_norm;    ///< combined residual that the next iteration has to decrease
+  OSQPFloat    f_new;     ///< combined residual of the current iteration
+  OSQPVectorf* g_prev[3]; ///< previous ADMM output (x, z, y)
+  OSQPVectorf* fz;        ///< workspace for z - z_prev
+} OSQPNesterov;
+
+/**
+ * Warm start prediction from the solutions of the previous solves
+ */
+typedef struct {
+  OSQPInt      nsol;       ///< number of stored solutions (at most 2)
+  OSQPInt      last;       ///< index of the last stored solution
+  OSQPInt      started;    ///< boolean: the start of the current solve is already set
+  OSQPInt      user_start; ///< boolean: the next start was given with osqp_warm_start
+  OSQPInt      iter;       ///< iterations of the last recorded solve
+  OSQPFloat    res_start;  ///< residual at the start of the current solve
+  OSQPFloat    rate;       ///< log of the residual reduction per iteration in the last recorded solve
+  OSQPVectorf* sol[2][3];  ///< stored solutions (x, z, y), scaled
+  OSQPVectorf* par[2][3];  ///< data vectors (q, l, u) of the stored solutions, scaled
+  OSQPVectorf* cand[3];    ///< predicted start (x, z, y)
+  OSQPVectorf* dn[2];      ///< work vectors of size n
+  OSQPVectorf* dm[2];      ///< work vectors of size m
+} OSQPPredict;
 # endif // ifndef OSQP_EMBEDDED_MODE
 
 
@@ -104,6 +180,26 @@ struct OSQPWorkspace_ {
 # ifndef OSQP_EMBEDDED_MODE
   /// Polish structure
   OSQPPolish* pol;
+
+  /// Anderson acceleration (OSQP_NULL if disabled)
+  OSQPAnderson* aa;
+
+  /// Restarted Nesterov momentum (OSQP_NULL if disabled)
+  OSQPNesterov* nest;
+
+  /// Warm start prediction (OSQP_NULL if disabled)
+  OSQPPredict* pred;
+
+  /// Work vectors of the per-constraint rho adaptation (OSQP_NULL if disabled)
+  OSQPVectorf* rho_vec_new;
+  OSQPVectorf* rho_vec_tmp;
+
+  /// Rho race among solver replicas (OSQP_NULL if never enabled)
+  OSQPRace* race;
+  OSQPInt   race_id; ///< index of this solver in the race (0 for the main solver)
+
+  /// boolean; solver of a thread of osqp_solve_batch, which installs the Ctrl-C handler itself
+  OSQPInt batch;
 # endif // ifndef OSQP_EMBEDDED_MODE
 
   /**
@@ -190,6 +286,26 @@ struct OSQPWorkspace_ {
   /// Reciprocal of rho
   OSQPFloat rho_inv;
 
+  /**
+   * @name Termination check schedule (adaptive_termination)
+   * @{
+   */
+  OSQPFloat term_dist;      ///< max(prim_res/eps_prim, dual_res/eps_dual) at the last check
+  OSQPFloat term_dist_prev; ///< term_dist at the check before
+  OSQPInt   term_iter_prev; ///< iteration of the check before (0 if unknown)
+
+  /** @} */
+
+  /**
+   * @name Infeasibility check schedule (check_infeasibility, infeasibility_stall)
+   * @{
+   */
+  OSQPInt   inf_checks_skipped; ///< termination checks since the last infeasibility check
+  OSQPInt   inf_stalled;        ///< consecutive termination checks without progress
+  OSQPFloat inf_dist_prev;      ///< term_dist at the previous termination check
+
+  /** @} */
+
 # ifdef OSQP_ENABLE_PROFILING
   OSQPTimer* timer;       ///< timer object
 
@@ -241,6 +357,10 @@ struct linsys_solver {
   OSQPInt (*adjoint_derivative)(LinSysSolver* self);
 
   void (*free)(LinSysSolver* self);         ///< free linear system solver (only in desktop version)
+
+  OSQPInt (*solve_multi)(LinSysSolver* self,
+                         OSQPVectorf*  b,
+                         OSQPInt       k);  ///< solve for k stacked right-hand sides (OSQP_NULL if not supported)
 # endif // ifndef OSQP_EMBEDDED_MODE
 
 # if OSQP_EMBEDDED_MODE != 1
@@ -258,6 +378,10 @@ struct linsys_solver {
 # endif // if OSQP_EMBEDDED_MODE != 1
 
   OSQPInt nthreads; ///< number of threads active
+
+# ifndef OSQP_EMBEDDED_MODE
+  OSQPFloat memory; ///< memory used by the linear system solver in bytes (0 if not reported)
+# endif // ifndef OSQP_EMBEDDED_MODE
 };
 
 #ifdef __cplusplus
@@ -18,7 +18,8 @@ enum osqp_capabilities_type {
     OSQP_CAPABILITY_INDIRECT_SOLVER = 0x02,    /**<< An indirect linear solver is present in the algebra. */
     OSQP_CAPABILITY_CODEGEN         = 0x04,    /**<< Code generation is present. */
     OSQP_CAPABILITY_UPDATE_MATRICES = 0x08,    /**<< The problem matrices can be updated. */
-    OSQP_CAPABILITY_DERIVATIVES     = 0x10     /**<< Solution derivatives w.r.t P/q/A/l/u are available. */
+    OSQP_CAPABILITY_DERIVATIVES     = 0x10,    /**<< Solution derivatives w.r.t P/q/A/l/u are available. */
+    OSQP_CAPABILITY_MATRIX_FREE     = 0x20     /**<< Problems can be set up with matrix-free operators. */
 };
 
 
@@ -51,6 +52,15 @@ enum osqp_polish_status_type {
     OSQP_POLISH_NO_ACTIVE_SET_FOUND = 2  /* No active set detected, polishing skipped (not an error) */
 };
 
+/********************************
+* Warm Start Prediction Status *
+********************************/
+enum osqp_pred_status_type {
+    OSQP_PRED_REJECTED = -1,     /* Prediction had larger initial residuals than the plain warm start */
+    OSQP_PRED_NOT_PERFORMED = 0,
+    OSQP_PRED_USED = 1
+};
+
 /*************************
 * Linear System Solvers *
 *************************/
@@ -66,8 +76,20 @@ enum osqp_linsys_solver_type {
 typedef enum {
     OSQP_NO_PRECONDITIONER = 0,      /* Don't use a preconditioner */
     OSQP_DIAGONAL_PRECONDITIONER,    /* Diagonal (Jacobi) preconditioner */
+    OSQP_IC0_PRECONDITIONER,         /* Zero-fill incomplete Cholesky preconditioner (CPU only) */
+    OSQP_BLOCK_JACOBI_PRECONDITIONER, /* Block-Jacobi preconditioner (CPU only) */
 } osqp_precond_type;
 
+/**********************************
+* Krylov methods of the CG solver *
+**********************************/
+typedef enum {
+    OSQP_CG_STANDARD = 0,            /* Conjugate gradient on the reduced KKT system */
+    OSQP_CG_MINRES,                  /* MINRES on the full KKT system (built-in algebra only) */
+    OSQP_CG_DEFLATED,                /* Conjugate gradient deflated with a basis recycled across solves (built-in algebra only) */
+    OSQP_CG_PIPELINED,               /* Pipelined conjugate gradient with one reduction per iteration (built-in algebra only) */
+} osqp_cg_method_type;
+
 /******************
 * Solver Errors  *
 ******************/
@@ -95,6 +117,7 @@ extern const char * OSQP_ERROR_MESSAGE[];
 
 # define OSQP_VERBOSE               (1)
 # define OSQP_WARM_STARTING         (1)
+# define OSQP_WARM_START_PREDICT    (0)
 # define OSQP_SCALING               (10)
 # define OSQP_POLISHING             (0)
 
@@ -113,14 +136,20 @@ extern const char * OSQP_ERROR_MESSAGE[];
 #else
 # define OSQP_RHO_IS_VEC            (1)
 #endif
+# define OSQP_ANDERSON_MEM          (0)
+# define OSQP_NESTEROV              (0)
 
 // CG parameters
 # define OSQP_CG_MAX_ITER           (20)
 # define OSQP_CG_TOL_REDUCTION      (10)
 # define OSQP_CG_TOL_FRACTION       (0.15)
+# define OSQP_CG_BLOCK_SIZE         (0)
 
 // adaptive rho logic
 # define OSQP_ADAPTIVE_RHO (1)
+# define OSQP_ADAPTIVE_RHO_VEC (0)
+# define OSQP_RHO_VEC_SPREAD    (1e2)   ///< largest ratio between a per-constraint rho and the rho of its constraint type
+# define OSQP_RHO_VEC_RES_FLOOR (1e-3)  ///< residual components are floored at this fraction of their largest value
 
 #ifdef OSQP_ALGEBRA_CUDA
 #  define OSQP_ADAPTIVE_RHO_INTERVAL  (10)
@@ -133,6 +162,8 @@ extern const char * OSQP_ERROR_MESSAGE[];
 # define OSQP_ADAPTIVE_RHO_FRACTION (0.4)           ///< fraction of setup time after which we update rho
 # define OSQP_ADAPTIVE_RHO_MULTIPLE_TERMINATION (4) ///< multiple of check_termination after which we update rho (if OSQP_ENABLE_PROFILING disabled)
 # define OSQP_ADAPTIVE_RHO_FIXED (100)              ///< number of iterations after which we update rho if termination_check  and OSQP_ENABLE_PROFILING are disabled
+# define OSQP_CHECK_TERMINATION_MIN (5)             ///< shortest interval between termination checks with adaptive_termination
+# define OSQP_INFEASIBILITY_STALL_DECREASE (0.9)    ///< decrease of the distance to the tolerances below which a termination check counts as stalled
 
 // termination parameters
 # define OSQP_MAX_ITER              (4000)
@@ -148,9 +179,16 @@ extern const char * OSQP_ERROR_MESSAGE[];
 #else
 #  define OSQP_CHECK_TERMINATION    (25)
 #endif
+# define OSQP_ADAPTIVE_TERMINATION  (0)
+# define OSQP_CHECK_INFEASIBILITY   (1)
+# define OSQP_INFEASIBILITY_STALL   (0)
 
 #  define OSQP_DELTA                (1E-6)
 #  define OSQP_POLISH_REFINE_ITER   (3)
+#  define OSQP_POLISH_SCHUR         (0)
+#  define OSQP_POLISH_SPECULATIVE   (0)
+
+# define OSQP_RHO_RACING            (0)
 
 
 /*********************************
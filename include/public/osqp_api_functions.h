@@ -90,6 +90,42 @@ OSQP_API OSQPInt osqp_setup(OSQPSolver**         solverp,
                             OSQPInt              n,
                             const OSQPSettings*  settings);
 
+/**
+ * Initialize OSQP solver for a problem whose matrices are only available as operators.
+ *
+ * P and A are given through callbacks computing P*x, A*x and A'*y instead of
+ * CSC matrices. The problem is solved with the indirect linear system solver
+ * and a diagonal preconditioner built from the @c diag fields of the
+ * operators. Since the operators cannot be inspected, the following settings
+ * are ignored: @c linsys_solver (always @c OSQP_INDIRECT_SOLVER), @c scaling
+ * (always 0) and @c polishing (always 0). Since the data is never scaled,
+ * badly scaled operators should be equilibrated by the user. The problem
+ * matrices cannot be updated and code generation and derivatives are not
+ * available.
+ *
+ * Requires the @c OSQP_CAPABILITY_MATRIX_FREE capability.
+ *
+ * @param  solverp   Solver pointer
+ * @param  P         Problem data (quadratic cost term, symmetric operator)
+ * @param  q         Problem data (linear cost term)
+ * @param  A         Problem data (constraint operator)
+ * @param  l         Problem data (constraint lower bound)
+ * @param  u         Problem data (constraint upper bound)
+ * @param  m         Problem data (number of constraints)
+ * @param  n         Problem data (number of variables)
+ * @param  settings  Solver settings
+ * @return           Exitflag for errors (0 if no errors)
+ */
+OSQP_API OSQPInt osqp_setup_operator(OSQPSolver**        solverp,
+                                     const OSQPOperator* P,
+                                     const OSQPFloat*    q,
+                                     const OSQPOperator* A,
+                                     const OSQPFloat*    l,
+                                     const OSQPFloat*    u,
+                                     OSQPInt             m,
+                                     OSQPInt             n,
+                                     const OSQPSettings* settings);
+
 # endif /* ifndef OSQP_EMBEDDED_MODE */
 
 /**
@@ -110,6 +146,31 @@ OSQP_API OSQPInt osqp_setup(OSQPSolver**         solverp,
  */
 OSQP_API OSQPInt osqp_solve(OSQPSolver* solver);
 
+/**
+ * Solve quadratic program with the lowest fixed overhead per call
+ *
+ * Runs the same ADMM iterations as osqp_solve, but for use in fast control
+ * loops it skips everything that costs system calls or allocations:
+ * - no interrupt handler is installed, so Ctrl-C does not stop the solve
+ * - the timer is not read: time_limit is not enforced, solve_time and
+ *   polish_time are set to 0, and an automatic adaptive_rho_interval is
+ *   replaced by a fixed one
+ * - nothing is printed, even if verbose is set
+ * - the solution is not polished
+ *
+ * The final solver information is stored in the  \a solver->info  structure.
+ * The solution and the infeasibility certificates are written into the
+ * caller-allocated vectors of \a solution (skipped if it is OSQP_NULL), and
+ * \a solver->solution is left untouched.
+ *
+ * @param  solver   Solver
+ * @param  solution Solution object with preallocated vectors of the correct
+ *                  lengths to store the result in
+ * @return          Exitflag for errors (0 if no errors)
+ */
+OSQP_API OSQPInt osqp_solve_lean(OSQPSolver*   solver,
+                                 OSQPSolution* solution);
+
 /**
  * Store the optimization problem result from solver \a solver into the solution
  * \a solution. Note that \a solution must already be allocated with the component
@@ -132,6 +193,67 @@ OSQPInt osqp_get_solution(OSQPSolver* solver, OSQPSolution* solution);
  */
 OSQP_API OSQPInt osqp_cleanup(OSQPSolver* solver);
 
+/**
+ * Solve a batch of quadratic programs that share the sparsity pattern of P and A
+ *
+ * The instances are solved on \a nthreads threads, each with its own solver.
+ * The ordering and the symbolic factorization of the KKT system are done once
+ * per thread, when its solver is set up with the first instance of its block;
+ * every further instance only updates the data with osqp_update_data_mat and
+ * osqp_update_data_vec, which refactorizes the KKT matrix numerically, and
+ * solves.
+ *
+ * Each thread solves a contiguous block of instances in order, as a sequence
+ * of updates and solves of one solver. With warm_starting, an instance starts
+ * from the solution of the previous instance of its block, and the rho
+ * adapted on the previous instance is kept. The results are reproducible
+ * for a fixed number of threads. Nothing is printed, and rho_racing and
+ * polish_speculative are ignored.
+ *
+ * The values of instance k are stored at offsets k * nnz(P) in \a Px,
+ * k * nnz(A) in \a Ax, k * n in \a q, and k * m in \a l and \a u.
+ *
+ * @param  nbatch    Number of instances
+ * @param  P         Upper triangular part of the quadratic cost matrix P in csc format (n x n),
+ *                   whose values are used for all instances if \a Px is OSQP_NULL
+ * @param  Px        Values of P of all instances (OSQP_NULL to use P->x)
+ * @param  q         Linear cost vectors of all instances (nbatch * n)
+ * @param  A         Constraints matrix in csc format (m x n), whose values are used for all
+ *                   instances if \a Ax is OSQP_NULL
+ * @param  Ax        Values of A of all instances (OSQP_NULL to use A->x)
+ * @param  l         Lower bound vectors of all instances (nbatch * m)
+ * @param  u         Upper bound vectors of all instances (nbatch * m)
+ * @param  m         Number of constraints
+ * @param  n         Number of variables
+ * @param  settings  Solver settings
+ * @param  nthreads  Number of threads (0 for the OpenMP default, ignored without OpenMP)
+ * @param  solutions Solutions of the instances (nbatch), with preallocated vectors of the
+ *                   correct lengths or OSQP_NULL for the ones not needed; OSQP_NULL if none
+ * @param  infos     Solver information of the instances (nbatch); OSQP_NULL if not needed
+ * @param  exitflags Exitflags of the setup or update and solve of the instances (nbatch);
+ *                   OSQP_NULL if not needed
+ * @return           Exitflag of the first failed instance (0 if no errors). The other
+ *                   instances are still solved. An instance that could not be set up or
+ *                   whose data could not be updated has the status OSQP_UNSOLVED, and a
+ *                   thread whose first instance could not be set up continues with the
+ *                   next instance of its block.
+ */
+OSQP_API OSQPInt osqp_solve_batch(OSQPInt              nbatch,
+                                  const OSQPCscMatrix* P,
+                                  const OSQPFloat*     Px,
+                                  const OSQPFloat*     q,
+                                  const OSQPCscMatrix* A,
+                                  const OSQPFloat*     Ax,
+                                  const OSQPFloat*     l,
+                                  const OSQPFloat*     u,
+                                  OSQPInt              m,
+                                  OSQPInt              n,
+                                  const OSQPSettings*  settings,
+                                  OSQPInt              nthreads,
+                                  OSQPSolution*        solutions,
+                                  OSQPInfo*            infos,
+                                  OSQPInt*             exitflags);
+
 # endif /* ifndef OSQP_EMBEDDED_MODE */
 
 
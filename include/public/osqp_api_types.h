@@ -38,6 +38,31 @@ typedef struct {
   OSQPInt    nz;    ///< number of entries in triplet matrix, -1 for csc
 } OSQPCscMatrix;
 
+/**
+ *  Matrix-free linear operator that can replace a CSC matrix in osqp_setup_operator.
+ *  The operator is only accessed through the callbacks, so the user data must
+ *  remain valid until the solver is cleaned up.
+ */
+typedef struct {
+  OSQPInt m;        ///< number of rows
+  OSQPInt n;        ///< number of columns
+
+  /** Compute y = M*x, with x of length n and y of length m */
+  void (*mult)(void* data, const OSQPFloat* x, OSQPFloat* y);
+
+  /** Compute y = M'*x, with x of length m and y of length n (not used for the symmetric P) */
+  void (*mult_t)(void* data, const OSQPFloat* x, OSQPFloat* y);
+
+  /**
+   * Diagonal information of length n used by the diagonal preconditioner:
+   * the diagonal of P, or the squared 2-norms of the columns of A.
+   * OSQP_NULL if not available.
+   */
+  const OSQPFloat* diag;
+
+  void* data;       ///< user data passed to the callbacks
+} OSQPOperator;
+
 /**
  * User settings
  */
@@ -52,6 +77,7 @@ typedef struct {
   OSQPInt verbose;                            ///< boolean; write out progress
   OSQPInt profiler_level;                     ///< integer; level of detail for profiler annotations
   OSQPInt warm_starting;                      ///< boolean; warm start
+  OSQPInt warm_start_predict;                 ///< boolean; extrapolate the warm start from the last two solutions after a change of q, l or u (cannot be updated)
   OSQPInt scaling;                            ///< data scaling iterations; if 0, then disabled
   OSQPInt polishing;                          ///< boolean; polish ADMM solution
 
@@ -60,18 +86,24 @@ typedef struct {
   OSQPInt   rho_is_vec;             ///< boolean; is rho scalar or vector?
   OSQPFloat sigma;                  ///< ADMM penalty parameter
   OSQPFloat alpha;                  ///< ADMM relaxation parameter
+  OSQPInt   anderson_mem;           ///< memory depth of the Anderson acceleration of ADMM; if 0, then it is disabled (cannot be updated)
+  OSQPInt   nesterov;               ///< boolean; use Nesterov momentum with adaptive restart in ADMM (cannot be updated)
 
   // CG settings
-  OSQPInt           cg_max_iter;      ///< maximum number of CG iterations per solve
-  OSQPInt           cg_tol_reduction; ///< number of consecutive zero CG iterations before the tolerance gets halved
-  OSQPFloat         cg_tol_fraction;  ///< CG tolerance (fraction of ADMM residuals)
-  osqp_precond_type cg_precond;       ///< Preconditioner to use in the CG method
+  OSQPInt             cg_max_iter;      ///< maximum number of CG iterations per solve
+  OSQPInt             cg_tol_reduction; ///< number of consecutive zero CG iterations before the tolerance gets halved
+  OSQPFloat           cg_tol_fraction;  ///< CG tolerance (fraction of ADMM residuals)
+  osqp_precond_type   cg_precond;       ///< Preconditioner to use in the CG method
+  OSQPInt             cg_block_size;    ///< size of the blocks of the block-Jacobi preconditioner; if 0, then they are detected automatically
+  osqp_cg_method_type cg_method;        ///< Krylov method of the built-in indirect solver (cannot be updated)
 
   // adaptive rho logic
   OSQPInt   adaptive_rho;           ///< boolean, is rho step size adaptive?
   OSQPInt   adaptive_rho_interval;  ///< number of iterations between rho adaptations; if 0, then it is timing-based
   OSQPFloat adaptive_rho_fraction;  ///< time interval for adapting rho (fraction of the setup time)
   OSQPFloat adaptive_rho_tolerance; ///< tolerance X for adapting rho; new rho must be X times larger or smaller than the current one to change it
+  OSQPInt   adaptive_rho_vec;       ///< boolean; adapt rho separately for every constraint (cannot be updated)
+  OSQPInt   rho_racing;             ///< number of ADMM replicas with different initial rho raced on parallel threads; if 0 or 1, then there is no race
 
   // TODO: allowing negative values for adaptive_rho_interval can eliminate the need for adaptive_rho
 
@@ -83,11 +115,16 @@ typedef struct {
   OSQPFloat eps_dual_inf;           ///< dual infeasibility tolerance
   OSQPInt   scaled_termination;     ///< boolean; use scaled termination criteria
   OSQPInt   check_termination;      ///< integer, check termination interval; if 0, checking is disabled
+  OSQPInt   adaptive_termination;   ///< boolean; schedule the termination checks from the residual convergence rate, with check_termination as the longest interval
+  OSQPInt   check_infeasibility;    ///< integer, number of termination checks between infeasibility checks; if 0, infeasibility is never checked
+  OSQPInt   infeasibility_stall;    ///< integer, check infeasibility only after this many consecutive termination checks without progress; if 0, at every interval
   OSQPFloat time_limit;             ///< maximum time to solve the problem (seconds)
 
   // polishing parameters
   OSQPFloat delta;                  ///< regularization parameter for polishing
   OSQPInt   polish_refine_iter;     ///< number of iterative refinement steps in polishing
+  OSQPInt   polish_schur;           ///< largest rank of a Schur complement update that polishes on the ADMM factorization; if 0, then the reduced KKT is always factorized
+  OSQPInt   polish_speculative;     ///< number of termination checks with an unchanged active set before polishing while ADMM continues; if 0, then only the ADMM solution is polished
 } OSQPSettings;
 
 
@@ -99,6 +136,7 @@ typedef struct {
   char    status[32];     ///< Status string, e.g. 'solved'
   OSQPInt status_val;     ///< Status as OSQPInt, defined in osqp_api_constants.h
   OSQPInt status_polish;  ///< Polishing status: successful (1), unperformed (0), unsuccessful (-1)
+  OSQPInt status_pred;    ///< Warm start prediction status: used (1), unperformed (0), rejected (-1)
 
   // solution quality
   OSQPFloat obj_val;      ///< Primal objective value
@@ -109,6 +147,7 @@ typedef struct {
   OSQPInt   iter;         ///< Number of iterations taken
   OSQPInt   rho_updates;  ///< Number of rho updates performned
   OSQPFloat rho_estimate; ///< Best rho estimate so far from residuals
+  OSQPFloat pred_iter_saved; ///< Estimated number of iterations saved by the warm start prediction
 
   // timing information
   OSQPFloat setup_time;  ///< Setup phase time (seconds)
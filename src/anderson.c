@@ -0,0 +1,260 @@
+#include "glob_opts.h"
+#include "anderson.h"
+#include "lin_alg.h"
+
+// Relative Tikhonov regularization of the least-squares problem
+#define ANDERSON_REGULARIZATION (1e-10)
+
+
+/* Inner product of two block vectors (x, z, y) in the norm of the ADMM
+ * iteration, which weights the blocks by sigma, rho and 1/rho */
+static OSQPFloat block_dot(const OSQPAnderson* aa,
+                           OSQPVectorf* const* a,
+                           OSQPVectorf* const* b) {
+  return aa->weight[0] * OSQPVectorf_dot_prod(a[0], b[0]) +
+         aa->weight[1] * OSQPVectorf_dot_prod(a[1], b[1]) +
+         aa->weight[2] * OSQPVectorf_dot_prod(a[2], b[2]);
+}
+
+
+/* Drop the oldest stored difference, moving the others one column back */
+static void anderson_drop_oldest(OSQPAnderson* aa) {
+
+  OSQPInt      b, i, j;
+  OSQPInt      ld = aa->mem;
+  OSQPVectorf* tmp;
+
+  for (b = 0; b < 3; b++) {
+    tmp = aa->dF[b];
+    for (j = 0; j < aa->ncols - 1; j++) aa->dF[3*j + b] = aa->dF[3*(j + 1) + b];
+    aa->dF[3*(aa->ncols - 1) + b] = tmp;
+
+    tmp = aa->dG[b];
+    for (j = 0; j < aa->ncols - 1; j++) aa->dG[3*j + b] = aa->dG[3*(j + 1) + b];
+    aa->dG[3*(aa->ncols - 1) + b] = tmp;
+  }
+
+  for (j = 0; j < aa->ncols - 1; j++)
+    for (i = 0; i < aa->ncols - 1; i++)
+      aa->gram[i + j*ld] = aa->gram[(i + 1) + (j + 1)*ld];
+
+  aa->ncols--;
+}
+
+
+OSQPAnderson* anderson_new(OSQPInt mem,
+                           OSQPInt n,
+                           OSQPInt m) {
+
+  OSQPInt b, j;
+  OSQPInt len[3] = { n, m, m };
+
+  OSQPAnderson* aa = c_calloc(1, sizeof(OSQPAnderson));
+  if (!aa) return OSQP_NULL;
+
+  aa->mem   = mem;
+  aa->dF    = c_calloc(3 * mem, sizeof(OSQPVectorf*));
+  aa->dG    = c_calloc(3 * mem, sizeof(OSQPVectorf*));
+  aa->gram  = c_calloc(mem * mem, sizeof(OSQPFloat));
+  aa->chol  = c_calloc(mem * mem, sizeof(OSQPFloat));
+  aa->gamma = c_calloc(mem, sizeof(OSQPFloat));
+  aa->fz    = OSQPVectorf_malloc(m);
+
+  if (!aa->dF || !aa->dG || !aa->gram || !aa->chol || !aa->gamma || !aa->fz) {
+    anderson_free(aa);
+    return OSQP_NULL;
+  }
+
+  for (b = 0; b < 3; b++) {
+    aa->f_prev[b] = OSQPVectorf_malloc(len[b]);
+    aa->g_prev[b] = OSQPVectorf_malloc(len[b]);
+    if (!aa->f_prev[b] || !aa->g_prev[b]) {
+      anderson_free(aa);
+      return OSQP_NULL;
+    }
+
+    for (j = 0; j < mem; j++) {
+      aa->dF[3*j + b] = OSQPVectorf_malloc(len[b]);
+      aa->dG[3*j + b] = OSQPVectorf_malloc(len[b]);
+      if (!aa->dF[3*j + b] || !aa->dG[3*j + b]) {
+        anderson_free(aa);
+        return OSQP_NULL;
+      }
+    }
+  }
+
+  anderson_reset(aa);
+
+  return aa;
+}
+
+
+void anderson_reset(OSQPAnderson* aa) {
+  aa->ncols       = 0;
+  aa->depth       = aa->mem;
+  aa->has_prev    = 0;
+  aa->accelerated = 0;
+  aa->rejected    = 0;
+}
+
+
+/* Solve (dF'*dF + reg*I) gamma = rhs with a dense Cholesky factorization.
+ * Returns 1 if the matrix is not numerically positive definite. */
+static OSQPInt anderson_solve(OSQPAnderson* aa) {
+
+  OSQPInt    i, j, k;
+  OSQPInt    nc  = aa->ncols;
+  OSQPInt    ld  = aa->mem;
+  OSQPFloat* L   = aa->chol;
+  OSQPFloat* g   = aa->gamma;
+  OSQPFloat  reg = 0.0;
+  OSQPFloat  d, s;
+
+  for (i = 0; i < nc; i++) reg = c_max(reg, aa->gram[i + i*ld]);
+  reg *= ANDERSON_REGULARIZATION;
+
+  for (j = 0; j < nc; j++) {
+    d = aa->gram[j + j*ld] + reg;
+    for (k = 0; k < j; k++) d -= L[j + k*ld] * L[j + k*ld];
+
+    if (!(d > 0.0)) return 1;
+    d = c_sqrt(d);
+    L[j + j*ld] = d;
+
+    for (i = j + 1; i < nc; i++) {
+      s = aa->gram[i + j*ld];
+      for (k = 0; k < j; k++) s -= L[i + k*ld] * L[j + k*ld];
+      L[i + j*ld] = s / d;
+    }
+  }
+
+  // L z = rhs, L' gamma = z
+  for (j = 0; j < nc; j++) {
+    g[j] /= L[j + j*ld];
+    for (i = j + 1; i < nc; i++) g[i] -= L[i + j*ld] * g[j];
+  }
+  for (j = nc - 1; j >= 0; j--) {
+    s = g[j];
+    for (i = j + 1; i < nc; i++) s -= L[i + j*ld] * g[i];
+    g[j] = s / L[j + j*ld];
+  }
+
+  return 0;
+}
+
+
+void anderson_residual(OSQPAnderson*  aa,
+                       OSQPWorkspace* work) {
+  OSQPVectorf_minus(aa->fz, work->z, work->z_prev);
+}
+
+
+void anderson_step(OSQPSolver* solver) {
+
+  OSQPInt        b, i, c;
+  OSQPWorkspace* work = solver->work;
+  OSQPAnderson*  aa   = work->aa;
+  OSQPFloat      f_norm;
+
+  // Fixed-point residual f = g(s) - s and ADMM output g(s)
+  OSQPVectorf* f[3] = { work->delta_x, aa->fz, work->delta_y };
+  OSQPVectorf* g[3] = { work->x, work->z, work->y };
+
+  // The memory is cleared whenever rho changes, so the weights are fixed
+  // while differences are stored
+  aa->weight[0] = solver->settings->sigma;
+  aa->weight[1] = solver->settings->rho;
+  aa->weight[2] = 1.0 / solver->settings->rho;
+
+  f_norm = c_sqrt(block_dot(aa, f, f));
+
+  // Safeguard: unless the extrapolated point has a smaller residual than the
+  // plain ADMM step taken before it, go back to that step. The newest
+  // difference produced the extrapolation, so it is dropped, the memory is
+  // kept below that size and the next step is not extrapolated, so that the
+  // same extrapolation is not immediately tried again.
+  if (aa->accelerated && f_norm >= aa->f_norm) {
+    for (b = 0; b < 3; b++) OSQPVectorf_copy(g[b], aa->g_prev[b]);
+    OSQPVectorf_copy(work->delta_x, aa->f_prev[0]);
+    OSQPVectorf_copy(work->delta_y, aa->f_prev[2]);
+
+    aa->ncols--;
+    aa->depth       = c_max(aa->ncols, 1);
+    aa->accelerated = 0;
+    aa->rejected    = 1;
+    return;
+  }
+
+  // Store the differences with the previous step as the newest column
+  if (aa->has_prev) {
+    if (aa->ncols == aa->depth) anderson_drop_oldest(aa);
+
+    c = aa->ncols++;
+    for (b = 0; b < 3; b++) {
+      OSQPVectorf_minus(aa->dF[3*c + b], f[b], aa->f_prev[b]);
+      OSQPVectorf_minus(aa->dG[3*c + b], g[b], aa->g_prev[b]);
+    }
+
+    for (i = 0; i < aa->ncols; i++) {
+      aa->gram[i + c*aa->mem] = block_dot(aa, aa->dF + 3*i, aa->dF + 3*c);
+      aa->gram[c + i*aa->mem] = aa->gram[i + c*aa->mem];
+    }
+  }
+
+  for (b = 0; b < 3; b++) {
+    OSQPVectorf_copy(aa->f_prev[b], f[b]);
+    OSQPVectorf_copy(aa->g_prev[b], g[b]);
+  }
+  aa->has_prev    = 1;
+  aa->accelerated = 0;
+
+  // Plain step after a rejected extrapolation
+  if (aa->rejected) {
+    aa->rejected = 0;
+    return;
+  }
+
+  if (aa->ncols == 0) return;
+
+  // gamma = argmin ||f - dF*gamma||
+  for (i = 0; i < aa->ncols; i++)
+    aa->gamma[i] = block_dot(aa, aa->dF + 3*i, f);
+
+  if (anderson_solve(aa)) return;
+
+  // (x, z, y) = g(s) - dG*gamma
+  for (i = 0; i < aa->ncols; i++)
+    for (b = 0; b < 3; b++)
+      OSQPVectorf_add_scaled(g[b], 1.0, g[b], -aa->gamma[i], aa->dG[3*i + b]);
+
+  aa->accelerated = 1;
+  aa->f_norm      = f_norm;
+
+  // The last extrapolation was accepted, let the memory grow again
+  if (aa->depth < aa->mem) aa->depth++;
+}
+
+
+void anderson_free(OSQPAnderson* aa) {
+
+  OSQPInt b, j;
+
+  if (aa) {
+    for (b = 0; b < 3; b++) {
+      OSQPVectorf_free(aa->f_prev[b]);
+      OSQPVectorf_free(aa->g_prev[b]);
+    }
+    if (aa->dF)
+      for (j = 0; j < 3 * aa->mem; j++) OSQPVectorf_free(aa->dF[j]);
+    if (aa->dG)
+      for (j = 0; j < 3 * aa->mem; j++) OSQPVectorf_free(aa->dG[j]);
+
+    c_free(aa->dF);
+    c_free(aa->dG);
+    c_free(aa->gram);
+    c_free(aa->chol);
+    c_free(aa->gamma);
+    OSQPVectorf_free(aa->fz);
+    c_free(aa);
+  }
+}
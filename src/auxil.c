@@ -46,6 +46,118 @@ OSQPFloat compute_rho_estimate(const OSQPSolver* solver) {
   return rho_estimate;
 }
 
+#ifndef OSQP_EMBEDDED_MODE
+
+/* Componentwise |v| / ||v||_inf, floored at OSQP_RHO_VEC_RES_FLOOR. Since
+ * there is no elementwise absolute value, the square of it is returned. */
+static void normalized_res_sq(OSQPVectorf* v) {
+
+  OSQPFloat v_max;
+
+  OSQPVectorf_ew_prod(v, v, v);
+  v_max = OSQPVectorf_norm_inf(v);
+
+  if (v_max > 0.0) {
+    OSQPVectorf_mult_scalar(v, 1.0 / v_max);
+    OSQPVectorf_set_scalar_if_lt(v, v,
+                                 OSQP_RHO_VEC_RES_FLOOR * OSQP_RHO_VEC_RES_FLOOR,
+                                 OSQP_RHO_VEC_RES_FLOOR * OSQP_RHO_VEC_RES_FLOOR);
+  }
+  else {
+    OSQPVectorf_set_scalar(v, 1.0);
+  }
+}
+
+/* Per-constraint rho adaptation.
+ *
+ * The scalar estimate rho_new moves every rho_vec entry by the same factor,
+ * as in adapt_rho. On top of it, every constraint is weighted by the fourth
+ * root of the ratio between its share of the primal residual (Ax - z)_i and
+ * its share of the dual residual A_i*(Px + q + A'y), both relative to their
+ * largest component. The result is kept within OSQP_RHO_VEC_SPREAD of the
+ * rho of the constraint type, and an entry only changes if it moves by more
+ * than adaptive_rho_tolerance. The KKT matrix is updated only if an entry
+ * changed.
+ *
+ * NB: Must be called right after update_info, while z_prev and x_prev still
+ *     hold the primal and dual residuals. */
+static OSQPInt adapt_rho_vec(OSQPSolver* solver,
+                             OSQPFloat   rho_new) {
+
+  OSQPFloat rho_scale = 1.0;
+  OSQPInt   exitflag  = 0;
+
+  OSQPInfo*      info     = solver->info;
+  OSQPSettings*  settings = solver->settings;
+  OSQPWorkspace* work     = solver->work;
+
+  OSQPVectorf* rho_new_vec = work->rho_vec_new;
+  OSQPVectorf* tmp         = work->rho_vec_tmp;
+
+  if (!work->data->m)
+    return 0;
+
+  if ((rho_new > settings->rho * settings->adaptive_rho_tolerance) ||
+      (rho_new < settings->rho / settings->adaptive_rho_tolerance)) {
+    rho_scale     = rho_new / settings->rho;
+    settings->rho = rho_new;
+  }
+
+  // rho_new_vec = (primal share / dual share)^(1/4), from the squared shares
+  OSQPVectorf_copy(rho_new_vec, work->z_prev);
+  normalized_res_sq(rho_new_vec);
+  OSQPMatrix_Axpy(work->data->A, work->x_prev, tmp, 1.0, 0.0);
+  normalized_res_sq(tmp);
+  OSQPVectorf_ew_reciprocal(tmp, tmp);
+  OSQPVectorf_ew_prod(rho_new_vec, rho_new_vec, tmp);
+  OSQPVectorf_ew_sqrt(rho_new_vec);
+  OSQPVectorf_ew_sqrt(rho_new_vec);
+  OSQPVectorf_ew_sqrt(rho_new_vec);
+
+  // rho_new_vec *= rho_scale * rho_vec
+  OSQPVectorf_ew_prod(rho_new_vec, rho_new_vec, work->rho_vec);
+  OSQPVectorf_mult_scalar(rho_new_vec, rho_scale);
+
+  // Stay close to the rho of the constraint type
+  OSQPVectorf_set_scalar_conditional(tmp, work->constr_type,
+                                     OSQP_RHO_MIN,
+                                     settings->rho / OSQP_RHO_VEC_SPREAD,
+                                     OSQP_RHO_EQ_OVER_RHO_INEQ * settings->rho / OSQP_RHO_VEC_SPREAD);
+  OSQPVectorf_ew_max_vec(rho_new_vec, rho_new_vec, tmp);
+  OSQPVectorf_set_scalar_conditional(tmp, work->constr_type,
+                                     OSQP_RHO_MIN,
+                                     settings->rho * OSQP_RHO_VEC_SPREAD,
+                                     OSQP_RHO_EQ_OVER_RHO_INEQ * settings->rho * OSQP_RHO_VEC_SPREAD);
+  OSQPVectorf_ew_min_vec(rho_new_vec, rho_new_vec, tmp);
+  OSQPVectorf_set_scalar_if_lt(rho_new_vec, rho_new_vec, OSQP_RHO_MIN, OSQP_RHO_MIN);
+  OSQPVectorf_set_scalar_if_gt(rho_new_vec, rho_new_vec, OSQP_RHO_MAX, OSQP_RHO_MAX);
+
+  // tmp = 1 where the change exceeds the tolerance, 0 elsewhere
+  // NB: rho_inv_vec is used as working vector and restored below
+  OSQPVectorf_ew_prod(tmp, rho_new_vec, work->rho_inv_vec);
+  OSQPVectorf_ew_reciprocal(work->rho_inv_vec, tmp);
+  OSQPVectorf_ew_max_vec(tmp, tmp, work->rho_inv_vec);
+  OSQPVectorf_set_scalar_if_lt(tmp, tmp, settings->adaptive_rho_tolerance, 0.0);
+  OSQPVectorf_set_scalar_if_gt(tmp, tmp, 0.0, 1.0);
+
+  // rho_vec += tmp .* (rho_new_vec - rho_vec)
+  OSQPVectorf_minus(rho_new_vec, rho_new_vec, work->rho_vec);
+  OSQPVectorf_ew_prod(rho_new_vec, rho_new_vec, tmp);
+  OSQPVectorf_plus(work->rho_vec, work->rho_vec, rho_new_vec);
+  OSQPVectorf_ew_reciprocal(work->rho_inv_vec, work->rho_vec);
+
+  if (OSQPVectorf_norm_inf(rho_new_vec) > 0.0) {
+    exitflag = work->linsys_solver->update_rho_vec(work->linsys_solver,
+                                                   work->rho_vec,
+                                                   settings->rho);
+    info->rho_updates += 1;
+  }
+
+  return exitflag;
+}
+
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
 OSQPInt adapt_rho(OSQPSolver* solver) {
 
   OSQPInt   exitflag; // Exitflag
@@ -62,6 +174,11 @@ OSQPInt adapt_rho(OSQPSolver* solver) {
   // Set rho estimate in info
   info->rho_estimate = rho_new;
 
+#ifndef OSQP_EMBEDDED_MODE
+  if (settings->adaptive_rho_vec)
+    return adapt_rho_vec(solver, rho_new);
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
   // Check if the new rho is large or small enough and update it in case
   if ((rho_new > settings->rho * settings->adaptive_rho_tolerance) ||
       (rho_new < settings->rho / settings->adaptive_rho_tolerance)) {
@@ -109,9 +226,22 @@ OSQPInt update_rho_vec(OSQPSolver* solver) {
   OSQPInt exitflag = 0;
   OSQPWorkspace* work = solver->work;
 
+#ifndef OSQP_EMBEDDED_MODE
+  // Keep the per-constraint values unless the constraint types change
+  if (work->rho_vec_tmp)
+    OSQPVectorf_copy(work->rho_vec_tmp, work->rho_vec);
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
   //update rho_vec and see if anything changed
   constr_type_changed = set_rho_vec(solver);
 
+#ifndef OSQP_EMBEDDED_MODE
+  if (work->rho_vec_tmp && !constr_type_changed) {
+    OSQPVectorf_copy(work->rho_vec, work->rho_vec_tmp);
+    OSQPVectorf_ew_reciprocal(work->rho_inv_vec, work->rho_vec);
+  }
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
   // Update rho_vec in KKT matrix if constraints type has changed
   if (constr_type_changed == 1) {
     exitflag = work->linsys_solver->update_rho_vec(work->linsys_solver, work->rho_vec, solver->settings->rho);
@@ -733,12 +863,44 @@ void update_status(OSQPInfo* info,
   c_strcpy(info->status, OSQP_STATUS_MESSAGE[status_val]);
 }
 
+/* Whether the infeasibility criteria are evaluated at this termination check.
+ * The approximate check at the end of a solve always evaluates them. */
+static OSQPInt infeasibility_check_due(OSQPSolver* solver,
+                                       OSQPInt     approximate) {
+
+  OSQPSettings*  settings = solver->settings;
+  OSQPWorkspace* work     = solver->work;
+
+  if (!settings->check_infeasibility)
+    return 0;
+  if (approximate)
+    return 1;
+
+  // Count the checks that did not get closer to the tolerances
+  if (work->term_dist > OSQP_INFEASIBILITY_STALL_DECREASE * work->inf_dist_prev)
+    work->inf_stalled++;
+  else
+    work->inf_stalled = 0;
+  work->inf_dist_prev = work->term_dist;
+
+  if (work->inf_stalled < settings->infeasibility_stall)
+    return 0;
+
+  work->inf_checks_skipped++;
+  if (work->inf_checks_skipped < settings->check_infeasibility)
+    return 0;
+
+  work->inf_checks_skipped = 0;
+  return 1;
+}
+
 OSQPInt check_termination(OSQPSolver* solver,
                           OSQPInt     approximate) {
 
   OSQPFloat eps_prim, eps_dual, eps_prim_inf, eps_dual_inf;
   OSQPInt   exitflag;
   OSQPInt   prim_res_check, dual_res_check, prim_inf_check, dual_inf_check;
+  OSQPInt   inf_check;
   OSQPFloat eps_abs, eps_rel;
 
   OSQPInfo*      info     = solver->info;
@@ -747,6 +909,7 @@ OSQPInt check_termination(OSQPSolver* solver,
 
   // Initialize variables to 0
   exitflag       = 0;
+  eps_prim       = 0.0;
   prim_res_check = 0; dual_res_check = 0;
   prim_inf_check = 0; dual_inf_check = 0;
 
@@ -774,30 +937,39 @@ OSQPInt check_termination(OSQPSolver* solver,
     eps_dual_inf *= 10;
   }
 
+  // Compute primal and dual tolerances
+  if (work->data->m > 0)
+    eps_prim = compute_prim_tol(solver, eps_abs, eps_rel);
+  eps_dual = compute_dual_tol(solver, eps_abs, eps_rel);
+
+  // Distance to the tolerances, used to schedule the next check
+  if (!approximate) {
+    work->term_dist = (eps_dual > 0.0) ? info->dual_res / eps_dual : OSQP_INFTY;
+    if (work->data->m > 0)
+      work->term_dist = c_max(work->term_dist,
+                              (eps_prim > 0.0) ? info->prim_res / eps_prim : OSQP_INFTY);
+  }
+
+  inf_check = infeasibility_check_due(solver, approximate);
+
   // Check residuals
   if (work->data->m == 0) {
     prim_res_check = 1; // No constraints -> Primal feasibility always satisfied
   }
   else {
-    // Compute primal tolerance
-    eps_prim = compute_prim_tol(solver, eps_abs, eps_rel);
-
     // Primal feasibility check
     if (info->prim_res < eps_prim) {
       prim_res_check = 1;
-    } else {
+    } else if (inf_check) {
       // Primal infeasibility check
       prim_inf_check = is_primal_infeasible(solver, eps_prim_inf);
     }
   } // End check if m == 0
 
-  // Compute dual tolerance
-  eps_dual = compute_dual_tol(solver, eps_abs, eps_rel);
-
   // Dual feasibility check
   if (info->dual_res < eps_dual) {
     dual_res_check = 1;
-  } else {
+  } else if (inf_check) {
     // Check dual infeasibility
     dual_inf_check = is_dual_infeasible(solver, eps_dual_inf);
   }
@@ -851,6 +1023,92 @@ OSQPInt check_termination(OSQPSolver* solver,
 }
 
 
+#ifndef OSQP_EMBEDDED_MODE
+
+OSQPInt check_solved(OSQPSolver* solver) {
+
+  OSQPInfo*     info     = solver->info;
+  OSQPSettings* settings = solver->settings;
+
+  // Same tests as in check_termination
+  if ((info->prim_res > OSQP_INFTY) || (info->dual_res > OSQP_INFTY))
+    return 0;
+
+  if (solver->work->data->m > 0 &&
+      !(info->prim_res < compute_prim_tol(solver, settings->eps_abs, settings->eps_rel)))
+    return 0;
+
+  return info->dual_res < compute_dual_tol(solver, settings->eps_abs, settings->eps_rel);
+}
+
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
+
+#if OSQP_EMBEDDED_MODE != 1
+
+OSQPInt termination_check_interval(OSQPSolver* solver,
+                                   OSQPInt     iter) {
+
+  OSQPFloat rate;
+  OSQPInt   interval;
+
+  OSQPSettings*  settings = solver->settings;
+  OSQPWorkspace* work     = solver->work;
+
+  OSQPInt max_interval = settings->check_termination;
+  OSQPInt min_interval = c_min(OSQP_CHECK_TERMINATION_MIN, max_interval);
+
+  // Without an estimate of the rate, measure it over the shortest interval
+  interval = min_interval;
+
+  if (work->term_iter_prev > 0 && work->term_dist < OSQP_INFTY) {
+    if (work->term_dist < work->term_dist_prev) {
+      // Linear convergence: the distance shrinks by exp(-rate) per iteration
+      // and reaches the tolerances after log(term_dist)/rate iterations
+      rate = c_log(work->term_dist_prev / work->term_dist) /
+             (OSQPFloat)(iter - work->term_iter_prev);
+      if (c_log(work->term_dist) < rate * max_interval)
+        interval = (OSQPInt)(c_log(work->term_dist) / rate) + 1;
+      else
+        interval = max_interval;
+    }
+    else {
+      // Stagnating residuals
+      interval = max_interval;
+    }
+  }
+
+  work->term_dist_prev = work->term_dist;
+  work->term_iter_prev = iter;
+
+  return c_min(c_max(interval, min_interval), max_interval);
+}
+
+#endif /* if OSQP_EMBEDDED_MODE != 1 */
+
+
+#ifdef OSQP_ENABLE_PROFILING
+
+OSQPInt time_check_interval(OSQPFloat solve_time,
+                            OSQPInt   iter,
+                            OSQPFloat time_left) {
+
+  OSQPFloat interval;
+
+  if (solve_time <= 0.0 || time_left <= 0.0)
+    return 1;
+
+  // Half of the iterations that fit in the time left at the average cost so
+  // far, and at most as many as since the start of the solve
+  interval = 0.5 * time_left * (OSQPFloat)iter / solve_time;
+  interval = c_min(interval, (OSQPFloat)iter);
+
+  return c_max((OSQPInt)interval, 1);
+}
+
+#endif /* ifdef OSQP_ENABLE_PROFILING */
+
+
 #ifndef OSQP_EMBEDDED_MODE
 
 OSQPInt validate_data(const OSQPCscMatrix* P,
@@ -922,6 +1180,71 @@ OSQPInt validate_data(const OSQPCscMatrix* P,
   return 0;
 }
 
+OSQPInt validate_operator_data(const OSQPOperator* P,
+                               const OSQPFloat*    q,
+                               const OSQPOperator* A,
+                               const OSQPFloat*    l,
+                               const OSQPFloat*    u,
+                                     OSQPInt       m,
+                                     OSQPInt       n) {
+  OSQPInt j;
+
+  if (!P) {
+    c_eprint("Missing quadratic cost operator P");
+    return 1;
+  }
+
+  if (!A) {
+    c_eprint("Missing constraint operator A");
+    return 1;
+  }
+
+  if (!q) {
+    c_eprint("Missing linear cost vector q");
+    return 1;
+  }
+
+  // General dimensions Tests
+  if ((n <= 0) || (m < 0)) {
+    c_eprint("n must be positive and m nonnegative; n = %i, m = %i",
+             (int)n, (int)m);
+    return 1;
+  }
+
+  // Operator P
+  if ((P->m != n) || (P->n != n)) {
+    c_eprint("P does not have dimension n x n with n = %i", (int)n);
+    return 1;
+  }
+
+  if (!P->mult) {
+    c_eprint("Missing product callback of P");
+    return 1;
+  }
+
+  // Operator A
+  if ((A->m != m) || (A->n != n)) {
+    c_eprint("A does not have dimension %i x %i", (int)m, (int)n);
+    return 1;
+  }
+
+  if ((m > 0) && (!A->mult || !A->mult_t)) {
+    c_eprint("Missing product callbacks of A");
+    return 1;
+  }
+
+  // Lower and upper bounds
+  for (j = 0; j < m; j++) {
+    if (l[j] > u[j]) {
+      c_eprint("Lower bound at index %d is greater than upper bound: %.4e > %.4e",
+               (int)j, l[j], u[j]);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
 #endif /* ifndef OSQP_EMBEDDED_MODE */
 
 
@@ -983,6 +1306,13 @@ OSQPInt validate_settings(const OSQPSettings* settings,
     return 1;
   }
 
+  if (from_setup &&
+      settings->warm_start_predict != 0 &&
+      settings->warm_start_predict != 1) {
+    c_eprint("warm_start_predict must be either 0 or 1");
+    return 1;
+  }
+
   if (from_setup && settings->scaling < 0) {
     c_eprint("scaling must be nonnegative");
     return 1;
@@ -1017,6 +1347,21 @@ OSQPInt validate_settings(const OSQPSettings* settings,
     return 1;
   }
 
+  if (from_setup && settings->anderson_mem < 0) {
+    c_eprint("anderson_mem must be nonnegative");
+    return 1;
+  }
+
+  if (from_setup && settings->nesterov != 0 && settings->nesterov != 1) {
+    c_eprint("nesterov must be either 0 or 1");
+    return 1;
+  }
+
+  if (from_setup && settings->nesterov && settings->anderson_mem > 0) {
+    c_eprint("nesterov and anderson_mem cannot be used together");
+    return 1;
+  }
+
   if (settings->cg_max_iter <= 0) {
     c_eprint("cg_max_iter must be positive");
     return 1;
@@ -1033,6 +1378,20 @@ OSQPInt validate_settings(const OSQPSettings* settings,
     return 1;
   }
 
+  if (settings->cg_block_size < 0) {
+    c_eprint("cg_block_size must be nonnegative");
+    return 1;
+  }
+
+  if (from_setup &&
+      settings->cg_method != OSQP_CG_STANDARD &&
+      settings->cg_method != OSQP_CG_MINRES &&
+      settings->cg_method != OSQP_CG_DEFLATED &&
+      settings->cg_method != OSQP_CG_PIPELINED) {
+    c_eprint("cg_method not recognized");
+    return 1;
+  }
+
   if (from_setup &&
       settings->adaptive_rho != 0 &&
       settings->adaptive_rho != 1) {
@@ -1055,6 +1414,18 @@ OSQPInt validate_settings(const OSQPSettings* settings,
     return 1;
   }
 
+  if (from_setup &&
+      settings->adaptive_rho_vec != 0 &&
+      settings->adaptive_rho_vec != 1) {
+    c_eprint("adaptive_rho_vec must be either 0 or 1");
+    return 1;
+  }
+
+  if (from_setup && settings->adaptive_rho_vec && !settings->rho_is_vec) {
+    c_eprint("adaptive_rho_vec requires rho_is_vec");
+    return 1;
+  }
+
   if (settings->max_iter <= 0) {
     c_eprint("max_iter must be positive");
     return 1;
@@ -1097,6 +1468,22 @@ OSQPInt validate_settings(const OSQPSettings* settings,
     return 1;
   }
 
+  if (settings->adaptive_termination != 0 &&
+      settings->adaptive_termination != 1) {
+    c_eprint("adaptive_termination must be either 0 or 1");
+    return 1;
+  }
+
+  if (settings->check_infeasibility < 0) {
+    c_eprint("check_infeasibility must be nonnegative");
+    return 1;
+  }
+
+  if (settings->infeasibility_stall < 0) {
+    c_eprint("infeasibility_stall must be nonnegative");
+    return 1;
+  }
+
   if (settings->time_limit <= 0.0) {
     c_eprint("time_limit must be positive\n");
     return 1;
@@ -1112,5 +1499,20 @@ OSQPInt validate_settings(const OSQPSettings* settings,
     return 1;
   }
 
+  if (settings->polish_schur < 0) {
+    c_eprint("polish_schur must be nonnegative");
+    return 1;
+  }
+
+  if (settings->polish_speculative < 0) {
+    c_eprint("polish_speculative must be nonnegative");
+    return 1;
+  }
+
+  if (settings->rho_racing < 0) {
+    c_eprint("rho_racing must be nonnegative");
+    return 1;
+  }
+
   return 0;
 }
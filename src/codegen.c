@@ -175,20 +175,27 @@ static OSQPInt write_settings(FILE*               f,
   fprintf(f, "  0,\n"); // verbose
   fprintf(f, "  0,\n"); // profiler level
   fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->warm_starting);
+  fprintf(f, "  0,\n"); // warm_start_predict
   fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->scaling);
   fprintf(f, "  0,\n"); // polishing
   fprintf(f, "  (OSQPFloat)%.20f,\n", settings->rho);
   fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->rho_is_vec);
   fprintf(f, "  (OSQPFloat)%.20f,\n", settings->sigma);
   fprintf(f, "  (OSQPFloat)%.20f,\n", settings->alpha);
+  fprintf(f, "  0,\n"); // anderson_mem
+  fprintf(f, "  0,\n"); // nesterov
   fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->cg_max_iter);
   fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->cg_tol_reduction);
   fprintf(f, "  (OSQPFloat)%.20f,\n", settings->cg_tol_fraction);
   fprintf(f, "  %u,\n", settings->cg_precond);
+  fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->cg_block_size);
+  fprintf(f, "  %u,\n", settings->cg_method);
   fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->adaptive_rho);
   fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->adaptive_rho_interval);
   fprintf(f, "  (OSQPFloat)%.20f,\n", settings->adaptive_rho_fraction);
   fprintf(f, "  (OSQPFloat)%.20f,\n", settings->adaptive_rho_tolerance);
+  fprintf(f, "  0,\n"); // adaptive_rho_vec
+  fprintf(f, "  0,\n"); // rho_racing
   fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->max_iter);
   fprintf(f, "  (OSQPFloat)%.20f,\n", settings->eps_abs);
   fprintf(f, "  (OSQPFloat)%.20f,\n", settings->eps_rel);
@@ -196,9 +203,14 @@ static OSQPInt write_settings(FILE*               f,
   fprintf(f, "  (OSQPFloat)%.20f,\n", settings->eps_dual_inf);
   fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->scaled_termination);
   fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->check_termination);
+  fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->adaptive_termination);
+  fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->check_infeasibility);
+  fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->infeasibility_stall);
   fprintf(f, "  (OSQPFloat)%.20f,\n", settings->time_limit);
   fprintf(f, "  (OSQPFloat)%.20f,\n", settings->delta);
   fprintf(f, "  %" OSQP_INT_FMT ",\n", settings->polish_refine_iter);
+  fprintf(f, "  0,\n"); // polish_schur
+  fprintf(f, "  0,\n"); // polish_speculative
   fprintf(f, "};\n\n");
 
   return OSQP_NO_ERROR;
@@ -220,12 +232,14 @@ static OSQPInt write_info(FILE*           f,
   fprintf(f, "  \"%s\",\n", OSQP_STATUS_MESSAGE[OSQP_UNSOLVED]);
   fprintf(f, "  %d,\n", OSQP_UNSOLVED);
   fprintf(f, "  0,\n"); // status_polish
+  fprintf(f, "  0,\n"); // status_pred
   fprintf(f, "  (OSQPFloat)%.20f,\n", OSQP_INFTY); // obj_val
   fprintf(f, "  (OSQPFloat)%.20f,\n", OSQP_INFTY); // prim_res
   fprintf(f, "  (OSQPFloat)%.20f,\n", OSQP_INFTY); // dual_res
   fprintf(f, "  0,\n"); // iter (iteration count)
   fprintf(f, "  0,\n"); // rho_updates
   fprintf(f, "  (OSQPFloat)%.20f,\n", info->rho_estimate);
+  fprintf(f, "  (OSQPFloat)0.0,\n"); // pred_iter_saved
   fprintf(f, "  (OSQPFloat)0.0,\n"); // setup_time
   fprintf(f, "  (OSQPFloat)0.0,\n"); // solve_time
   fprintf(f, "  (OSQPFloat)0.0,\n"); // update_time
@@ -357,15 +371,18 @@ static OSQPInt write_linsys(FILE*               f,
   OSQPInt n = linsys->n;
   OSQPInt m = linsys->m;
 
+  /* Dimension of the factored matrix (n if the reduced KKT system is used) */
+  OSQPInt nKKT = linsys->L->n;
+
   fprintf(f, "/* Define the linear system solver structure */\n");
   sprintf(name, "%slinsys_L", prefix);
   GENERATE_ERROR(write_csc(f, linsys->L, name))
   sprintf(name, "%slinsys_Dinv", prefix);
-  GENERATE_ERROR(write_vecf(f, linsys->Dinv, n+m, name))
+  GENERATE_ERROR(write_vecf(f, linsys->Dinv, nKKT, name))
   sprintf(name, "%slinsys_P", prefix);
-  GENERATE_ERROR(write_veci(f, linsys->P, n+m, name))
-  fprintf(f, "OSQPFloat %slinsys_bp[%" OSQP_INT_FMT "];\n",  prefix, n+m);
-  fprintf(f, "OSQPFloat %slinsys_sol[%" OSQP_INT_FMT "];\n", prefix, n+m);
+  GENERATE_ERROR(write_veci(f, linsys->P, nKKT, name))
+  fprintf(f, "OSQPFloat %slinsys_bp[%" OSQP_INT_FMT "];\n",  prefix, nKKT);
+  fprintf(f, "OSQPFloat %slinsys_sol[%" OSQP_INT_FMT "];\n", prefix, nKKT);
 
   if (linsys->rho_inv_vec) {
     sprintf(name, "%slinsys_rho_inv_vec", prefix);
@@ -382,14 +399,26 @@ static OSQPInt write_linsys(FILE*               f,
     sprintf(name, "%slinsys_rhotoKKT", prefix);
     GENERATE_ERROR(write_veci(f, linsys->rhotoKKT, m, name))
     sprintf(name, "%slinsys_D", prefix);
-    GENERATE_ERROR(write_vecf(f, linsys->D, n+m, name))
+    GENERATE_ERROR(write_vecf(f, linsys->D, nKKT, name))
     sprintf(name, "%slinsys_etree", prefix);
-    GENERATE_ERROR(write_veci(f, linsys->etree, n+m, name))
+    GENERATE_ERROR(write_veci(f, linsys->etree, nKKT, name))
     sprintf(name, "%slinsys_Lnz", prefix);
-    GENERATE_ERROR(write_veci(f, linsys->Lnz, n+m, name))
-    fprintf(f, "QDLDL_int   %slinsys_iwork[%" OSQP_INT_FMT "];\n", prefix, 3*(n+m));
-    fprintf(f, "QDLDL_bool  %slinsys_bwork[%" OSQP_INT_FMT "];\n", prefix, n+m);
-    fprintf(f, "QDLDL_float %slinsys_fwork[%" OSQP_INT_FMT "];\n", prefix, n+m);
+    GENERATE_ERROR(write_veci(f, linsys->Lnz, nKKT, name))
+    fprintf(f, "QDLDL_int   %slinsys_iwork[%" OSQP_INT_FMT "];\n", prefix, 3*nKKT);
+    fprintf(f, "QDLDL_bool  %slinsys_bwork[%" OSQP_INT_FMT "];\n", prefix, nKKT);
+    fprintf(f, "QDLDL_float %slinsys_fwork[%" OSQP_INT_FMT "];\n", prefix, nKKT);
+
+    if (linsys->reduced) {
+      sprintf(name, "%slinsys_At", prefix);
+      GENERATE_ERROR(write_csc(f, linsys->At, name))
+      sprintf(name, "%slinsys_AtoAt", prefix);
+      GENERATE_ERROR(write_veci(f, linsys->AtoAt, data->A->csc->p[n], name))
+      sprintf(name, "%slinsys_Kred", prefix);
+      GENERATE_ERROR(write_csc(f, linsys->Kred, name))
+      sprintf(name, "%slinsys_KredtoKKT", prefix);
+      GENERATE_ERROR(write_veci(f, linsys->KredtoKKT, linsys->Kred->p[n], name))
+      fprintf(f, "OSQPFloat   %slinsys_rwork[%" OSQP_INT_FMT "];\n", prefix, n);
+    }
   }
 
   fprintf(f, "qdldl_solver %slinsys = {\n", prefix);
@@ -431,6 +460,32 @@ static OSQPInt write_linsys(FILE*               f,
     fprintf(f, "  %slinsys_iwork,\n", prefix);
     fprintf(f, "  %slinsys_bwork,\n", prefix);
     fprintf(f, "  %slinsys_fwork,\n", prefix);
+    fprintf(f, "  OSQP_NULL,\n"); // adj
+  }
+  fprintf(f, "  %" OSQP_INT_FMT ",\n", linsys->reduced);
+  if (linsys->reduced) {
+    fprintf(f, "  &%sdata_A_csc,\n", prefix);
+  }
+  else {
+    fprintf(f, "  OSQP_NULL,\n");
+  }
+  if (embedded > 1) {
+    if (linsys->reduced) {
+      fprintf(f, "  &%sdata_P_csc,\n", prefix);
+      fprintf(f, "  &%slinsys_At,\n", prefix);
+      fprintf(f, "  %slinsys_AtoAt,\n", prefix);
+      fprintf(f, "  &%slinsys_Kred,\n", prefix);
+      fprintf(f, "  %slinsys_KredtoKKT,\n", prefix);
+      fprintf(f, "  %slinsys_rwork,\n", prefix);
+    }
+    else {
+      fprintf(f, "  OSQP_NULL,\n"); // Pdata
+      fprintf(f, "  OSQP_NULL,\n"); // At
+      fprintf(f, "  OSQP_NULL,\n"); // AtoAt
+      fprintf(f, "  OSQP_NULL,\n"); // Kred
+      fprintf(f, "  OSQP_NULL,\n"); // KredtoKKT
+      fprintf(f, "  OSQP_NULL,\n"); // rwork
+    }
   }
   fprintf(f, "};\n\n");
 
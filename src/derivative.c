@@ -107,6 +107,11 @@ OSQPInt adjoint_derivative_compute(OSQPSolver *solver,
     if (!solver || !solver->work || !solver->work->derivative_data)
       return osqp_error(OSQP_WORKSPACE_NOT_INIT_ERROR);
 
+    // The derivative KKT system needs P and A in CSC form
+    if (OSQPMatrix_is_operator(solver->work->data->P) ||
+        OSQPMatrix_is_operator(solver->work->data->A))
+      return osqp_error(OSQP_FUNC_NOT_IMPLEMENTED);
+
     OSQPInt m = solver->work->data->m;
     OSQPInt n = solver->work->data->n;
     OSQPDerivativeData *derivative_data = solver->work->derivative_data;
@@ -0,0 +1,112 @@
+#include "glob_opts.h"
+#include "nesterov.h"
+#include "lin_alg.h"
+
+// Decrease of the combined residual required to keep the momentum
+#define NESTEROV_RESTART (0.999)
+
+
+OSQPNesterov* nesterov_new(OSQPInt n,
+                           OSQPInt m) {
+
+  OSQPInt b;
+  OSQPInt len[3] = { n, m, m };
+
+  OSQPNesterov* nest = c_calloc(1, sizeof(OSQPNesterov));
+  if (!nest) return OSQP_NULL;
+
+  nest->fz = OSQPVectorf_malloc(m);
+  if (!nest->fz) {
+    nesterov_free(nest);
+    return OSQP_NULL;
+  }
+
+  for (b = 0; b < 3; b++) {
+    nest->g_prev[b] = OSQPVectorf_malloc(len[b]);
+    if (!nest->g_prev[b]) {
+      nesterov_free(nest);
+      return OSQP_NULL;
+    }
+  }
+
+  nesterov_reset(nest);
+
+  return nest;
+}
+
+
+void nesterov_reset(OSQPNesterov* nest) {
+  nest->has_prev = 0;
+  nest->a        = 1.0;
+}
+
+
+void nesterov_residual(OSQPSolver* solver) {
+
+  OSQPWorkspace* work = solver->work;
+  OSQPNesterov*  nest = work->nest;
+  OSQPFloat      rho  = solver->settings->rho;
+  OSQPFloat      dy   = OSQPVectorf_norm_2(work->delta_y);
+  OSQPFloat      dz;
+
+  OSQPVectorf_minus(nest->fz, work->z, work->z_prev);
+  dz = OSQPVectorf_norm_2(nest->fz);
+
+  nest->f_new = c_sqrt(dy * dy / rho + rho * dz * dz);
+}
+
+
+void nesterov_step(OSQPSolver* solver) {
+
+  OSQPInt        b;
+  OSQPWorkspace* work = solver->work;
+  OSQPNesterov*  nest = work->nest;
+  OSQPFloat      a_next, beta;
+
+  OSQPVectorf* g[3] = { work->x, work->z, work->y };
+
+  // First iteration after a reset
+  if (!nest->has_prev) {
+    for (b = 0; b < 3; b++) OSQPVectorf_copy(nest->g_prev[b], g[b]);
+    nest->has_prev = 1;
+    nest->a        = 1.0;
+    nest->f_norm   = nest->f_new;
+    return;
+  }
+
+  // Restart when the residual stopped decreasing. If the last step used
+  // momentum, continue from the ADMM output taken before it.
+  if (nest->f_new > NESTEROV_RESTART * nest->f_norm) {
+    if (nest->a > 1.0)
+      for (b = 0; b < 3; b++) OSQPVectorf_copy(g[b], nest->g_prev[b]);
+    else
+      for (b = 0; b < 3; b++) OSQPVectorf_copy(nest->g_prev[b], g[b]);
+    nest->a       = 1.0;
+    nest->f_norm /= NESTEROV_RESTART;
+    return;
+  }
+
+  a_next  = 0.5 * (1.0 + c_sqrt(1.0 + 4.0 * nest->a * nest->a));
+  beta    = (nest->a - 1.0) / a_next;
+  nest->a = a_next;
+  nest->f_norm = nest->f_new;
+
+  for (b = 0; b < 3; b++) {
+    // g_prev <- g_k - g_{k-1}, g <- g_k + beta*(g_k - g_{k-1}), g_prev <- g_k
+    OSQPVectorf_minus(nest->g_prev[b], g[b], nest->g_prev[b]);
+    OSQPVectorf_add_scaled(g[b], 1.0, g[b], beta, nest->g_prev[b]);
+    OSQPVectorf_add_scaled(nest->g_prev[b], 1.0, g[b], -beta, nest->g_prev[b]);
+  }
+}
+
+
+void nesterov_free(OSQPNesterov* nest) {
+
+  OSQPInt b;
+
+  if (nest) {
+    for (b = 0; b < 3; b++) OSQPVectorf_free(nest->g_prev[b]);
+    OSQPVectorf_free(nest->fz);
+    c_free(nest);
+  }
+}
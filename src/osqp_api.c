@@ -17,6 +17,10 @@
 
 #ifndef OSQP_EMBEDDED_MODE
 #include "polish.h"
+#include "anderson.h"
+#include "nesterov.h"
+#include "race.h"
+#include "predict.h"
 #endif
 
 #ifdef OSQP_ENABLE_DERIVATIVES
@@ -27,6 +31,10 @@
 #include "interrupt.h"
 #endif
 
+#if !defined(OSQP_EMBEDDED_MODE) && defined(OSQP_ENABLE_OPENMP)
+#include <omp.h>
+#endif
+
 /**********************
  * Main API Functions *
  **********************/
@@ -114,6 +122,7 @@ void osqp_set_default_settings(OSQPSettings *settings)
 
   settings->verbose = OSQP_VERBOSE;             /* print output */
   settings->warm_starting = OSQP_WARM_STARTING; /* warm starting */
+  settings->warm_start_predict = OSQP_WARM_START_PREDICT; /* extrapolated warm start */
   settings->scaling = OSQP_SCALING;             /* heuristic problem scaling */
   settings->polishing = OSQP_POLISHING;         /* ADMM solution polish: 1 */
 
@@ -121,16 +130,22 @@ void osqp_set_default_settings(OSQPSettings *settings)
   settings->rho_is_vec = OSQP_RHO_IS_VEC;  /* defines whether rho is scalar or vector*/
   settings->sigma = (OSQPFloat)OSQP_SIGMA; /* ADMM step */
   settings->alpha = (OSQPFloat)OSQP_ALPHA; /* relaxation parameter */
+  settings->anderson_mem = OSQP_ANDERSON_MEM; /* Anderson acceleration memory (disabled) */
+  settings->nesterov = OSQP_NESTEROV;          /* restarted Nesterov momentum */
 
   settings->cg_max_iter = OSQP_CG_MAX_ITER;            /* maximum number of CG iterations */
   settings->cg_tol_reduction = OSQP_CG_TOL_REDUCTION;  /* CG tolerance parameter */
   settings->cg_tol_fraction = OSQP_CG_TOL_FRACTION;    /* CG tolerance parameter */
   settings->cg_precond = OSQP_DIAGONAL_PRECONDITIONER; /* Preconditioner to use in CG */
+  settings->cg_block_size = OSQP_CG_BLOCK_SIZE;        /* Block size of the block-Jacobi preconditioner */
+  settings->cg_method = OSQP_CG_STANDARD;              /* Krylov method of the indirect solver */
 
   settings->adaptive_rho = OSQP_ADAPTIVE_RHO;
   settings->adaptive_rho_interval = OSQP_ADAPTIVE_RHO_INTERVAL;
   settings->adaptive_rho_fraction = (OSQPFloat)OSQP_ADAPTIVE_RHO_FRACTION;
   settings->adaptive_rho_tolerance = (OSQPFloat)OSQP_ADAPTIVE_RHO_TOLERANCE;
+  settings->adaptive_rho_vec = OSQP_ADAPTIVE_RHO_VEC;
+  settings->rho_racing = OSQP_RHO_RACING;                 /* race ADMM replicas with different rho: 0 (off) */
 
   settings->max_iter = OSQP_MAX_ITER;                     /* maximum number of ADMM iterations */
   settings->eps_abs = (OSQPFloat)OSQP_EPS_ABS;            /* absolute convergence tolerance */
@@ -139,23 +154,57 @@ void osqp_set_default_settings(OSQPSettings *settings)
   settings->eps_dual_inf = (OSQPFloat)OSQP_EPS_DUAL_INF;  /* dual infeasibility tolerance */
   settings->scaled_termination = OSQP_SCALED_TERMINATION; /* evaluate scaled termination criteria */
   settings->check_termination = OSQP_CHECK_TERMINATION;   /* interval for evaluating termination criteria */
+  settings->adaptive_termination = OSQP_ADAPTIVE_TERMINATION; /* schedule termination checks from the convergence rate */
+  settings->check_infeasibility = OSQP_CHECK_INFEASIBILITY;   /* termination checks between infeasibility checks */
+  settings->infeasibility_stall = OSQP_INFEASIBILITY_STALL;   /* stalled termination checks before infeasibility checks */
   settings->time_limit = OSQP_TIME_LIMIT;                 /* stop the algorithm when time limit is reached */
 
   settings->delta = OSQP_DELTA;                           /* regularization parameter for polishing */
   settings->polish_refine_iter = OSQP_POLISH_REFINE_ITER; /* iterative refinement steps in polish */
+  settings->polish_schur = OSQP_POLISH_SCHUR;             /* polish on the ADMM factorization: 0 (off) */
+  settings->polish_speculative = OSQP_POLISH_SPECULATIVE; /* polish during the ADMM iterations: 0 (off) */
+}
+
+#if OSQP_EMBEDDED_MODE != 1
+
+/* Fix the automatic adaptive rho interval when it cannot be measured with the
+ * timer: a multiple of check_termination, or a predefined number */
+static void set_fixed_rho_interval(OSQPSettings *settings)
+{
+  if (settings->adaptive_rho && !settings->adaptive_rho_interval)
+  {
+    if (settings->check_termination)
+    {
+      // If check_termination is enabled, we set it to a multiple of the check
+      // termination interval
+      settings->adaptive_rho_interval = OSQP_ADAPTIVE_RHO_MULTIPLE_TERMINATION *
+                                        settings->check_termination;
+    }
+    else
+    {
+      // If check_termination is disabled we set it to a predefined fix number
+      settings->adaptive_rho_interval = OSQP_ADAPTIVE_RHO_FIXED;
+    }
+  }
 }
 
+#endif /* if OSQP_EMBEDDED_MODE != 1 */
+
 #ifndef OSQP_EMBEDDED_MODE
 
-OSQPInt osqp_setup(OSQPSolver **solverp,
-                   const OSQPCscMatrix *P,
-                   const OSQPFloat *q,
-                   const OSQPCscMatrix *A,
-                   const OSQPFloat *l,
-                   const OSQPFloat *u,
-                   OSQPInt m,
-                   OSQPInt n,
-                   const OSQPSettings *settings)
+/* Setup shared by osqp_setup and osqp_setup_operator. P and A are given
+ * either as CSC matrices (Pop and Aop are OSQP_NULL) or as operators. */
+static OSQPInt setup_solver(OSQPSolver **solverp,
+                            const OSQPCscMatrix *P,
+                            const OSQPOperator *Pop,
+                            const OSQPFloat *q,
+                            const OSQPCscMatrix *A,
+                            const OSQPOperator *Aop,
+                            const OSQPFloat *l,
+                            const OSQPFloat *u,
+                            OSQPInt m,
+                            OSQPInt n,
+                            const OSQPSettings *settings)
 {
 
   OSQPInt exitflag;
@@ -163,10 +212,6 @@ OSQPInt osqp_setup(OSQPSolver **solverp,
   OSQPSolver *solver;
   OSQPWorkspace *work;
 
-  // Validate data
-  if (validate_data(P, q, A, l, u, m, n))
-    return osqp_error(OSQP_DATA_VALIDATION_ERROR);
-
   // Validate settings
   if (validate_settings(settings, 1))
     return osqp_error(OSQP_SETTINGS_VALIDATION_ERROR);
@@ -212,13 +257,19 @@ OSQPInt osqp_setup(OSQPSolver **solverp,
   work->data->n = n;
 
   // objective function
-  work->data->P = OSQPMatrix_new_from_csc(P, 1); // copy assuming triu form
+  if (Pop)
+    work->data->P = OSQPMatrix_new_from_operator(Pop, 1);
+  else
+    work->data->P = OSQPMatrix_new_from_csc(P, 1); // copy assuming triu form
   work->data->q = OSQPVectorf_new(q, n);
   if (!(work->data->P) || !(work->data->q))
     return osqp_error(OSQP_MEM_ALLOC_ERROR);
 
   // Constraints
-  work->data->A = OSQPMatrix_new_from_csc(A, 0); // assumes non-triu form (i.e. full)
+  if (Aop)
+    work->data->A = OSQPMatrix_new_from_operator(Aop, 0);
+  else
+    work->data->A = OSQPMatrix_new_from_csc(A, 0); // assumes non-triu form (i.e. full)
   if (!(work->data->A))
     return osqp_error(OSQP_MEM_ALLOC_ERROR);
   work->data->l = OSQPVectorf_new(l, m);
@@ -353,19 +404,53 @@ OSQPInt osqp_setup(OSQPSolver **solverp,
   osqp_cold_start(solver);
 
   // Initialize active constraints structure
-  work->pol = c_malloc(sizeof(OSQPPolish));
+  work->pol = c_calloc(1, sizeof(OSQPPolish));
   if (!(work->pol))
     return osqp_error(OSQP_MEM_ALLOC_ERROR);
   work->pol->active_flags = OSQPVectori_malloc(m);
+  work->pol->Ared_flags = OSQPVectori_malloc(m);
   work->pol->x = OSQPVectorf_malloc(n);
   work->pol->z = OSQPVectorf_malloc(m);
   work->pol->y = OSQPVectorf_malloc(m);
   if (!(work->pol->x))
     return osqp_error(OSQP_MEM_ALLOC_ERROR);
-  if (!(work->pol->active_flags) ||
+  if (!(work->pol->active_flags) || !(work->pol->Ared_flags) ||
       !(work->pol->z) || !(work->pol->y))
     return osqp_error(OSQP_MEM_ALLOC_ERROR);
 
+  // Allocate the Anderson acceleration memory
+  if (settings->anderson_mem > 0)
+  {
+    work->aa = anderson_new(settings->anderson_mem, n, m);
+    if (!(work->aa))
+      return osqp_error(OSQP_MEM_ALLOC_ERROR);
+  }
+
+  // Allocate the momentum state
+  if (settings->nesterov)
+  {
+    work->nest = nesterov_new(n, m);
+    if (!(work->nest))
+      return osqp_error(OSQP_MEM_ALLOC_ERROR);
+  }
+
+  // Allocate the warm start prediction
+  if (settings->warm_start_predict)
+  {
+    work->pred = predict_new(n, m);
+    if (!(work->pred))
+      return osqp_error(OSQP_MEM_ALLOC_ERROR);
+  }
+
+  // Allocate the per-constraint rho work vectors
+  if (settings->adaptive_rho_vec)
+  {
+    work->rho_vec_new = OSQPVectorf_malloc(m);
+    work->rho_vec_tmp = OSQPVectorf_malloc(m);
+    if (!(work->rho_vec_new) || !(work->rho_vec_tmp))
+      return osqp_error(OSQP_MEM_ALLOC_ERROR);
+  }
+
   // Allocate solution
   if (settings->allocate_solution)
   {
@@ -392,6 +477,8 @@ OSQPInt osqp_setup(OSQPSolver **solverp,
 
   // Initialize information
   solver->info->status_polish = OSQP_POLISH_NOT_PERFORMED; // Polishing not performed
+  solver->info->status_pred = OSQP_PRED_NOT_PERFORMED;     // Prediction not performed
+  solver->info->pred_iter_saved = 0.0;
   update_status(solver->info, OSQP_UNSOLVED);
 #ifdef OSQP_ENABLE_PROFILING
   solver->info->solve_time = 0.0;                   // Solve time to zero
@@ -420,21 +507,7 @@ OSQPInt osqp_setup(OSQPSolver **solverp,
   // If adaptive rho and automatic interval, but profiling disabled, we need to
   // set the interval to a default value
 #ifndef OSQP_ENABLE_PROFILING
-  if (solver->settings->adaptive_rho && !solver->settings->adaptive_rho_interval)
-  {
-    if (solver->settings->check_termination)
-    {
-      // If check_termination is enabled, we set it to a multiple of the check
-      // termination interval
-      solver->settings->adaptive_rho_interval = OSQP_ADAPTIVE_RHO_MULTIPLE_TERMINATION *
-                                                solver->settings->check_termination;
-    }
-    else
-    {
-      // If check_termination is disabled we set it to a predefined fix number
-      solver->settings->adaptive_rho_interval = OSQP_ADAPTIVE_RHO_FIXED;
-    }
-  }
+  set_fixed_rho_interval(solver->settings);
 #endif /* ifndef OSQP_ENABLE_PROFILING */
 
 #ifdef OSQP_ENABLE_DERIVATIVES
@@ -457,25 +530,96 @@ OSQPInt osqp_setup(OSQPSolver **solverp,
   return 0;
 }
 
+OSQPInt osqp_setup(OSQPSolver **solverp,
+                   const OSQPCscMatrix *P,
+                   const OSQPFloat *q,
+                   const OSQPCscMatrix *A,
+                   const OSQPFloat *l,
+                   const OSQPFloat *u,
+                   OSQPInt m,
+                   OSQPInt n,
+                   const OSQPSettings *settings)
+{
+  // Validate data
+  if (validate_data(P, q, A, l, u, m, n))
+    return osqp_error(OSQP_DATA_VALIDATION_ERROR);
+
+  return setup_solver(solverp, P, OSQP_NULL, q, A, OSQP_NULL, l, u, m, n, settings);
+}
+
+OSQPInt osqp_setup_operator(OSQPSolver **solverp,
+                            const OSQPOperator *P,
+                            const OSQPFloat *q,
+                            const OSQPOperator *A,
+                            const OSQPFloat *l,
+                            const OSQPFloat *u,
+                            OSQPInt m,
+                            OSQPInt n,
+                            const OSQPSettings *settings)
+{
+  OSQPSettings op_settings;
+
+  if (!(osqp_capabilities() & OSQP_CAPABILITY_MATRIX_FREE))
+    return osqp_error(OSQP_FUNC_NOT_IMPLEMENTED);
+
+  // Validate data
+  if (validate_operator_data(P, q, A, l, u, m, n))
+    return osqp_error(OSQP_DATA_VALIDATION_ERROR);
+
+  if (!settings)
+    return osqp_error(OSQP_SETTINGS_VALIDATION_ERROR);
+
+  // Only the products with P and A are available: the KKT system is solved
+  // with the indirect solver, and scaling and polishing are turned off
+  op_settings = *settings;
+  op_settings.linsys_solver = OSQP_INDIRECT_SOLVER;
+  op_settings.scaling = 0;
+  op_settings.polishing = 0;
+
+  return setup_solver(solverp, OSQP_NULL, P, q, OSQP_NULL, A, l, u, m, n, &op_settings);
+}
+
 #endif /* ifndef OSQP_EMBEDDED_MODE */
 
-OSQPInt osqp_solve(OSQPSolver *solver)
+/* ADMM solve shared by osqp_solve and osqp_solve_lean. The solution is stored
+ * in solution (skipped if OSQP_NULL). In lean mode, the interrupt handler,
+ * the timer, printing and polishing are skipped. */
+static OSQPInt solve_admm(OSQPSolver   *solver,
+                          OSQPSolution *solution,
+                          OSQPInt       lean)
 {
 
   OSQPInt exitflag;
   OSQPInt iter, max_iter;
   OSQPInt compute_obj;           // boolean: compute objective function in the loop or not
   OSQPInt can_check_termination; // boolean: check termination or not
+#if OSQP_EMBEDDED_MODE != 1
+  OSQPInt next_check;            // iteration of the next adaptive termination check
+  OSQPInt rho_updates;           // number of rho updates before adapt_rho
+#endif
   OSQPWorkspace *work;
 
 #ifdef OSQP_ENABLE_PROFILING
-  OSQPFloat temp_run_time; // Temporary variable to store current run time
-#endif                     /* ifdef OSQP_ENABLE_PROFILING */
+  OSQPFloat temp_run_time;   // Temporary variable to store current run time
+  OSQPFloat solve_run_time;  // Time since the start of the solve
+  OSQPFloat time_left;       // Time until the next timer deadline
+  OSQPInt   next_time_check; // iteration of the next timer read
+  OSQPInt   time_checked;    // boolean: timer read at this iteration
+#endif                       /* ifdef OSQP_ENABLE_PROFILING */
 
 #ifdef OSQP_ENABLE_PRINTING
   OSQPInt can_print; // Boolean whether you can print
 #endif               /* ifdef OSQP_ENABLE_PRINTING */
 
+#ifndef OSQP_EMBEDDED_MODE
+  OSQPInt speculative;   // boolean: polish speculatively during the iterations
+  OSQPInt spec_polished; // boolean: the ADMM stopped at a speculative polish
+#endif                   /* ifndef OSQP_EMBEDDED_MODE */
+
+#ifdef OSQP_ENABLE_INTERRUPT
+  OSQPInt listen; // boolean: install the Ctrl-C handler for this solve
+#endif            /* ifdef OSQP_ENABLE_INTERRUPT */
+
   // Check if solver has been initialized
   if (!solver || !solver->work)
     return osqp_error(OSQP_WORKSPACE_NOT_INIT_ERROR);
@@ -490,22 +634,32 @@ OSQPInt osqp_solve(OSQPSolver *solver)
   // Initialize variables
   exitflag = 0;
   can_check_termination = 0;
+#if OSQP_EMBEDDED_MODE != 1
+  next_check = c_min(OSQP_CHECK_TERMINATION_MIN, solver->settings->check_termination);
+  work->term_iter_prev = 0;
+#endif
+  work->inf_checks_skipped = 0;
+  work->inf_stalled        = 0;
+  work->inf_dist_prev      = OSQP_INFTY;
 #ifdef OSQP_ENABLE_PRINTING
-  can_print = solver->settings->verbose;
+  can_print = solver->settings->verbose && !lean;
   // Compute objective function only if verbose is on
-  compute_obj = solver->settings->verbose;
+  compute_obj = can_print;
 #else  /* ifdef OSQP_ENABLE_PRINTING */
   compute_obj = 0;
 #endif /* ifdef OSQP_ENABLE_PRINTING */
 
 #ifdef OSQP_ENABLE_PROFILING
-  osqp_tic(work->timer); // Start timer
-#endif                   /* ifdef OSQP_ENABLE_PROFILING */
+  if (!lean)
+    osqp_tic(work->timer); // Start timer
+  next_time_check = 1;
+  solve_run_time  = 0.0;
+#endif                     /* ifdef OSQP_ENABLE_PROFILING */
 
   osqp_profiler_sec_push(OSQP_PROFILER_SEC_OPT_SOLVE);
 
 #ifdef OSQP_ENABLE_PRINTING
-  if (solver->settings->verbose)
+  if (can_print)
   {
     // Print Header for every column
     print_header();
@@ -515,13 +669,42 @@ OSQPInt osqp_solve(OSQPSolver *solver)
 #ifdef OSQP_ENABLE_INTERRUPT
 
   // initialize Ctrl-C support
-  osqp_start_interrupt_listener();
+  listen = !lean;
+#ifndef OSQP_EMBEDDED_MODE
+  // osqp_solve_batch listens for all its threads at once
+  listen = listen && !work->batch;
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+  if (listen)
+    osqp_start_interrupt_listener();
 #endif /* ifdef OSQP_ENABLE_INTERRUPT */
 
   // Initialize variables (cold start or warm start depending on settings)
   // If not warm start -> set x, z, y to zero
   if (!solver->settings->warm_starting)
     osqp_cold_start(solver);
+#ifndef OSQP_EMBEDDED_MODE
+  // Extrapolate the start from the previous solutions
+  else if (work->pred && !lean)
+    predict_start(solver);
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
+#ifndef OSQP_EMBEDDED_MODE
+  // The data or the iterates may have changed since the last solve
+  if (work->aa)
+    anderson_reset(work->aa);
+  if (work->nest)
+    nesterov_reset(work->nest);
+
+  speculative = solver->settings->polishing && !lean &&
+                solver->settings->polish_speculative;
+  spec_polished = 0;
+  if (speculative)
+  {
+    exitflag = polish_speculative_init(solver);
+    if (exitflag)
+      goto exit;
+  }
+#endif /* ifndef OSQP_EMBEDDED_MODE */
 
   // Main ADMM algorithm
 
@@ -553,6 +736,13 @@ OSQPInt osqp_solve(OSQPSolver *solver)
     /* Compute y^{k+1} */
     update_y(solver);
 
+#ifndef OSQP_EMBEDDED_MODE
+    if (work->aa)
+      anderson_residual(work->aa, work);
+    if (work->nest)
+      nesterov_residual(solver);
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
     /* End of ADMM Steps */
     osqp_profiler_sec_pop(OSQP_PROFILER_SEC_ADMM_UPDATE);
     osqp_profiler_sec_pop(OSQP_PROFILER_SEC_ADMM_ITER);
@@ -560,7 +750,7 @@ OSQPInt osqp_solve(OSQPSolver *solver)
 #ifdef OSQP_ENABLE_INTERRUPT
 
     // Check the interrupt signal
-    if (osqp_is_interrupted())
+    if (!lean && osqp_is_interrupted())
     {
       update_status(solver->info, OSQP_SIGINT);
       c_print("Solver interrupted\n");
@@ -569,41 +759,77 @@ OSQPInt osqp_solve(OSQPSolver *solver)
     }
 #endif /* ifdef OSQP_ENABLE_INTERRUPT */
 
+#ifndef OSQP_EMBEDDED_MODE
+    // Another solver of the rho race finished first
+    if (race_stopped(work))
+      break;
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
 #ifdef OSQP_ENABLE_PROFILING
 
-    // Check if solver time_limit is enabled. In case, check if the current
-    // run time is more than the time_limit option.
-    if (work->first_run)
-    {
-      temp_run_time = solver->info->setup_time + osqp_toc(work->timer);
-    }
-    else
+    // Read the timer only at the iterations where a deadline could have been
+    // reached, see time_check_interval
+    time_checked = !lean && (iter >= next_time_check);
+    if (time_checked)
     {
-      temp_run_time = solver->info->update_time + osqp_toc(work->timer);
-    }
+      solve_run_time = osqp_toc(work->timer);
 
-    if (solver->settings->time_limit &&
-        (temp_run_time >= solver->settings->time_limit))
-    {
-      update_status(solver->info, OSQP_TIME_LIMIT_REACHED);
+      // Check if solver time_limit is enabled. In case, check if the current
+      // run time is more than the time_limit option.
+      if (work->first_run)
+      {
+        temp_run_time = solver->info->setup_time + solve_run_time;
+      }
+      else
+      {
+        temp_run_time = solver->info->update_time + solve_run_time;
+      }
+
+      if (solver->settings->time_limit &&
+          (temp_run_time >= solver->settings->time_limit))
+      {
+        update_status(solver->info, OSQP_TIME_LIMIT_REACHED);
 #ifdef OSQP_ENABLE_PRINTING
 
-      if (solver->settings->verbose)
-        c_print("run time limit reached\n");
-      can_print = 0; // Not printing at this iteration
-#endif               /* ifdef OSQP_ENABLE_PRINTING */
-      break;
+        if (solver->settings->verbose)
+          c_print("run time limit reached\n");
+        can_print = 0; // Not printing at this iteration
+#endif                 /* ifdef OSQP_ENABLE_PRINTING */
+        break;
+      }
+
+      // Deadlines: the time limit and, with the automatic rho interval, the
+      // fraction of the setup time after which the interval is fixed
+      time_left = solver->settings->time_limit - temp_run_time;
+      if (solver->settings->adaptive_rho && !solver->settings->adaptive_rho_interval)
+        time_left = c_min(time_left,
+                          solver->settings->adaptive_rho_fraction * solver->info->setup_time -
+                          solve_run_time);
+      next_time_check = iter + time_check_interval(solve_run_time, iter, time_left);
     }
 #endif /* ifdef OSQP_ENABLE_PROFILING */
 
     // Can we check for termination ?
+#if OSQP_EMBEDDED_MODE != 1
+    if (solver->settings->adaptive_termination)
+    {
+      // Check at the scheduled iteration, and at every rho update where the
+      // residuals are computed anyway
+      can_check_termination = solver->settings->check_termination &&
+                              ((iter >= next_check) ||
+                               (solver->settings->adaptive_rho &&
+                                solver->settings->adaptive_rho_interval &&
+                                (iter % solver->settings->adaptive_rho_interval == 0)));
+    }
+    else
+#endif
     can_check_termination = solver->settings->check_termination &&
                             (iter % solver->settings->check_termination == 0);
 
 #ifdef OSQP_ENABLE_PRINTING
 
     // Can we print ?
-    can_print = solver->settings->verbose &&
+    can_print = solver->settings->verbose && !lean &&
                 ((iter % OSQP_PRINT_INTERVAL == 0) || (iter == 1));
 
     // NB: We always update info in the first iteration because indirect solvers
@@ -628,6 +854,14 @@ OSQPInt osqp_solve(OSQPSolver *solver)
           // Terminate algorithm
           break;
         }
+#ifndef OSQP_EMBEDDED_MODE
+        // Stop if a speculative polish meets the tolerances
+        if (speculative && polish_speculative(solver))
+        {
+          spec_polished = 1;
+          break;
+        }
+#endif /* ifndef OSQP_EMBEDDED_MODE */
       }
     }
 #else  /* ifdef OSQP_ENABLE_PRINTING */
@@ -643,19 +877,31 @@ OSQPInt osqp_solve(OSQPSolver *solver)
         // Terminate algorithm
         break;
       }
+#ifndef OSQP_EMBEDDED_MODE
+      // Stop if a speculative polish meets the tolerances
+      if (speculative && polish_speculative(solver))
+      {
+        spec_polished = 1;
+        break;
+      }
+#endif /* ifndef OSQP_EMBEDDED_MODE */
     }
 #endif /* ifdef OSQP_ENABLE_PRINTING */
 
 #if OSQP_EMBEDDED_MODE != 1
+    // Schedule the next check from the convergence rate
+    if (can_check_termination && solver->settings->adaptive_termination)
+      next_check = iter + termination_check_interval(solver, iter);
+
 #ifdef OSQP_ENABLE_PROFILING
 
     // If adaptive rho with automatic interval, check if the solve time is a
     // certain fraction
     // of the setup time.
-    if (solver->settings->adaptive_rho && !solver->settings->adaptive_rho_interval)
+    if (time_checked && solver->settings->adaptive_rho && !solver->settings->adaptive_rho_interval)
     {
       // Check time
-      if (osqp_toc(work->timer) >
+      if (solve_run_time >
           solver->settings->adaptive_rho_fraction * solver->info->setup_time)
       {
         // Enough time has passed. We now get the number of iterations between
@@ -683,23 +929,12 @@ OSQPInt osqp_solve(OSQPSolver *solver)
             solver->settings->check_termination);
       } // If time condition is met
     } // If adaptive rho enabled and interval set to auto®
+
+    // Without the timer the interval cannot be measured
+    if (lean)
+      set_fixed_rho_interval(solver->settings);
 #else  // OSQP_ENABLE_PROFILING
-    if (solver->settings->adaptive_rho && !solver->settings->adaptive_rho_interval)
-    {
-      // Set adaptive_rho_interval to constant value
-      if (solver->settings->check_termination)
-      {
-        // If check_termination is enabled, we set it to a multiple of the check
-        // termination interval
-        solver->settings->adaptive_rho_interval = OSQP_ADAPTIVE_RHO_MULTIPLE_TERMINATION *
-                                                  solver->settings->check_termination;
-      }
-      else
-      {
-        // If check_termination is disabled we set it to a predefined fix number
-        solver->settings->adaptive_rho_interval = OSQP_ADAPTIVE_RHO_FIXED;
-      }
-    }
+    set_fixed_rho_interval(solver->settings);
 #endif // OSQP_ENABLE_PROFILING
 
     // Adapt rho
@@ -727,17 +962,65 @@ OSQPInt osqp_solve(OSQPSolver *solver)
 
       // Actually update rho
       osqp_profiler_event_mark(OSQP_PROFILER_EVENT_RHO_UPDATE);
+      rho_updates = solver->info->rho_updates;
       if (adapt_rho(solver))
       {
         c_eprint("Failed rho update");
         exitflag = 1;
         goto exit;
       }
+
+      // The convergence rate measured with the old rho no longer applies
+      if (solver->info->rho_updates != rho_updates)
+      {
+        work->term_iter_prev = 0;
+        next_check = c_min(next_check, iter + OSQP_CHECK_TERMINATION_MIN);
+#ifdef OSQP_ENABLE_PROFILING
+        // The refactorization can take much longer than an iteration
+        next_time_check = iter + 1;
+#endif /* ifdef OSQP_ENABLE_PROFILING */
+      }
+
+#ifndef OSQP_EMBEDDED_MODE
+      // The fixed-point map changed with rho
+      if (work->aa)
+        anderson_reset(work->aa);
+      if (work->nest)
+        nesterov_reset(work->nest);
+#endif /* ifndef OSQP_EMBEDDED_MODE */
     }
 #endif // OSQP_EMBEDDED_MODE != 1
 
+#ifndef OSQP_EMBEDDED_MODE
+    // Extrapolate the next iterate (the last one is kept as the plain ADMM step)
+    if (work->aa && iter < max_iter)
+      anderson_step(solver);
+    if (work->nest && iter < max_iter)
+      nesterov_step(solver);
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
   } // End of ADMM for loop
 
+#ifndef OSQP_EMBEDDED_MODE
+  // The final polish uses the polishing structure too
+  if (speculative)
+    polish_speculative_wait(solver);
+
+  // Continue from the solution of the replica that won the rho race
+  if (race_finish(solver))
+  {
+    exitflag = race_adopt(solver);
+    if (exitflag)
+    {
+      c_eprint("Failed rho update");
+      goto exit;
+    }
+
+    // Information and status are up to date
+    can_check_termination = 1;
+  }
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
   // Update information and check termination condition if it hasn't been done
   // during last iteration (max_iter reached or check_termination disabled)
   if (!can_check_termination)
@@ -760,7 +1043,7 @@ OSQPInt osqp_solve(OSQPSolver *solver)
 #ifdef OSQP_ENABLE_PRINTING
 
     /* Print summary */
-    if (solver->settings->verbose && !work->summary_printed)
+    if (solver->settings->verbose && !lean && !work->summary_printed)
       print_summary(solver);
 #endif /* ifdef OSQP_ENABLE_PRINTING */
 
@@ -777,7 +1060,7 @@ OSQPInt osqp_solve(OSQPSolver *solver)
 
 #ifdef OSQP_ENABLE_PRINTING
   /* Print summary for last iteration */
-  if (solver->settings->verbose && !work->summary_printed)
+  if (solver->settings->verbose && !lean && !work->summary_printed)
   {
     print_summary(solver);
   }
@@ -810,12 +1093,22 @@ OSQPInt osqp_solve(OSQPSolver *solver)
 
   /* Update solve time */
 #ifdef OSQP_ENABLE_PROFILING
-  solver->info->solve_time = osqp_toc(work->timer);
+  if (lean)
+  {
+    // Not measured in lean mode
+    solver->info->solve_time  = 0.0;
+    solver->info->polish_time = 0.0;
+  }
+  else
+  {
+    solver->info->solve_time = osqp_toc(work->timer);
+  }
 #endif /* ifdef OSQP_ENABLE_PROFILING */
 
 #ifndef OSQP_EMBEDDED_MODE
   // Polish the obtained solution
-  if (solver->settings->polishing && (solver->info->status_val == OSQP_SOLVED))
+  if (solver->settings->polishing && !lean && !spec_polished &&
+      (solver->info->status_val == OSQP_SOLVED))
   {
     osqp_profiler_sec_push(OSQP_PROFILER_SEC_POLISH);
     exitflag = polish(solver);
@@ -859,12 +1152,12 @@ OSQPInt osqp_solve(OSQPSolver *solver)
 
 #ifdef OSQP_ENABLE_PRINTING
   /* Print final footer */
-  if (solver->settings->verbose)
+  if (solver->settings->verbose && !lean)
     print_footer(solver->info, solver->settings->polishing);
 #endif /* ifdef OSQP_ENABLE_PRINTING */
 
   // Store solution
-  store_solution(solver, solver->solution);
+  store_solution(solver, solution);
 
 // Define exit flag for quitting function
 #if defined(OSQP_ENABLE_PROFILING) || defined(OSQP_ENABLE_INTERRUPT) || OSQP_EMBEDDED_MODE != 1
@@ -873,14 +1166,120 @@ exit:
 
 #ifdef OSQP_ENABLE_INTERRUPT
   // Restore previous signal handler
-  osqp_end_interrupt_listener();
+  if (listen)
+    osqp_end_interrupt_listener();
 #endif /* ifdef OSQP_ENABLE_INTERRUPT */
 
+#ifndef OSQP_EMBEDDED_MODE
+  // Do not leave a speculative polish running after an early exit
+  if (speculative)
+    polish_speculative_wait(solver);
+
+  // Keep the solution for the prediction of the next start
+  if (work->pred && !lean)
+    predict_record(solver);
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
   osqp_profiler_sec_pop(OSQP_PROFILER_SEC_OPT_SOLVE);
 
   return exitflag;
 }
 
+#if !defined(OSQP_EMBEDDED_MODE) && defined(OSQP_ENABLE_OPENMP)
+
+/* ADMM of replica k of the rho race, run as an OpenMP task */
+static void solve_race_replica(OSQPSolver *solver,
+                               OSQPInt     k)
+{
+  OSQPSolver *replica = race_replica(solver, k);
+
+  if (replica)
+    solve_admm(replica, OSQP_NULL, 1);
+}
+
+/* Race the main solver against replicas with different initial rho, each on
+ * its own thread */
+static OSQPInt solve_race(OSQPSolver *solver)
+{
+  OSQPInt exitflag;
+  OSQPInt k, nthreads;
+
+  // The replicas start from the predicted iterate too
+  if (solver->settings->warm_starting && solver->work->pred)
+    predict_start(solver);
+
+  exitflag = race_init(solver);
+  if (exitflag)
+    return exitflag;
+
+  // One more thread for the speculative polishes
+  nthreads = solver->settings->rho_racing;
+  if (solver->settings->polishing && solver->settings->polish_speculative)
+    nthreads++;
+
+#pragma omp parallel num_threads(nthreads)
+#pragma omp single
+  {
+    for (k = 1; k < solver->settings->rho_racing; k++)
+    {
+#pragma omp task firstprivate(k)
+      solve_race_replica(solver, k);
+    }
+
+    exitflag = solve_admm(solver, solver->solution, 0);
+
+    // Stop the replicas also if the main solver returned early
+    race_finish(solver);
+#pragma omp taskwait
+  }
+
+  race_end(solver->work);
+
+  return exitflag;
+}
+
+#endif /* if !defined(OSQP_EMBEDDED_MODE) && defined(OSQP_ENABLE_OPENMP) */
+
+OSQPInt osqp_solve(OSQPSolver *solver)
+{
+#if !defined(OSQP_EMBEDDED_MODE) && defined(OSQP_ENABLE_OPENMP)
+  OSQPInt exitflag;
+#endif
+
+  // Check if solver has been initialized
+  if (!solver || !solver->work)
+    return osqp_error(OSQP_WORKSPACE_NOT_INIT_ERROR);
+
+#if !defined(OSQP_EMBEDDED_MODE) && defined(OSQP_ENABLE_OPENMP)
+  if (solver->settings->rho_racing > 1)
+    return solve_race(solver);
+
+  // The speculative polishes run as tasks on a second thread. Parallel
+  // regions of the linear system solver inside the ADMM then run serially.
+  if (solver->settings->polishing && solver->settings->polish_speculative)
+  {
+    exitflag = 0;
+#pragma omp parallel num_threads(2)
+#pragma omp single
+    exitflag = solve_admm(solver, solver->solution, 0);
+
+    return exitflag;
+  }
+#endif
+
+  return solve_admm(solver, solver->solution, 0);
+}
+
+OSQPInt osqp_solve_lean(OSQPSolver   *solver,
+                        OSQPSolution *solution)
+{
+  // Check if solver has been initialized
+  if (!solver || !solver->work)
+    return osqp_error(OSQP_WORKSPACE_NOT_INIT_ERROR);
+
+  return solve_admm(solver, solution, 1);
+}
+
 OSQPInt osqp_get_solution(OSQPSolver *solver, OSQPSolution *solution)
 {
   if (!solver || !solver->work || !solver->settings || !solver->info)
@@ -954,11 +1353,24 @@ OSQPInt osqp_cleanup(OSQPSolver *solver)
     if (work->pol)
     {
       OSQPVectori_free(work->pol->active_flags);
+      OSQPVectori_free(work->pol->Ared_flags);
+      OSQPMatrix_free(work->pol->Ared);
+      if (work->pol->plsh)
+        work->pol->plsh->free(work->pol->plsh);
+      polish_scratch_free(work->pol->scratch);
+      polish_speculative_free(work->pol->spec);
       OSQPVectorf_free(work->pol->x);
       OSQPVectorf_free(work->pol->z);
       OSQPVectorf_free(work->pol->y);
       c_free(work->pol);
     }
+
+    anderson_free(work->aa);
+    nesterov_free(work->nest);
+    predict_free(work->pred);
+    race_free(work->race);
+    OSQPVectorf_free(work->rho_vec_new);
+    OSQPVectorf_free(work->rho_vec_tmp);
 #endif /* ifndef OSQP_EMBEDDED_MODE */
 
     // Free other Variables
@@ -1035,6 +1447,265 @@ OSQPInt osqp_cleanup(OSQPSolver *solver)
   return exitflag;
 }
 
+/* First instance of the block of thread w in a batch of nbatch instances */
+static OSQPInt batch_block_start(OSQPInt nbatch,
+                                 OSQPInt nthreads,
+                                 OSQPInt w)
+{
+  return (OSQPInt)(((long long)nbatch * w) / nthreads);
+}
+
+static void batch_copy_vec(OSQPFloat       *dst,
+                           const OSQPFloat *src,
+                           OSQPInt          len)
+{
+  OSQPInt i;
+
+  if (dst)
+  {
+    for (i = 0; i < len; i++)
+      dst[i] = src[i];
+  }
+}
+
+/* Set up the solver of a batch thread with the data of instance k */
+static OSQPInt batch_setup(OSQPSolver         **solverp,
+                           const OSQPCscMatrix *P,
+                           const OSQPFloat     *Px,
+                           const OSQPFloat     *q,
+                           const OSQPCscMatrix *A,
+                           const OSQPFloat     *Ax,
+                           const OSQPFloat     *l,
+                           const OSQPFloat     *u,
+                           OSQPInt              m,
+                           OSQPInt              n,
+                           const OSQPSettings  *settings,
+                           OSQPInt              k)
+{
+  OSQPInt       exitflag;
+  OSQPCscMatrix Pk = *P;
+  OSQPCscMatrix Ak = *A;
+
+  if (Px)
+    Pk.x = (OSQPFloat *)Px + (size_t)k * P->p[n];
+  if (Ax)
+    Ak.x = (OSQPFloat *)Ax + (size_t)k * A->p[n];
+
+  exitflag = osqp_setup(solverp, &Pk, q + (size_t)k * n, &Ak,
+                        l ? l + (size_t)k * m : OSQP_NULL,
+                        u ? u + (size_t)k * m : OSQP_NULL,
+                        m, n, settings);
+  if (!exitflag)
+    (*solverp)->work->batch = 1;
+
+  return exitflag;
+}
+
+/* Record instance k, which could not be set up, as failed with exitflag flag */
+static void batch_setup_failed(OSQPInt   k,
+                               OSQPInt   flag,
+                               OSQPInfo *infos,
+                               OSQPInt  *exitflags)
+{
+  static const OSQPInfo no_info; // all zero
+
+  if (infos)
+  {
+    infos[k] = no_info;
+    update_status(&infos[k], OSQP_UNSOLVED);
+  }
+  if (exitflags)
+    exitflags[k] = flag;
+}
+
+/* Solve the instances first <= k < last on one thread. The data of instance
+ * first is already in the solver. Returns the exitflag of the first failed
+ * instance. */
+static OSQPInt batch_solve_block(OSQPSolver       *solver,
+                                 const OSQPFloat  *Px,
+                                 const OSQPFloat  *q,
+                                 const OSQPFloat  *Ax,
+                                 const OSQPFloat  *l,
+                                 const OSQPFloat  *u,
+                                 OSQPInt           first,
+                                 OSQPInt           last,
+                                 OSQPSolution     *solutions,
+                                 OSQPInfo         *infos,
+                                 OSQPInt          *exitflags)
+{
+  OSQPInt k, flag;
+  OSQPInt exitflag = OSQP_NO_ERROR;
+  OSQPInt n        = solver->work->data->n;
+  OSQPInt m        = solver->work->data->m;
+  OSQPInt nnzP     = OSQPMatrix_get_nz(solver->work->data->P);
+  OSQPInt nnzA     = OSQPMatrix_get_nz(solver->work->data->A);
+
+  for (k = first; k < last; k++)
+  {
+    flag = OSQP_NO_ERROR;
+
+    // Numeric refactorization with the values of the instance
+    if (k > first)
+    {
+      if (Px || Ax)
+        flag = osqp_update_data_mat(solver,
+                                    Px ? Px + (size_t)k * nnzP : OSQP_NULL, OSQP_NULL, nnzP,
+                                    Ax ? Ax + (size_t)k * nnzA : OSQP_NULL, OSQP_NULL, nnzA);
+      if (!flag)
+        flag = osqp_update_data_vec(solver,
+                                    q + (size_t)k * n,
+                                    l ? l + (size_t)k * m : OSQP_NULL,
+                                    u ? u + (size_t)k * m : OSQP_NULL);
+    }
+    if (flag)
+    {
+      // The information of the previous instance may still be there
+      reset_info(solver->info);
+      update_status(solver->info, OSQP_UNSOLVED);
+    }
+    else
+      flag = osqp_solve(solver);
+
+    if (flag)
+    {
+      if (!exitflag)
+        exitflag = flag;
+    }
+    else if (solutions)
+    {
+      batch_copy_vec(solutions[k].x, solver->solution->x, n);
+      batch_copy_vec(solutions[k].y, solver->solution->y, m);
+      batch_copy_vec(solutions[k].prim_inf_cert, solver->solution->prim_inf_cert, m);
+      batch_copy_vec(solutions[k].dual_inf_cert, solver->solution->dual_inf_cert, n);
+    }
+
+    if (infos)
+      infos[k] = *solver->info;
+    if (exitflags)
+      exitflags[k] = flag;
+  }
+
+  return exitflag;
+}
+
+OSQPInt osqp_solve_batch(OSQPInt              nbatch,
+                         const OSQPCscMatrix *P,
+                         const OSQPFloat     *Px,
+                         const OSQPFloat     *q,
+                         const OSQPCscMatrix *A,
+                         const OSQPFloat     *Ax,
+                         const OSQPFloat     *l,
+                         const OSQPFloat     *u,
+                         OSQPInt              m,
+                         OSQPInt              n,
+                         const OSQPSettings  *settings,
+                         OSQPInt              nthreads,
+                         OSQPSolution        *solutions,
+                         OSQPInfo            *infos,
+                         OSQPInt             *exitflags)
+{
+  OSQPInt       exitflag = OSQP_NO_ERROR;
+  OSQPInt       w, flag, last;
+  OSQPInt      *flags;
+  OSQPInt      *firsts;
+  OSQPSolver  **workers;
+  OSQPSettings  batch_settings;
+
+  if (nbatch < 0 || !P || !A || !q || !settings)
+  {
+    c_eprint("Missing or invalid batch data");
+    return osqp_error(OSQP_DATA_VALIDATION_ERROR);
+  }
+  if (nbatch == 0)
+    return OSQP_NO_ERROR;
+
+#ifdef OSQP_ENABLE_OPENMP
+  if (nthreads <= 0)
+    nthreads = omp_get_max_threads();
+#else
+  nthreads = 1;
+#endif /* ifdef OSQP_ENABLE_OPENMP */
+  nthreads = c_min(nthreads, nbatch);
+
+  // The threads must not print over each other, and races and speculative
+  // polishes cannot get threads of their own inside a thread of the batch
+  batch_settings                    = *settings;
+  batch_settings.allocate_solution  = 1;
+  batch_settings.verbose            = 0;
+  batch_settings.rho_racing         = 0;
+  batch_settings.polish_speculative = 0;
+
+  workers = c_calloc(nthreads, sizeof(OSQPSolver *));
+  flags   = c_calloc(nthreads, sizeof(OSQPInt));
+  firsts  = c_calloc(nthreads, sizeof(OSQPInt));
+  if (!workers || !flags || !firsts)
+  {
+    c_free(workers);
+    c_free(flags);
+    c_free(firsts);
+    return osqp_error(OSQP_MEM_ALLOC_ERROR);
+  }
+
+  // Ordering and symbolic factorization of the shared pattern, once per thread,
+  // with the first instance of its block that can be set up
+  for (w = 0; w < nthreads; w++)
+  {
+    last = batch_block_start(nbatch, nthreads, w + 1);
+    for (firsts[w] = batch_block_start(nbatch, nthreads, w); firsts[w] < last; firsts[w]++)
+    {
+      flag = batch_setup(&workers[w], P, Px, q, A, Ax, l, u, m, n, &batch_settings,
+                         firsts[w]);
+      if (!flag)
+        break;
+
+      batch_setup_failed(firsts[w], flag, infos, exitflags);
+      if (!flags[w])
+        flags[w] = flag;
+
+      // A partially set up solver is freed before the next instance
+      osqp_cleanup(workers[w]);
+      workers[w] = OSQP_NULL;
+    }
+  }
+
+#ifdef OSQP_ENABLE_INTERRUPT
+  osqp_start_interrupt_listener();
+#endif /* ifdef OSQP_ENABLE_INTERRUPT */
+
+  // Each thread solves a contiguous block of instances in order
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp parallel for private(flag) num_threads(nthreads) schedule(static, 1)
+#endif /* ifdef OSQP_ENABLE_OPENMP */
+  for (w = 0; w < nthreads; w++)
+  {
+    // No instance of the block could be set up
+    if (!workers[w])
+      continue;
+
+    flag = batch_solve_block(workers[w], Px, q, Ax, l, u, firsts[w],
+                             batch_block_start(nbatch, nthreads, w + 1),
+                             solutions, infos, exitflags);
+    if (!flags[w])
+      flags[w] = flag;
+  }
+
+#ifdef OSQP_ENABLE_INTERRUPT
+  osqp_end_interrupt_listener();
+#endif /* ifdef OSQP_ENABLE_INTERRUPT */
+
+  // Blocks are in instance order
+  for (w = 0; w < nthreads && !exitflag; w++)
+    exitflag = flags[w];
+
+  for (w = 0; w < nthreads; w++)
+    osqp_cleanup(workers[w]);
+  c_free(workers);
+  c_free(flags);
+  c_free(firsts);
+
+  return exitflag;
+}
+
 #endif /* ifndef OSQP_EMBEDDED_MODE */
 
 /************************
@@ -1175,6 +1846,12 @@ OSQPInt osqp_warm_start(OSQPSolver *solver,
   /* Warm start the linear system solver */
   work->linsys_solver->warm_start(work->linsys_solver, work->x);
 
+#ifndef OSQP_EMBEDDED_MODE
+  /* Do not replace the given start with a prediction */
+  if (work->pred)
+    work->pred->user_start = 1;
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
   return 0;
 }
 
@@ -1209,6 +1886,15 @@ OSQPInt osqp_update_data_mat(OSQPSolver *solver,
     return osqp_error(OSQP_WORKSPACE_NOT_INIT_ERROR);
   work = solver->work;
 
+#ifndef OSQP_EMBEDDED_MODE
+  // Operators given to osqp_setup_operator have no values to update
+  if (OSQPMatrix_is_operator(work->data->P) || OSQPMatrix_is_operator(work->data->A))
+  {
+    c_eprint("P and A cannot be updated when given as operators");
+    return osqp_error(OSQP_FUNC_NOT_IMPLEMENTED);
+  }
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
 #ifdef OSQP_ENABLE_PROFILING
   if (work->clear_update_time == 1)
   {
@@ -1265,6 +1951,17 @@ OSQPInt osqp_update_data_mat(OSQPSolver *solver,
   if (solver->settings->scaling)
     scale_data(solver);
 
+#ifndef OSQP_EMBEDDED_MODE
+  // The cached polishing factorization needs the new values
+  work->pol->data_changed = 1;
+
+  // So do the factorizations of the rho race replicas
+  race_reset(work->race);
+
+  // The stored solutions are not on the path of the new problem
+  predict_reset(work->pred);
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
   // Update linear system structure with new data.
   // If there is scaling, then a full update is needed.
   if (solver->settings->scaling)
@@ -1443,23 +2140,35 @@ OSQPInt osqp_update_settings(OSQPSolver *solver,
 
   settings->verbose = new_settings->verbose;
   settings->warm_starting = new_settings->warm_starting;
+  // warm_start_predict ignored
   // scaling ignored
   settings->polishing = new_settings->polishing;
+#ifndef OSQP_EMBEDDED_MODE
+  // Polishing needs P and A in CSC form
+  if (OSQPMatrix_is_operator(solver->work->data->A))
+    settings->polishing = 0;
+#endif /* ifndef OSQP_EMBEDDED_MODE */
 
   // rho        ignored
   // rho_is_vec ignored
   // sigma      ignored
   settings->alpha = new_settings->alpha;
+  // anderson_mem ignored
+  // nesterov     ignored
 
   settings->cg_max_iter = new_settings->cg_max_iter;
   settings->cg_tol_reduction = new_settings->cg_tol_reduction;
   settings->cg_tol_fraction = new_settings->cg_tol_fraction;
   settings->cg_precond = new_settings->cg_precond;
+  settings->cg_block_size = new_settings->cg_block_size;
+  // cg_method  ignored
 
   // adaptive_rho           ignored
   // adaptive_rho_interval  ignored
   // adaptive_rho_fraction  ignored
   // adaptive_rho_tolerance ignored
+  // adaptive_rho_vec       ignored
+  settings->rho_racing = new_settings->rho_racing;
 
   settings->max_iter = new_settings->max_iter;
   settings->eps_abs = new_settings->eps_abs;
@@ -1468,10 +2177,21 @@ OSQPInt osqp_update_settings(OSQPSolver *solver,
   settings->eps_dual_inf = new_settings->eps_dual_inf;
   settings->scaled_termination = new_settings->scaled_termination;
   settings->check_termination = new_settings->check_termination;
+  settings->adaptive_termination = new_settings->adaptive_termination;
+  settings->check_infeasibility = new_settings->check_infeasibility;
+  settings->infeasibility_stall = new_settings->infeasibility_stall;
   settings->time_limit = new_settings->time_limit;
 
+#ifndef OSQP_EMBEDDED_MODE
+  // The cached polishing factorization was formed with the old delta
+  if (new_settings->delta != settings->delta)
+    solver->work->pol->data_changed = 1;
+#endif /* ifndef OSQP_EMBEDDED_MODE */
+
   settings->delta = new_settings->delta;
   settings->polish_refine_iter = new_settings->polish_refine_iter;
+  settings->polish_schur = new_settings->polish_schur;
+  settings->polish_speculative = new_settings->polish_speculative;
 
   /* Update settings in the linear system solver */
   solver->work->linsys_solver->update_settings(solver->work->linsys_solver, settings);
@@ -1506,6 +2226,11 @@ OSQPInt osqp_codegen(OSQPSolver *solver,
   {
     return osqp_error(OSQP_WORKSPACE_NOT_INIT_ERROR);
   }
+  /* Only the direct solver can be exported */
+  else if (solver->work->linsys_solver->type != OSQP_DIRECT_SOLVER)
+  {
+    return osqp_error(OSQP_FUNC_NOT_IMPLEMENTED);
+  }
   else if (!defines || (defines->embedded_mode != 1 && defines->embedded_mode != 2) || (defines->float_type != 0 && defines->float_type != 1) || (defines->printing_enable != 0 && defines->printing_enable != 1) || (defines->profiling_enable != 0 && defines->profiling_enable != 1) || (defines->interrupt_enable != 0 && defines->interrupt_enable != 1) || (defines->derivatives_enable != 0 && defines->derivatives_enable != 1))
   {
     return osqp_error(OSQP_CODEGEN_DEFINES_ERROR);
@@ -7,63 +7,156 @@
 #include "error.h"
 #include "timing.h"
 
+#ifdef OSQP_ENABLE_OPENMP
+# include <omp.h>
+#endif
+
+// Golden section iterations of the line search after a failed polish
+#define POLISH_LINE_SEARCH_ITER (20)
+
 /**
- * Form reduced matrix A that contains only rows that are active at the
- * solution.
- * Ared = vstack[Alow, Aupp]
- * Active constraints are guessed from the primal and dual solution returned by
- * the ADMM.
- * @param  work Workspace
- * @return      Exitflag
+ * Polishing system solved on the ADMM factorization
+ *
+ * The ADMM matrix K = [P + sigma*I, A'; A, -diag(1/rho)] becomes the (full
+ * space) polishing matrix after changing the diagonal of the constraint rows:
+ * -delta for the active rows, and an infinite value for the inactive ones,
+ * which fixes their dual variable to zero. With E selecting the k changed
+ * rows and Gamma the diagonal change,
+ *    (K + E*Gamma*E')^{-1} = K^{-1} - W * S^{-1} * E'*K^{-1},
+ * where W = K^{-1}*E and S = Gamma^{-1} + E'*W is a dense k x k matrix.
+ * Inactive rows have Gamma^{-1} = 0.
  */
-static OSQPInt form_Ared(OSQPWorkspace* work){
+typedef struct {
+  OSQPInt      k;     ///< rank of the diagonal change
+  OSQPInt      kmax;  ///< rank that rows, S, piv and W are allocated for
+  OSQPInt*     rows;  ///< constraints whose diagonal changes
+  OSQPInt*     flags; ///< copy of the active flags
+  OSQPFloat*   S;     ///< LU factors of the Schur complement (column major)
+  OSQPInt*     piv;   ///< row pivots of the LU factorization
+  OSQPFloat*   b2;    ///< lower part of the right-hand side
+  OSQPVectorf* W;     ///< K^{-1}*E, k stacked vectors (x, y) of length n+m
+  OSQPVectorf* u;     ///< full space right-hand side and solution
+} PolishSchur;
 
-  OSQPInt j, n_active;
-  OSQPInt m = work->data->m;
 
-  OSQPInt* active_flags = OSQP_NULL;
-  OSQPFloat* z = OSQP_NULL;
-  OSQPFloat* y = OSQP_NULL;
-  OSQPFloat* u = OSQP_NULL;
-  OSQPFloat* l = OSQP_NULL;
-
-  // Allocate raw arrays
-  active_flags = (OSQPInt *) c_malloc(m * sizeof(OSQPInt));
-  z = (OSQPFloat *) c_malloc(m * sizeof(OSQPFloat));
-  y = (OSQPFloat *) c_malloc(m * sizeof(OSQPFloat));
-  l = (OSQPFloat *) c_malloc(m * sizeof(OSQPFloat));
-  u = (OSQPFloat *) c_malloc(m * sizeof(OSQPFloat));
-
-  /* Handle memory allocation errors */
-  if (!active_flags || !z || !y || !l || !u) {
-    c_free(active_flags);
-    c_free(z);
-    c_free(y);
-    c_free(l);
-    c_free(u);
+/**
+ * Polishing workspace, allocated on the first polish and reused by the next
+ * ones. The reduced vectors of length n + n_active are views into vectors of
+ * the worst case length n + m.
+ */
+struct OSQPPolishScratch_ {
+  OSQPInt*     iwork;   ///< integer raw array (2m)
+  OSQPFloat*   fwork;   ///< float raw array (2n + 4m)
+  OSQPVectorf* rhs;     ///< storage of rhs_red
+  OSQPVectorf* sol;     ///< storage of sol_red
+  OSQPVectorf* ref;     ///< storage of ref_red
+  OSQPVectorf* rhs_red; ///< reduced right-hand side
+  OSQPVectorf* sol_red; ///< polished solution (x and reduced y)
+  OSQPVectorf* sol_x;   ///< x part of sol_red
+  OSQPVectorf* sol_y;   ///< reduced y part of sol_red
+  OSQPVectorf* ref_red; ///< right-hand side of the iterative refinement
+  OSQPVectorf* ref_x;   ///< upper part of ref_red
+  OSQPVectorf* ref_y;   ///< lower part of ref_red
+  PolishSchur  sc;      ///< Schur complement on the ADMM factorization
+};
+
+
+/* Free the buffers of the Schur complement */
+static void schur_free(PolishSchur* sc) {
+  c_free(sc->rows);
+  c_free(sc->flags);
+  c_free(sc->S);
+  c_free(sc->piv);
+  c_free(sc->b2);
+  OSQPVectorf_free(sc->W);
+  OSQPVectorf_free(sc->u);
+  sc->kmax  = 0;
+  sc->rows  = OSQP_NULL;
+  sc->flags = OSQP_NULL;
+  sc->S     = OSQP_NULL;
+  sc->piv   = OSQP_NULL;
+  sc->b2    = OSQP_NULL;
+  sc->W     = OSQP_NULL;
+  sc->u     = OSQP_NULL;
+}
 
-    return osqp_error(OSQP_MEM_ALLOC_ERROR);
+
+/* Allocate the polishing workspace; OSQP_NULL if out of memory */
+static OSQPPolishScratch* polish_scratch_new(OSQPWorkspace* work) {
+
+  OSQPInt n   = work->data->n;
+  OSQPInt m   = work->data->m;
+  OSQPInt len = n + m;
+
+  OSQPPolishScratch* ws = c_calloc(1, sizeof(OSQPPolishScratch));
+  if (!ws) return OSQP_NULL;
+
+  ws->iwork = c_malloc((2 * m + 1) * sizeof(OSQPInt));
+  ws->fwork = c_malloc((2 * n + 4 * m + 1) * sizeof(OSQPFloat));
+  ws->rhs   = OSQPVectorf_malloc(len);
+  ws->sol   = OSQPVectorf_malloc(len);
+  ws->ref   = OSQPVectorf_malloc(len);
+
+  if (!ws->iwork || !ws->fwork || !ws->rhs || !ws->sol || !ws->ref) {
+    polish_scratch_free(ws);
+    return OSQP_NULL;
   }
 
-  // Copy data to raw arrays
-  OSQPVectori_to_raw(active_flags, work->pol->active_flags);
-  OSQPVectorf_to_raw(z, work->z);
-  OSQPVectorf_to_raw(y, work->y);
-  OSQPVectorf_to_raw(l, work->data->l);
-  OSQPVectorf_to_raw(u, work->data->u);
+  ws->rhs_red = OSQPVectorf_view(ws->rhs, 0, len);
+  ws->sol_red = OSQPVectorf_view(ws->sol, 0, len);
+  ws->sol_x   = OSQPVectorf_view(ws->sol, 0, n);
+  ws->sol_y   = OSQPVectorf_view(ws->sol, n, m);
+  ws->ref_red = OSQPVectorf_view(ws->ref, 0, len);
+  ws->ref_x   = OSQPVectorf_view(ws->ref, 0, n);
+  ws->ref_y   = OSQPVectorf_view(ws->ref, n, m);
+
+  if (!ws->rhs_red || !ws->sol_red || !ws->sol_x || !ws->sol_y ||
+      !ws->ref_red || !ws->ref_x || !ws->ref_y) {
+    polish_scratch_free(ws);
+    return OSQP_NULL;
+  }
+
+  return ws;
+}
+
+
+void polish_scratch_free(OSQPPolishScratch* ws) {
+  if (ws) {
+    schur_free(&ws->sc);
+    OSQPVectorf_view_free(ws->rhs_red);
+    OSQPVectorf_view_free(ws->sol_red);
+    OSQPVectorf_view_free(ws->sol_x);
+    OSQPVectorf_view_free(ws->sol_y);
+    OSQPVectorf_view_free(ws->ref_red);
+    OSQPVectorf_view_free(ws->ref_x);
+    OSQPVectorf_view_free(ws->ref_y);
+    OSQPVectorf_free(ws->rhs);
+    OSQPVectorf_free(ws->sol);
+    OSQPVectorf_free(ws->ref);
+    c_free(ws->iwork);
+    c_free(ws->fwork);
+    c_free(ws);
+  }
+}
 
-  // Initialize counters for active constraints
-  n_active = 0;
 
-  /* Guess which linear constraints are lower-active, upper-active and free
-   *
-   *    active_flags is -1/0/1 to indicate  lower/ inactive / upper.
-   *    equality constraints are treated as lower active
-   *
-   *    Ared is formed by selecting all of the active rows.
+/* Guess which linear constraints are lower-active, upper-active and free from
+ * the raw z, y, l and u of length m. Returns the number of active ones. */
+static OSQPInt guess_active_set(OSQPInt          m,
+                                const OSQPFloat* z,
+                                const OSQPFloat* y,
+                                const OSQPFloat* l,
+                                const OSQPFloat* u,
+                                OSQPInt*         active_flags) {
+
+  OSQPInt j;
+  OSQPInt n_active = 0;
+
+  /* active_flags is -1/0/1 to indicate  lower/ inactive / upper.
+   * equality constraints are treated as lower active
    */
 
-  for (j = 0; j < work->data->m; j++) {
+  for (j = 0; j < m; j++) {
 
     if ((z[j] - l[j] < -y[j]) || (l[j] == u[j]) ) { // lower-active or equality
       active_flags[j] = -1;
@@ -78,24 +171,98 @@ static OSQPInt form_Ared(OSQPWorkspace* work){
     }
   }
 
+  return n_active;
+}
+
+/**
+ * Guess the constraints that are active at the solution from the primal and
+ * dual solution returned by the ADMM.
+ * @param  work Workspace
+ * @return      Exitflag
+ */
+static OSQPInt form_active_set(OSQPWorkspace* work){
+
+  OSQPInt m = work->data->m;
+
+  // Raw arrays in the polishing workspace
+  OSQPInt*   active_flags = work->pol->scratch->iwork;
+  OSQPFloat* z = work->pol->scratch->fwork;
+  OSQPFloat* y = z + m;
+  OSQPFloat* l = y + m;
+  OSQPFloat* u = l + m;
+
+  // Copy data to raw arrays
+  OSQPVectorf_to_raw(z, work->z);
+  OSQPVectorf_to_raw(y, work->y);
+  OSQPVectorf_to_raw(l, work->data->l);
+  OSQPVectorf_to_raw(u, work->data->u);
+
+  //total active constraints
+  work->pol->n_active = guess_active_set(m, z, y, l, u, active_flags);
+
   // Copy raw vector into OSQPVectori structure
   OSQPVectori_from_raw(work->pol->active_flags, active_flags);
 
-  //total active constraints
-  work->pol->n_active = n_active;
+  return OSQP_NO_ERROR;
+}
 
-  //extract the relevant rows
-  work->pol->Ared = OSQPMatrix_submatrix_byrows(work->data->A, work->pol->active_flags);
+/**
+ * Form reduced matrix A that contains only rows that are active at the
+ * solution.
+ * Ared = vstack[Alow, Aupp]
+ * Ared and the factorization of its reduced KKT matrix are kept between
+ * solves. Ared is formed again only if the active set or the values of P and A
+ * changed. In the latter case a direct factorization is refactored
+ * numerically on its existing pattern, any other one is dropped.
+ * @param  work Workspace
+ * @return      Exitflag
+ */
+static OSQPInt form_Ared(OSQPWorkspace* work){
+
+  OSQPInt j, same_set;
+  OSQPInt m = work->data->m;
+
+  OSQPPolish*   pol = work->pol;
+  LinSysSolver* plsh = pol->plsh;
+  OSQPInt*      flags = pol->scratch->iwork;
+  OSQPInt*      Ared_flags = flags + m;
+
+  OSQPVectori_to_raw(flags, pol->active_flags);
+  OSQPVectori_to_raw(Ared_flags, pol->Ared_flags);
+
+  same_set = (pol->Ared != OSQP_NULL);
+  for (j = 0; j < m && same_set; j++) {
+    if (flags[j] != Ared_flags[j]) same_set = 0;
+  }
+
+  if (same_set && !pol->data_changed) return OSQP_NO_ERROR;
 
-  // Memory clean-up
-  c_free(active_flags);
-  c_free(z);
-  c_free(y);
-  c_free(l);
-  c_free(u);
+  // The factorization of a different active set cannot be reused
+  if (plsh && (!same_set || plsh->type != OSQP_DIRECT_SOLVER)) {
+    plsh->free(plsh);
+    plsh = OSQP_NULL;
+  }
+
+  //extract the relevant rows
+  OSQPMatrix_free(pol->Ared);
+  pol->Ared = OSQPMatrix_submatrix_byrows(work->data->A, pol->active_flags);
+  OSQPVectori_from_raw(pol->Ared_flags, flags);
+  pol->data_changed = 0;
+
+  if (!pol->Ared) {
+    if (plsh) plsh->free(plsh);
+    pol->plsh = OSQP_NULL;
+    return osqp_error(OSQP_MEM_ALLOC_ERROR);
+  }
 
-  if (!work->pol->Ared)
-    return osqp_error(OSQP_MEM_ALLOC_ERROR);;
+  // Same active set with new values: numerical refactorization only
+  if (plsh && plsh->update_matrices(plsh,
+                                    work->data->P, OSQP_NULL, OSQPMatrix_get_nz(work->data->P),
+                                    pol->Ared, OSQP_NULL, OSQPMatrix_get_nz(pol->Ared))) {
+    plsh->free(plsh);
+    plsh = OSQP_NULL;
+  }
+  pol->plsh = plsh;
 
   return OSQP_NO_ERROR;
 }
@@ -111,30 +278,13 @@ static OSQPInt form_rhs_red(OSQPWorkspace* work, OSQPVectorf* rhs) {
   OSQPInt j, counter;
   OSQPInt n = work->data->n;
   OSQPInt m = work->data->m;
-  OSQPInt n_plus_mred = OSQPVectorf_length(rhs);
-
-  OSQPInt *active_flags = OSQP_NULL;
-  OSQPFloat* rhsv = OSQP_NULL;
-  OSQPFloat* q = OSQP_NULL;
-  OSQPFloat* l = OSQP_NULL;
-  OSQPFloat* u = OSQP_NULL;
-
-  // Allocate raw arrays
-  active_flags = (OSQPInt *)   c_malloc(m           * sizeof(OSQPInt));
-  rhsv         = (OSQPFloat *) c_malloc(n_plus_mred * sizeof(OSQPFloat));
-  q            = (OSQPFloat *) c_malloc(n           * sizeof(OSQPFloat));
-  l            = (OSQPFloat *) c_malloc(m           * sizeof(OSQPFloat));
-  u            = (OSQPFloat *) c_malloc(m           * sizeof(OSQPFloat));
 
-  if (!active_flags || !rhsv || !q || !l || !u) {
-    c_free(active_flags);
-    c_free(rhsv);
-    c_free(q);
-    c_free(l);
-    c_free(u);
-
-    return osqp_error(OSQP_MEM_ALLOC_ERROR);;
-  }
+  // Raw arrays in the polishing workspace (rhsv has at most n + m entries)
+  OSQPInt*   active_flags = work->pol->scratch->iwork;
+  OSQPFloat* rhsv = work->pol->scratch->fwork;
+  OSQPFloat* q = rhsv + n + m;
+  OSQPFloat* l = q + n;
+  OSQPFloat* u = l + m;
 
   // Copy data to raw arrays
   OSQPVectori_to_raw(active_flags, work->pol->active_flags);
@@ -163,84 +313,318 @@ static OSQPInt form_rhs_red(OSQPWorkspace* work, OSQPVectorf* rhs) {
   // Copy raw vector into OSQPVectorf structure
   OSQPVectorf_from_raw(rhs, rhsv);
 
-  // Memory clean-up
-  c_free(active_flags);
-  c_free(rhsv);
-  c_free(q);
-  c_free(l);
-  c_free(u);
-
   return OSQP_NO_ERROR;
 }
 
+/* LU factorization with partial pivoting of the k x k matrix S in place.
+ * Returns 1 if S is numerically singular. */
+static OSQPInt schur_lu(OSQPFloat* S,
+                        OSQPInt*   piv,
+                        OSQPInt    k) {
+
+  OSQPInt   i, j, l, p;
+  OSQPFloat s, smax = 0.0;
+
+  for (i = 0; i < k * k; i++) smax = c_max(smax, c_absval(S[i]));
+
+  for (j = 0; j < k; j++) {
+    p = j;
+    for (i = j + 1; i < k; i++)
+      if (c_absval(S[i + j*k]) > c_absval(S[p + j*k])) p = i;
+
+    if (!(c_absval(S[p + j*k]) > 1e-14 * smax)) return 1;
+
+    piv[j] = p;
+    if (p != j) {
+      for (l = 0; l < k; l++) {
+        s = S[j + l*k]; S[j + l*k] = S[p + l*k]; S[p + l*k] = s;
+      }
+    }
+
+    for (i = j + 1; i < k; i++) S[i + j*k] /= S[j + j*k];
+    for (l = j + 1; l < k; l++) {
+      s = S[j + l*k];
+      for (i = j + 1; i < k; i++) S[i + l*k] -= S[i + j*k] * s;
+    }
+  }
+  return 0;
+}
+
+
+/* Solve S t = t with the LU factors from schur_lu */
+static void schur_lu_solve(const OSQPFloat* S,
+                           const OSQPInt*   piv,
+                           OSQPInt          k,
+                           OSQPFloat*       t) {
+
+  OSQPInt   i, j;
+  OSQPFloat s;
+
+  for (j = 0; j < k; j++) {
+    s = t[j]; t[j] = t[piv[j]]; t[piv[j]] = s;
+    for (i = j + 1; i < k; i++) t[i] -= S[i + j*k] * t[j];
+  }
+  for (j = k - 1; j >= 0; j--) {
+    t[j] /= S[j + j*k];
+    for (i = 0; i < j; i++) t[i] -= S[i + j*k] * t[j];
+  }
+}
+
+
+/* Reciprocal of rho for constraint j */
+static OSQPFloat schur_rho_inv(const OSQPSolver* solver,
+                               const OSQPFloat*  rho_inv_vec,
+                               OSQPInt           j) {
+  return solver->settings->rho_is_vec ? rho_inv_vec[j] : solver->work->rho_inv;
+}
+
+
+/* Turn the solution (x, z_tilde) of the ADMM linear system with lower
+ * right-hand side b2 into the solution (x, y) of K (x, y) = (b1, b2) */
+static void schur_admm_dual(const OSQPSolver* solver,
+                            const OSQPFloat*  rho_inv_vec,
+                            OSQPFloat*        v,
+                            const OSQPFloat*  b2) {
+
+  OSQPInt j;
+  OSQPInt n = solver->work->data->n;
+  OSQPInt m = solver->work->data->m;
+
+  for (j = 0; j < m; j++)
+    v[n + j] = (v[n + j] - b2[j]) / schur_rho_inv(solver, rho_inv_vec, j);
+}
+
+
 /**
- * Perform iterative refinement on the polished solution:
- *    (repeat)
- *    1. (K + dK) * dz = b - K*z
- *    2. z <- z + dz
- * @param  work Solver workspace
- * @param  p    Private variable for solving linear system
- * @param  z    Initial z value
- * @param  b    RHS of the linear system
- * @return      Exitflag
+ * Prepare the Schur complement polishing on the ADMM factorization
+ * @param  solver Solver
+ * @return        Schur complement structure, or OSQP_NULL if the reduced KKT
+ *                has to be factorized instead (not a direct solver, rank
+ *                above polish_schur, singular Schur complement or out of memory)
+ *
+ * The buffers are kept in the polishing workspace and only grow when the rank
+ * exceeds the one they were allocated for.
  */
-static OSQPInt iterative_refinement(OSQPSolver*   solver,
-                                    LinSysSolver* p,
-                                    OSQPVectorf*  z,
-                                    OSQPVectorf*  b) {
-  OSQPInt i, mred;
-  OSQPVectorf *rhs, *rhs1, *rhs2;
-  OSQPVectorf *z1, *z2;
+static PolishSchur* schur_new(OSQPSolver* solver) {
+
+  OSQPInt i, j, k;
 
-  OSQPSettings*  settings = solver->settings;
   OSQPWorkspace* work     = solver->work;
+  OSQPSettings*  settings = solver->settings;
+  LinSysSolver*  linsys   = work->linsys_solver;
+  OSQPInt        n        = work->data->n;
+  OSQPInt        m        = work->data->m;
+  OSQPInt        len      = n + m;
+
+  PolishSchur*     sc = &work->pol->scratch->sc;
+  OSQPInt*         flags;
+  const OSQPFloat* rho_inv_vec = OSQP_NULL;
+  OSQPFloat        rho_inv;
+  OSQPFloat*       Wv;
+  OSQPFloat*       e;
+
+  if (settings->polish_schur == 0 || linsys->type != OSQP_DIRECT_SOLVER)
+    return OSQP_NULL;
+
+  // Buffers of fixed size
+  if (!sc->flags) {
+    sc->flags = c_malloc((m + 1) * sizeof(OSQPInt));
+    sc->b2    = c_malloc((m + 1) * sizeof(OSQPFloat));
+    sc->u     = OSQPVectorf_malloc(len);
+
+    if (!sc->flags || !sc->b2 || !sc->u) {
+      schur_free(sc);
+      return OSQP_NULL;
+    }
+  }
+  OSQPVectori_to_raw(sc->flags, work->pol->active_flags);
+  flags = sc->flags;
 
-  if (settings->polish_refine_iter > 0) {
-    mred = OSQPMatrix_get_m(work->pol->Ared);
+  if (settings->rho_is_vec) rho_inv_vec = OSQPVectorf_data(work->rho_inv_vec);
 
-    // Allocate dz and rhs vectors
-    rhs = OSQPVectorf_malloc(work->data->n + mred);
+  // Rows whose diagonal changes
+  k = 0;
+  for (j = 0; j < m; j++) {
+    rho_inv = schur_rho_inv(solver, rho_inv_vec, j);
+    if (!flags[j] || c_absval(rho_inv - settings->delta) > 1e-8 * settings->delta) k++;
+  }
+  if (k > settings->polish_schur) return OSQP_NULL;
+
+  // Buffers that grow with the rank
+  if (!sc->W || k > sc->kmax) {
+    c_free(sc->rows);
+    c_free(sc->S);
+    c_free(sc->piv);
+    OSQPVectorf_free(sc->W);
+
+    sc->kmax = k;
+    sc->rows = c_malloc((k + 1) * sizeof(OSQPInt));
+    sc->S    = c_malloc((k * k + 1) * sizeof(OSQPFloat));
+    sc->piv  = c_malloc((k + 1) * sizeof(OSQPInt));
+    sc->W    = OSQPVectorf_malloc(c_max(k, 1) * len);
+
+    if (!sc->rows || !sc->S || !sc->piv || !sc->W) {
+      schur_free(sc);
+      return OSQP_NULL;
+    }
+  }
 
-    //form views of the top/bottom parts of rhs and z
-    rhs1 = OSQPVectorf_view(rhs,0,work->data->n);
-    rhs2 = OSQPVectorf_view(rhs,work->data->n,mred);
-    z1   = OSQPVectorf_view(z,0,work->data->n);
-    z2   = OSQPVectorf_view(z,work->data->n,mred);
+  sc->k = k;
+  Wv    = OSQPVectorf_data(sc->W);
+  for (i = 0; i < k * len; i++) Wv[i] = 0.0;
+  for (j = 0; j < m; j++) sc->b2[j] = 0.0;
+
+  // Gamma^{-1} on the diagonal of S, unit vectors in the columns of W
+  for (i = 0; i < k * k; i++) sc->S[i] = 0.0;
+  i = 0;
+  for (j = 0; j < m; j++) {
+    rho_inv = schur_rho_inv(solver, rho_inv_vec, j);
+    if (!flags[j]) {
+      sc->rows[i++] = j;
+    }
+    else if (c_absval(rho_inv - settings->delta) > 1e-8 * settings->delta) {
+      sc->S[i + i*k] = 1.0 / (rho_inv - settings->delta);
+      sc->rows[i++]  = j;
+    }
+  }
+  for (i = 0; i < k; i++) Wv[i*len + n + sc->rows[i]] = 1.0;
 
-    if (!rhs || !rhs1 || !rhs2 || !z1 || !z2) {
-      return osqp_error(OSQP_MEM_ALLOC_ERROR);
+  // W = K^{-1}*E
+  if (linsys->solve_multi) {
+    linsys->solve_multi(linsys, sc->W, k);
+  }
+  else {
+    for (i = 0; i < k; i++) {
+      OSQPVectorf_from_raw(sc->u, Wv + i*len);
+      linsys->solve(linsys, sc->u, 1);
+      OSQPVectorf_to_raw(Wv + i*len, sc->u);
     }
+  }
 
-    for (i = 0; i < settings->polish_refine_iter; i++) {
+  // S = Gamma^{-1} + E'*W
+  for (i = 0; i < k; i++) {
+    e = sc->b2;
+    e[sc->rows[i]] = 1.0;
+    schur_admm_dual(solver, rho_inv_vec, Wv + i*len, e);
+    e[sc->rows[i]] = 0.0;
 
-      // Form the RHS for the iterative refinement:  b - K*z
-      OSQPVectorf_copy(rhs,b);
+    for (j = 0; j < k; j++) sc->S[j + i*k] += Wv[i*len + n + sc->rows[j]];
+  }
 
-      // Upper Part: R^{n}
-      // -= Px  (in the top partition)
-      OSQPMatrix_Axpy(work->data->P, z1, rhs1, -1.0, 1.0);
+  if (schur_lu(sc->S, sc->piv, k)) return OSQP_NULL;
 
-      // -= Ared'*y_red  (in the top partition)
-      OSQPMatrix_Atxpy(work->pol->Ared, z2, rhs1, -1.0, 1.0);
+  return sc;
+}
 
-      // Lower Part: R^{m}
-      // -= A*x  (in the bottom partition)
-      OSQPMatrix_Axpy(work->pol->Ared, z1, rhs2, -1.0, 1.0);
 
-      // Solve linear system. Store solution in rhs
-      p->solve(p, rhs, 1);
+/**
+ * Solve the reduced polishing system with the Schur complement
+ * @param solver Solver
+ * @param sc     Schur complement structure
+ * @param b      Right-hand side (x, reduced y); overwritten with the solution
+ */
+static void schur_solve(OSQPSolver*  solver,
+                        PolishSchur* sc,
+                        OSQPVectorf* b) {
+
+  OSQPInt i, j, l, counter;
+
+  OSQPWorkspace*   work  = solver->work;
+  OSQPInt          n     = work->data->n;
+  OSQPInt          m     = work->data->m;
+  OSQPInt          len   = n + m;
+  const OSQPInt*   flags = sc->flags;
+  const OSQPFloat* rho_inv_vec = OSQP_NULL;
+  OSQPFloat*       bv    = OSQPVectorf_data(b);
+  OSQPFloat*       uv    = OSQPVectorf_data(sc->u);
+  const OSQPFloat* Wv    = OSQPVectorf_data(sc->W);
+  OSQPFloat        t;
+
+  if (solver->settings->rho_is_vec) rho_inv_vec = OSQPVectorf_data(work->rho_inv_vec);
+
+  // Scatter the reduced right-hand side into the full space
+  for (j = 0; j < n; j++) uv[j] = bv[j];
+  counter = 0;
+  for (j = 0; j < m; j++) {
+    sc->b2[j] = flags[j] ? bv[n + counter++] : 0.0;
+    uv[n + j] = sc->b2[j];
+  }
 
-      // Update solution
-      OSQPVectorf_plus(z,z,rhs);
-    }
+  // u = K^{-1}*b
+  work->linsys_solver->solve(work->linsys_solver, sc->u, 1);
+  schur_admm_dual(solver, rho_inv_vec, uv, sc->b2);
 
-    OSQPVectorf_free(rhs);
-    OSQPVectorf_view_free(rhs1);
-    OSQPVectorf_view_free(rhs2);
-    OSQPVectorf_view_free(z1);
-    OSQPVectorf_view_free(z2);
+  // u -= W * S^{-1} * E'*u   (b2 holds the k multipliers)
+  for (i = 0; i < sc->k; i++) sc->b2[i] = uv[n + sc->rows[i]];
+  schur_lu_solve(sc->S, sc->piv, sc->k, sc->b2);
+  for (i = 0; i < sc->k; i++) {
+    t = sc->b2[i];
+    for (l = 0; l < len; l++) uv[l] -= t * Wv[i*len + l];
+  }
+
+  // Gather the solution (x, reduced y)
+  for (j = 0; j < n; j++) bv[j] = uv[j];
+  counter = 0;
+  for (j = 0; j < m; j++)
+    if (flags[j]) bv[n + counter++] = uv[n + j];
+}
+
+
+/* Solve the reduced polishing system with either its own factorization or
+ * the Schur complement on the ADMM factorization */
+static void polish_kkt_solve(OSQPSolver*   solver,
+                             LinSysSolver* p,
+                             PolishSchur*  sc,
+                             OSQPVectorf*  b) {
+  if (sc)
+    schur_solve(solver, sc, b);
+  else
+    p->solve(p, b, 1);
+}
+
+
+/**
+ * Perform iterative refinement on the polished solution:
+ *    (repeat)
+ *    1. (K + dK) * dz = b - K*z
+ *    2. z <- z + dz
+ * z and b are the polished solution and reduced right-hand side in the
+ * polishing workspace.
+ * @param  work Solver workspace
+ * @param  p    Private variable for solving linear system
+ * @param  sc   Schur complement on the ADMM factorization (used instead of p if not OSQP_NULL)
+ */
+static void iterative_refinement(OSQPSolver*   solver,
+                                 LinSysSolver* p,
+                                 PolishSchur*  sc) {
+  OSQPInt i;
+
+  OSQPSettings*      settings = solver->settings;
+  OSQPWorkspace*     work     = solver->work;
+  OSQPPolishScratch* ws       = work->pol->scratch;
+
+  for (i = 0; i < settings->polish_refine_iter; i++) {
+
+    // Form the RHS for the iterative refinement:  b - K*z
+    OSQPVectorf_copy(ws->ref_red, ws->rhs_red);
+
+    // Upper Part: R^{n}
+    // -= Px  (in the top partition)
+    OSQPMatrix_Axpy(work->data->P, ws->sol_x, ws->ref_x, -1.0, 1.0);
+
+    // -= Ared'*y_red  (in the top partition)
+    OSQPMatrix_Atxpy(work->pol->Ared, ws->sol_y, ws->ref_x, -1.0, 1.0);
+
+    // Lower Part: R^{m}
+    // -= A*x  (in the bottom partition)
+    OSQPMatrix_Axpy(work->pol->Ared, ws->sol_x, ws->ref_y, -1.0, 1.0);
+
+    // Solve linear system. Store solution in ref_red
+    polish_kkt_solve(solver, p, sc, ws->ref_red);
+
+    // Update solution
+    OSQPVectorf_plus(ws->sol_red, ws->sol_red, ws->ref_red);
   }
-  return 0;
 }
 
 /**
@@ -253,25 +637,11 @@ static OSQPInt get_ypol_from_yred(OSQPWorkspace* work, OSQPVectorf* yred_vf) {
 
   OSQPInt j, counter;
   OSQPInt m = work->data->m;
-  OSQPInt mred = OSQPVectorf_length(yred_vf);
-
-  OSQPInt *active_flags = OSQP_NULL;
-  OSQPFloat* y = OSQP_NULL;
-  OSQPFloat* yred = OSQP_NULL;
 
-  // Allocate raw arrays
-  active_flags = (OSQPInt *)   c_malloc(m    * sizeof(OSQPInt));
-  y            = (OSQPFloat *) c_malloc(m    * sizeof(OSQPFloat));
-  yred         = (OSQPFloat *) c_malloc(mred * sizeof(OSQPFloat));
-
-  if (!active_flags || !y || !yred) {
-    // Memory clean-up
-    c_free(active_flags);
-    c_free(y);
-    c_free(yred);
-
-    return osqp_error(OSQP_MEM_ALLOC_ERROR);;
-  }
+  // Raw arrays in the polishing workspace
+  OSQPInt*   active_flags = work->pol->scratch->iwork;
+  OSQPFloat* y = work->pol->scratch->fwork;
+  OSQPFloat* yred = y + m;
 
   // Copy data to raw arrays
   OSQPVectori_to_raw(active_flags, work->pol->active_flags);
@@ -282,11 +652,6 @@ static OSQPInt get_ypol_from_yred(OSQPWorkspace* work, OSQPVectorf* yred_vf) {
   if (work->pol->n_active == 0) {
     OSQPVectorf_set_scalar(work->pol->y, 0.);
 
-    // Memory clean-up
-    c_free(active_flags);
-    c_free(y);
-    c_free(yred);
-
     return OSQP_NO_ERROR;
   }
 
@@ -306,24 +671,151 @@ static OSQPInt get_ypol_from_yred(OSQPWorkspace* work, OSQPVectorf* yred_vf) {
   // Copy raw vector into OSQPVectorf structure
   OSQPVectorf_from_raw(work->pol->y, y);
 
-  // Memory clean-up
-  c_free(active_flags);
-  c_free(y);
-  c_free(yred);
-
   return OSQP_NO_ERROR;
 }
 
+/* Whether the residuals at the polished solution improve on the ADMM ones */
+static OSQPInt polish_improved(const OSQPSolver* solver) {
+
+  const OSQPInfo*   info = solver->info;
+  const OSQPPolish* pol  = solver->work->pol;
+
+  return (pol->prim_res < info->prim_res &&
+          pol->dual_res < info->dual_res) ||  // Residuals are reduced
+         (pol->prim_res < info->prim_res &&
+          info->dual_res < 1e-10) ||          // Dual residual already tiny
+         (pol->dual_res < info->dual_res &&
+          info->prim_res < 1e-10);            // Primal residual already tiny
+}
+
+
+/* Norm of a primal or dual residual vector as reported in the info */
+static OSQPFloat line_search_norm(const OSQPSolver*  solver,
+                                  const OSQPVectorf* v,
+                                  OSQPInt            dual) {
+
+  const OSQPScaling* scaling = solver->work->scaling;
+
+  if (solver->settings->scaling && !solver->settings->scaled_termination) {
+    if (dual)
+      return scaling->cinv * OSQPVectorf_scaled_norm_inf(scaling->Dinv, v);
+    else
+      return OSQPVectorf_scaled_norm_inf(scaling->Einv, v);
+  }
+  return OSQPVectorf_norm_inf(v);
+}
+
+
+/* Residuals at (1-t)*ADMM + t*polished solution, relative to the ADMM ones.
+ * The residual vectors at both ends are in x_prev/z_prev and ref_x/ref_y. */
+static OSQPFloat line_search_merit(const OSQPSolver* solver,
+                                   OSQPFloat         t,
+                                   OSQPFloat         prim_res0,
+                                   OSQPFloat         dual_res0) {
+
+  OSQPWorkspace*     work = solver->work;
+  OSQPPolishScratch* ws   = work->pol->scratch;
+
+  OSQPVectorf_add_scaled(ws->sol_x, 1.0 - t, work->x_prev, t, ws->ref_x);
+  OSQPVectorf_add_scaled(ws->sol_y, 1.0 - t, work->z_prev, t, ws->ref_y);
+
+  return c_max(line_search_norm(solver, ws->sol_y, 0) / prim_res0,
+               line_search_norm(solver, ws->sol_x, 1) / dual_res0);
+}
+
+
+/**
+ * Line search on the segment from the ADMM solution (t = 0) to the polished
+ * solution (t = 1) after a failed polish.
+ *
+ * The primal and dual residuals of (1-t)*(x, z, y) + t*(x, z, y)_pol are
+ * affine in t. They are formed once at both ends, so that every candidate
+ * only costs a few vector operations. The merit function
+ *    phi(t) = max(prim_res(t) / prim_res(0), dual_res(t) / dual_res(0))
+ * is convex and minimized by golden section search; phi(t) < 1 means that
+ * both residuals are reduced.
+ * @param  solver Solver
+ * @return        1 if the polished solution and its residuals were replaced
+ *                by the minimizer of phi, 0 if phi(t) >= 1 on the segment
+ */
+static OSQPInt line_search(OSQPSolver* solver) {
+
+  OSQPInt i;
+  OSQPFloat a, b, c, d, fc, fd, t;
+  OSQPFloat prim_res0, dual_res0;
+
+  OSQPWorkspace*     work = solver->work;
+  OSQPPolish*        pol  = work->pol;
+  OSQPPolishScratch* ws   = pol->scratch;
+  OSQPInt            n    = work->data->n;
+  OSQPInt            m    = work->data->m;
+  const OSQPFloat    g    = 0.5 * (c_sqrt(5.0) - 1.0);
+
+  // The polishing workspace vectors are free after the polish
+  OSQPVectorf_view_update(ws->sol_y, ws->sol, n, m);
+  OSQPVectorf_view_update(ws->ref_y, ws->ref, n, m);
+
+  // Residual vectors at the polished solution, left by update_info
+  OSQPVectorf_copy(ws->ref_x, work->x_prev);
+  OSQPVectorf_copy(ws->ref_y, work->z_prev);
+
+  // Residual vectors at the ADMM solution: Ax - z and q + Px + A'y
+  OSQPMatrix_Axpy(work->data->A, work->x, work->z_prev, 1.0, 0.0);
+  OSQPVectorf_minus(work->z_prev, work->z_prev, work->z);
+  OSQPVectorf_copy(work->x_prev, work->data->q);
+  OSQPMatrix_Axpy(work->data->P, work->x, work->x_prev, 1.0, 1.0);
+  OSQPMatrix_Atxpy(work->data->A, work->y, work->x_prev, 1.0, 1.0);
+
+  prim_res0 = c_max(line_search_norm(solver, work->z_prev, 0), 1e-10);
+  dual_res0 = c_max(line_search_norm(solver, work->x_prev, 1), 1e-10);
+
+  // Golden section search on [0, 1]
+  a  = 0.0;
+  b  = 1.0;
+  c  = b - g * (b - a);
+  d  = a + g * (b - a);
+  fc = line_search_merit(solver, c, prim_res0, dual_res0);
+  fd = line_search_merit(solver, d, prim_res0, dual_res0);
+
+  for (i = 0; i < POLISH_LINE_SEARCH_ITER; i++) {
+    if (fc < fd) {
+      b  = d;
+      d  = c;
+      fd = fc;
+      c  = b - g * (b - a);
+      fc = line_search_merit(solver, c, prim_res0, dual_res0);
+    }
+    else {
+      a  = c;
+      c  = d;
+      fc = fd;
+      d  = a + g * (b - a);
+      fd = line_search_merit(solver, d, prim_res0, dual_res0);
+    }
+  }
+
+  t = (fc < fd) ? c : d;
+  if (!(c_min(fc, fd) < 1.0)) return 0;
+
+  // Move the polished solution to the minimizer and compute its residuals
+  OSQPVectorf_add_scaled(pol->x, 1.0 - t, work->x, t, pol->x);
+  OSQPVectorf_add_scaled(pol->z, 1.0 - t, work->z, t, pol->z);
+  OSQPVectorf_add_scaled(pol->y, 1.0 - t, work->y, t, pol->y);
+  update_info(solver, 0, 1, 1);
+
+  return 1;
+}
+
+
 OSQPInt polish(OSQPSolver* solver) {
 
   OSQPInt polish_successful = 0;
   OSQPInt exitflag = 0;
+  OSQPInt n_active;
 
-  LinSysSolver* plsh = OSQP_NULL;
-  OSQPVectorf*  rhs_red = OSQP_NULL;
-  OSQPVectorf*  pol_sol = OSQP_NULL; // Polished solution (x and reduced y)
-  OSQPVectorf*  pol_sol_xview = OSQP_NULL; // view into x part of polished solution
-  OSQPVectorf*  pol_sol_yview = OSQP_NULL; // view into (reduced) y part of polished solutions
+  LinSysSolver*      plsh = OSQP_NULL;
+  PolishSchur*       schur = OSQP_NULL;
+  OSQPPolishScratch* ws;
 
   OSQPInfo*      info     = solver->info;
   OSQPSettings*  settings = solver->settings;
@@ -333,8 +825,19 @@ OSQPInt polish(OSQPSolver* solver) {
   osqp_tic(work->timer); // Start timer
 #endif /* ifdef OSQP_ENABLE_PROFILING */
 
-  // Form Ared by assuming the active constraints and store in work->pol->Ared
-  exitflag = form_Ared(work);
+  // Workspace sized for the worst case, kept for the next polishes
+  if (!work->pol->scratch) {
+    work->pol->scratch = polish_scratch_new(work);
+
+    if (!work->pol->scratch) {
+      info->status_polish = OSQP_POLISH_FAILED;
+      return osqp_error(OSQP_MEM_ALLOC_ERROR);
+    }
+  }
+  ws = work->pol->scratch;
+
+  // Guess the active constraints and store them in work->pol->active_flags
+  exitflag = form_active_set(work);
 
   if (exitflag) {
     /* Failure finding active constraints */
@@ -345,109 +848,71 @@ OSQPInt polish(OSQPSolver* solver) {
     c_print("Polishing not needed - no active set detected at optimal point\n");
     info->status_polish = OSQP_POLISH_NO_ACTIVE_SET_FOUND;
 
-    /* Memory clean-up */
-    OSQPMatrix_free(work->pol->Ared);
-
     return OSQP_NO_ERROR;
   }
 
-  // Form and factorize reduced KKT
-  exitflag = osqp_algebra_init_linsys_solver(&plsh, work->data->P, work->pol->Ared,
-                                             OSQP_NULL, settings, OSQP_NULL, OSQP_NULL, 1);
+  // Form Ared for the active set (reused if the active set did not change)
+  exitflag = form_Ared(work);
 
   if (exitflag) {
-    /* Failure to initialize the linear system */
-    info->status_polish = OSQP_POLISH_LINSYS_ERROR;
-
-    /* Memory clean-up */
-    OSQPMatrix_free(work->pol->Ared);
-
+    /* Failure forming the reduced matrix */
+    info->status_polish = OSQP_POLISH_FAILED;
     return exitflag;
   }
 
-  // Form reduced right-hand side rhs_red
-  rhs_red = OSQPVectorf_malloc(work->data->n + work->pol->n_active);
-
-  if (!rhs_red) {
-    /* Failure to allocate memory */
-    info->status_polish = OSQP_POLISH_FAILED;
-
-    /* Memory clean-up */
-    OSQPMatrix_free(work->pol->Ared);
-
-    return osqp_error(OSQP_MEM_ALLOC_ERROR);
-  }
+  // Reuse the ADMM factorization if the Schur complement is small enough,
+  // otherwise form and factorize reduced KKT unless its factorization is cached
+  schur = schur_new(solver);
 
-  exitflag = form_rhs_red(work, rhs_red);
+  if (!schur && !work->pol->plsh)
+    exitflag = osqp_algebra_init_linsys_solver(&work->pol->plsh, work->data->P, work->pol->Ared,
+                                               OSQP_NULL, settings, OSQP_NULL, OSQP_NULL, 1);
+  else if (!schur)
+    work->pol->plsh->update_settings(work->pol->plsh, settings);
 
   if (exitflag) {
-    /* Failure to form reduced right hand side */
-    info->status_polish = OSQP_POLISH_FAILED;
-
-    /* Memory clean-up */
-    OSQPMatrix_free(work->pol->Ared);
+    /* Failure to initialize the linear system */
+    info->status_polish = OSQP_POLISH_LINSYS_ERROR;
+    work->pol->plsh = OSQP_NULL;
 
     return exitflag;
   }
 
-  pol_sol = OSQPVectorf_copy_new(rhs_red);
-
-  if (!pol_sol) {
-    /* Failure to allocate vector */
-    info->status_polish = OSQP_POLISH_FAILED;
-
-    /* Memory clean-up */
-    OSQPMatrix_free(work->pol->Ared);
-    OSQPVectorf_free(rhs_red);
-
-    return osqp_error(OSQP_MEM_ALLOC_ERROR);
-  }
+  if (!schur)
+    plsh = work->pol->plsh;
 
-  pol_sol_xview = OSQPVectorf_view(pol_sol,0,work->data->n);
-  pol_sol_yview = OSQPVectorf_view(pol_sol,work->data->n, work->pol->n_active);
+  // Point the reduced vectors to the first n + n_active entries
+  n_active = work->pol->n_active;
+  OSQPVectorf_view_update(ws->rhs_red, ws->rhs, 0, work->data->n + n_active);
+  OSQPVectorf_view_update(ws->sol_red, ws->sol, 0, work->data->n + n_active);
+  OSQPVectorf_view_update(ws->sol_y,   ws->sol, work->data->n, n_active);
+  OSQPVectorf_view_update(ws->ref_red, ws->ref, 0, work->data->n + n_active);
+  OSQPVectorf_view_update(ws->ref_y,   ws->ref, work->data->n, n_active);
 
-  if (!pol_sol_xview || !pol_sol_yview) {
+  // Form reduced right-hand side rhs_red
+  exitflag = form_rhs_red(work, ws->rhs_red);
 
-    // Polishing failed
+  if (exitflag) {
+    /* Failure to form reduced right hand side */
     info->status_polish = OSQP_POLISH_FAILED;
-
-    // Memory clean-up
-    OSQPMatrix_free(work->pol->Ared);
-    OSQPVectorf_free(rhs_red);
-    OSQPVectorf_free(pol_sol);
-    OSQPVectorf_view_free(pol_sol_xview);
-    OSQPVectorf_view_free(pol_sol_yview);
-
-    return osqp_error(OSQP_MEM_ALLOC_ERROR);
+    return exitflag;
   }
 
+  OSQPVectorf_copy(ws->sol_red, ws->rhs_red);
+
   // Warm start the polished solution
-  plsh->warm_start(plsh, work->x);
+  if (plsh) plsh->warm_start(plsh, work->x);
 
   // Solve the reduced KKT system
-  plsh->solve(plsh, pol_sol, 1);
+  polish_kkt_solve(solver, plsh, schur, ws->sol_red);
 
   // Perform iterative refinement to compensate for the regularization error
-  exitflag = iterative_refinement(solver, plsh, pol_sol, rhs_red);
-
-  if (exitflag) {
-    // Polishing failed
-    info->status_polish = OSQP_POLISH_FAILED;
-
-    // Memory clean-up
-    OSQPMatrix_free(work->pol->Ared);
-    OSQPVectorf_free(rhs_red);
-    OSQPVectorf_free(pol_sol);
-    OSQPVectorf_view_free(pol_sol_xview);
-    OSQPVectorf_view_free(pol_sol_yview);
-
-    return exitflag;
-  }
+  iterative_refinement(solver, plsh, schur);
 
   // Store the polished solution (x,z,y)
-  OSQPVectorf_copy(work->pol->x, pol_sol_xview);   // pol->x
+  OSQPVectorf_copy(work->pol->x, ws->sol_x);   // pol->x
   OSQPMatrix_Axpy(work->data->A, work->pol->x, work->pol->z, 1.0, 0.0);
-  get_ypol_from_yred(work, pol_sol_yview);     // pol->y
+  get_ypol_from_yred(work, ws->sol_y);         // pol->y
 
   // Ensure z is in C and y is in the normal cone N_C(z)
   // by doing: y <- y + z;  z <- proj_C(y);  y <- y - z
@@ -458,21 +923,12 @@ OSQPInt polish(OSQPSolver* solver) {
   // Compute primal and dual residuals at the polished solution
   update_info(solver, 0, 1, 1);
 
-  // Check if polish was successful
-  polish_successful = (work->pol->prim_res < info->prim_res &&
-                       work->pol->dual_res < info->dual_res) || // Residuals
-                                                                    // are
-                                                                    // reduced
-                      (work->pol->prim_res < info->prim_res &&
-                       info->dual_res < 1e-10) ||              // Dual
-                                                                    // residual
-                                                                    // already
-                                                                    // tiny
-                      (work->pol->dual_res < info->dual_res &&
-                       info->prim_res < 1e-10);                // Primal
-                                                                    // residual
-                                                                    // already
-                                                                    // tiny
+  // Check if polish was successful, otherwise try a point between the ADMM
+  // and polished solutions
+  polish_successful = polish_improved(solver);
+
+  if (!polish_successful && line_search(solver))
+    polish_successful = polish_improved(solver);
 
   if (polish_successful) {
     // Update solver information
@@ -494,20 +950,282 @@ OSQPInt polish(OSQPSolver* solver) {
 #endif /* ifdef OSQP_ENABLE_PRINTING */
   } else { // Polishing failed
     info->status_polish = OSQP_POLISH_FAILED;
+  }
 
-    // TODO: Try to find a better solution on the line connecting ADMM
-    //       and polished solution
+  return OSQP_NO_ERROR;
+}
+
+
+/**
+ * Speculative polishing state
+ *
+ * The polish runs on a snapshot of the ADMM iterate through a solver that
+ * shares the problem data, the scaling and the polishing structure with the
+ * main one, but has its own iterates, work vectors, settings, information and
+ * timer, so that the ADMM can continue on another thread.
+ */
+struct OSQPPolishSpec_ {
+  OSQPSolver     solver;         ///< solver of the speculative polish
+  OSQPWorkspace  work;           ///< copy of the main workspace with the vectors below
+  OSQPSettings   settings;       ///< copy of the main settings without printing
+  OSQPInfo       info;           ///< information of the speculative polish
+  OSQPVectorf*   x;              ///< snapshot of x, polished x on success
+  OSQPVectorf*   z;              ///< snapshot of z, polished z on success
+  OSQPVectorf*   y;              ///< snapshot of y, polished y on success
+  OSQPVectorf*   x_prev;         ///< work vectors of the residuals
+  OSQPVectorf*   z_prev;
+  OSQPVectorf*   Ax;
+  OSQPVectorf*   Px;
+  OSQPVectorf*   Aty;
+#ifdef OSQP_ENABLE_PROFILING
+  OSQPTimer*     timer;          ///< timer of the speculative polish
+#endif /* ifdef OSQP_ENABLE_PROFILING */
+  OSQPInt*       iwork;          ///< integer raw array (3m)
+  OSQPFloat*     fwork;          ///< float raw array (4m)
+  OSQPInt*       flags;          ///< active set guessed at the current check
+  OSQPInt*       flags_prev;     ///< active set guessed at the previous check
+  OSQPInt*       flags_polished; ///< active set of the last speculative polish
+  OSQPInt        stable;         ///< consecutive checks with an unchanged guess
+  OSQPInt        running;        ///< boolean: a polish was started and its result not read
+  OSQPInt        done;           ///< boolean: the started polish finished (set by its thread)
+  OSQPInt        solved;         ///< boolean: the polished solution meets the tolerances
+};
+
+
+void polish_speculative_free(OSQPPolishSpec* spec) {
+  if (spec) {
+    OSQPVectorf_free(spec->x);
+    OSQPVectorf_free(spec->z);
+    OSQPVectorf_free(spec->y);
+    OSQPVectorf_free(spec->x_prev);
+    OSQPVectorf_free(spec->z_prev);
+    OSQPVectorf_free(spec->Ax);
+    OSQPVectorf_free(spec->Px);
+    OSQPVectorf_free(spec->Aty);
+#ifdef OSQP_ENABLE_PROFILING
+    OSQPTimer_free(spec->timer);
+#endif /* ifdef OSQP_ENABLE_PROFILING */
+    c_free(spec->iwork);
+    c_free(spec->fwork);
+    c_free(spec);
   }
+}
+
 
-  // Memory clean-up
-  plsh->free(plsh);
+/* Allocate the speculative polishing state; OSQP_NULL if out of memory */
+static OSQPPolishSpec* polish_speculative_new(OSQPWorkspace* work) {
 
-  // Checks that they are not NULL are already performed earlier
-  OSQPMatrix_free(work->pol->Ared);
-  OSQPVectorf_free(rhs_red);
-  OSQPVectorf_free(pol_sol);
-  OSQPVectorf_view_free(pol_sol_xview);
-  OSQPVectorf_view_free(pol_sol_yview);
+  OSQPInt n = work->data->n;
+  OSQPInt m = work->data->m;
+
+  OSQPPolishSpec* spec = c_calloc(1, sizeof(OSQPPolishSpec));
+  if (!spec) return OSQP_NULL;
+
+  spec->x      = OSQPVectorf_malloc(n);
+  spec->z      = OSQPVectorf_malloc(m);
+  spec->y      = OSQPVectorf_malloc(m);
+  spec->x_prev = OSQPVectorf_malloc(n);
+  spec->z_prev = OSQPVectorf_malloc(m);
+  spec->Ax     = OSQPVectorf_malloc(m);
+  spec->Px     = OSQPVectorf_malloc(n);
+  spec->Aty    = OSQPVectorf_malloc(n);
+  spec->iwork  = c_malloc((3 * m + 1) * sizeof(OSQPInt));
+  spec->fwork  = c_malloc((4 * m + 1) * sizeof(OSQPFloat));
+#ifdef OSQP_ENABLE_PROFILING
+  spec->timer  = OSQPTimer_new();
+  if (!spec->timer) {
+    polish_speculative_free(spec);
+    return OSQP_NULL;
+  }
+#endif /* ifdef OSQP_ENABLE_PROFILING */
+
+  if (!spec->x || !spec->z || !spec->y || !spec->x_prev || !spec->z_prev ||
+      !spec->Ax || !spec->Px || !spec->Aty || !spec->iwork || !spec->fwork) {
+    polish_speculative_free(spec);
+    return OSQP_NULL;
+  }
+
+  return spec;
+}
+
+
+OSQPInt polish_speculative_init(OSQPSolver* solver) {
+
+  OSQPInt         j;
+  OSQPWorkspace*  work = solver->work;
+  OSQPPolishSpec* spec;
+
+  if (!work->pol->spec) {
+    work->pol->spec = polish_speculative_new(work);
+    if (!work->pol->spec) return osqp_error(OSQP_MEM_ALLOC_ERROR);
+  }
+  spec = work->pol->spec;
+
+  // No guess matches the value 2
+  for (j = 0; j < 3 * work->data->m; j++) spec->iwork[j] = 2;
+  spec->flags          = spec->iwork;
+  spec->flags_prev     = spec->iwork + work->data->m;
+  spec->flags_polished = spec->iwork + 2 * work->data->m;
+  spec->stable  = 0;
+  spec->running = 0;
+  spec->done    = 0;
+  spec->solved  = 0;
 
   return OSQP_NO_ERROR;
 }
+
+
+/* Body of the speculative polish, run as an OpenMP task */
+static void polish_speculative_run(OSQPPolishSpec* spec) {
+
+  OSQPInt exitflag = polish(&spec->solver);
+
+  // Residuals of the returned iterate, which is the ADMM one if the polish
+  // did not improve it
+  if (!exitflag && spec->info.status_polish == OSQP_POLISH_SUCCESS) {
+    update_info(&spec->solver, spec->info.iter, 0, 0);
+    spec->solved = check_solved(&spec->solver);
+  }
+
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp flush
+#pragma omp atomic write
+#endif /* ifdef OSQP_ENABLE_OPENMP */
+  spec->done = 1;
+}
+
+
+/* Start the polish of a snapshot of the current iterate */
+static void polish_speculative_start(OSQPSolver* solver) {
+
+  OSQPWorkspace*  work = solver->work;
+  OSQPPolishSpec* spec = work->pol->spec;
+
+  OSQPVectorf_copy(spec->x, work->x);
+  OSQPVectorf_copy(spec->z, work->z);
+  OSQPVectorf_copy(spec->y, work->y);
+
+  spec->work        = *work;
+  spec->work.x      = spec->x;
+  spec->work.z      = spec->z;
+  spec->work.y      = spec->y;
+  spec->work.x_prev = spec->x_prev;
+  spec->work.z_prev = spec->z_prev;
+  spec->work.Ax     = spec->Ax;
+  spec->work.Px     = spec->Px;
+  spec->work.Aty    = spec->Aty;
+#ifdef OSQP_ENABLE_PROFILING
+  spec->work.timer  = spec->timer;
+#endif /* ifdef OSQP_ENABLE_PROFILING */
+
+  // The Schur complement polish would share the ADMM linear system solver
+  spec->settings              = *solver->settings;
+  spec->settings.verbose      = 0;
+  spec->settings.polish_schur = 0;
+  spec->info                  = *solver->info;
+
+  spec->solver.settings = &spec->settings;
+  spec->solver.solution = OSQP_NULL;
+  spec->solver.info     = &spec->info;
+  spec->solver.work     = &spec->work;
+
+  spec->running = 1;
+  spec->done    = 0;
+  spec->solved  = 0;
+
+  // Run at once if there is no second thread to defer the task to
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp task if(omp_get_num_threads() > 1)
+#endif /* ifdef OSQP_ENABLE_OPENMP */
+  polish_speculative_run(spec);
+}
+
+
+OSQPInt polish_speculative(OSQPSolver* solver) {
+
+  OSQPInt         j, n_active, same, done;
+  OSQPInt*        swap;
+  OSQPWorkspace*  work = solver->work;
+  OSQPPolishSpec* spec = work->pol->spec;
+  OSQPInt         m    = work->data->m;
+  OSQPFloat*      z    = spec->fwork;
+  OSQPFloat*      y    = z + m;
+  OSQPFloat*      l    = y + m;
+  OSQPFloat*      u    = l + m;
+
+  // Guess the active set at this check and compare it with the previous one
+  OSQPVectorf_to_raw(z, work->z);
+  OSQPVectorf_to_raw(y, work->y);
+  OSQPVectorf_to_raw(l, work->data->l);
+  OSQPVectorf_to_raw(u, work->data->u);
+  n_active = guess_active_set(m, z, y, l, u, spec->flags);
+
+  same = 1;
+  for (j = 0; j < m && same; j++) same = (spec->flags[j] == spec->flags_prev[j]);
+  spec->stable = same ? spec->stable + 1 : 0;
+
+  swap             = spec->flags;
+  spec->flags      = spec->flags_prev;
+  spec->flags_prev = swap;
+
+  // Start a polish once the guess settled on a new active set
+  if (!spec->running && n_active > 0 &&
+      spec->stable >= solver->settings->polish_speculative) {
+    same = 1;
+    for (j = 0; j < m && same; j++) same = (spec->flags_prev[j] == spec->flags_polished[j]);
+
+    if (!same) {
+      for (j = 0; j < m; j++) spec->flags_polished[j] = spec->flags_prev[j];
+      polish_speculative_start(solver);
+    }
+  }
+
+  // Read the result of a finished polish
+  if (!spec->running) return 0;
+
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp atomic read
+#endif /* ifdef OSQP_ENABLE_OPENMP */
+  done = spec->done;
+
+  if (!done) return 0;
+
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp flush
+#endif /* ifdef OSQP_ENABLE_OPENMP */
+  spec->running = 0;
+
+  if (!spec->solved) return 0;
+
+  // Continue from the polished solution, which meets the tolerances
+  OSQPVectorf_copy(work->x, spec->x);
+  OSQPVectorf_copy(work->z, spec->z);
+  OSQPVectorf_copy(work->y, spec->y);
+  update_info(solver, solver->info->iter, 1, 0);
+  update_status(solver->info, OSQP_SOLVED);
+  solver->info->status_polish = OSQP_POLISH_SUCCESS;
+
+#ifdef OSQP_ENABLE_PROFILING
+  // The polish ran during the ADMM and is part of the solve time
+  solver->info->polish_time = 0.0;
+#endif /* ifdef OSQP_ENABLE_PROFILING */
+
+#ifdef OSQP_ENABLE_PRINTING
+  if (solver->settings->verbose) print_polish(solver);
+#endif /* ifdef OSQP_ENABLE_PRINTING */
+
+  return 1;
+}
+
+
+void polish_speculative_wait(OSQPSolver* solver) {
+
+  OSQPPolishSpec* spec = solver->work->pol->spec;
+
+  if (spec && spec->running) {
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp taskwait
+#endif /* ifdef OSQP_ENABLE_OPENMP */
+    spec->running = 0;
+  }
+}
@@ -0,0 +1,228 @@
+#include "glob_opts.h"
+#include "predict.h"
+#include "lin_alg.h"
+
+// Smallest squared norm of the last data change that gives a secant
+#define PREDICT_MIN_CHANGE (1e-20)
+
+
+OSQPPredict* predict_new(OSQPInt n,
+                         OSQPInt m) {
+
+  OSQPInt j, b;
+  OSQPInt len[3] = { n, m, m };
+
+  OSQPPredict* pred = c_calloc(1, sizeof(OSQPPredict));
+  if (!pred) return OSQP_NULL;
+
+  for (b = 0; b < 3; b++) {
+    for (j = 0; j < 2; j++) {
+      pred->sol[j][b] = OSQPVectorf_malloc(len[b]);
+      pred->par[j][b] = OSQPVectorf_malloc(len[b]);
+      if (!pred->sol[j][b] || !pred->par[j][b]) {
+        predict_free(pred);
+        return OSQP_NULL;
+      }
+    }
+    pred->cand[b] = OSQPVectorf_malloc(len[b]);
+    if (!pred->cand[b]) {
+      predict_free(pred);
+      return OSQP_NULL;
+    }
+  }
+
+  for (j = 0; j < 2; j++) {
+    pred->dn[j] = OSQPVectorf_malloc(n);
+    pred->dm[j] = OSQPVectorf_malloc(m);
+    if (!pred->dn[j] || !pred->dm[j]) {
+      predict_free(pred);
+      return OSQP_NULL;
+    }
+  }
+
+  predict_reset(pred);
+
+  return pred;
+}
+
+
+void predict_reset(OSQPPredict* pred) {
+  if (pred) {
+    pred->nsol = 0;
+    pred->last = 0;
+    pred->rate = 0.0;
+  }
+}
+
+
+/* Scaled residual max(||Ax - z||, ||Px + q + A'y||) of an iterate */
+static OSQPFloat predict_residual(OSQPSolver*        solver,
+                                  const OSQPVectorf* x,
+                                  const OSQPVectorf* z,
+                                  const OSQPVectorf* y) {
+
+  OSQPWorkspace* work = solver->work;
+  OSQPPredict*   pred = work->pred;
+  OSQPFloat      prim_res = 0.0;
+  OSQPFloat      dual_res;
+
+  // dn[0] = Px + q
+  OSQPMatrix_Axpy(work->data->P, x, pred->dn[0], 1.0, 0.0);
+  OSQPVectorf_plus(pred->dn[0], pred->dn[0], work->data->q);
+
+  if (work->data->m) {
+    // dm[0] = Ax - z
+    OSQPMatrix_Axpy(work->data->A, x, pred->dm[0], 1.0, 0.0);
+    OSQPVectorf_minus(pred->dm[0], pred->dm[0], z);
+    prim_res = OSQPVectorf_norm_inf(pred->dm[0]);
+
+    // dn[0] += A'y
+    OSQPMatrix_Atxpy(work->data->A, y, pred->dn[0], 1.0, 1.0);
+  }
+  dual_res = OSQPVectorf_norm_inf(pred->dn[0]);
+
+  return c_max(prim_res, dual_res);
+}
+
+
+/* Contributions of one data vector to <p - p_2, p_2 - p_1> and ||p_2 - p_1||^2.
+ * The entries of infinite bounds are left out. */
+static void predict_secant_block(const OSQPVectorf* p,
+                                 const OSQPVectorf* p2,
+                                 const OSQPVectorf* p1,
+                                 OSQPVectorf*       d_new,
+                                 OSQPVectorf*       d_old,
+                                 OSQPFloat*         num,
+                                 OSQPFloat*         den) {
+
+  OSQPFloat inf = OSQP_INFTY * OSQP_MIN_SCALING;
+
+  OSQPVectorf_minus(d_new, p, p2);
+  OSQPVectorf_set_scalar_if_gt(d_new, d_new, inf, 0.0);
+  OSQPVectorf_set_scalar_if_lt(d_new, d_new, -inf, 0.0);
+
+  OSQPVectorf_minus(d_old, p2, p1);
+  OSQPVectorf_set_scalar_if_gt(d_old, d_old, inf, 0.0);
+  OSQPVectorf_set_scalar_if_lt(d_old, d_old, -inf, 0.0);
+
+  *num += OSQPVectorf_dot_prod(d_new, d_old);
+  *den += OSQPVectorf_dot_prod(d_old, d_old);
+}
+
+
+void predict_start(OSQPSolver* solver) {
+
+  OSQPInt        b;
+  OSQPWorkspace* work = solver->work;
+  OSQPPredict*   pred = work->pred;
+  OSQPInfo*      info = solver->info;
+  OSQPFloat      num  = 0.0;
+  OSQPFloat      den  = 0.0;
+  OSQPFloat      t, res_plain, res_pred;
+
+  OSQPVectorf* s[3]  = { work->x, work->z, work->y };
+  OSQPVectorf* p[3]  = { work->data->q, work->data->l, work->data->u };
+  OSQPVectorf** s2   = pred->sol[pred->last];
+  OSQPVectorf** s1   = pred->sol[1 - pred->last];
+  OSQPVectorf** p2   = pred->par[pred->last];
+  OSQPVectorf** p1   = pred->par[1 - pred->last];
+
+  if (pred->started) return;
+  pred->started = 1;
+
+  info->status_pred     = OSQP_PRED_NOT_PERFORMED;
+  info->pred_iter_saved = 0.0;
+
+  res_plain = predict_residual(solver, work->x, work->z, work->y);
+  pred->res_start = res_plain;
+
+  // Keep a start given by the user
+  if (pred->user_start) {
+    pred->user_start = 0;
+    return;
+  }
+  if (pred->nsol < 2) return;
+
+  predict_secant_block(p[0], p2[0], p1[0], pred->dn[1], pred->dn[0], &num, &den);
+  predict_secant_block(p[1], p2[1], p1[1], pred->dm[1], pred->dm[0], &num, &den);
+  predict_secant_block(p[2], p2[2], p1[2], pred->dm[1], pred->dm[0], &num, &den);
+
+  // No change of the data along the last one
+  if (den < PREDICT_MIN_CHANGE || num == 0.0) return;
+  t = num / den;
+
+  // Secant step from the last solution, with z within the new bounds
+  for (b = 0; b < 3; b++)
+    OSQPVectorf_add_scaled(pred->cand[b], 1.0 + t, s2[b], -t, s1[b]);
+  OSQPVectorf_ew_bound_vec(pred->cand[1], pred->cand[1], work->data->l, work->data->u);
+
+  res_pred = predict_residual(solver, pred->cand[0], pred->cand[1], pred->cand[2]);
+  if (res_pred > res_plain) {
+    info->status_pred = OSQP_PRED_REJECTED;
+    return;
+  }
+
+  for (b = 0; b < 3; b++)
+    OSQPVectorf_copy(s[b], pred->cand[b]);
+  work->linsys_solver->warm_start(work->linsys_solver, work->x);
+
+  // Iterations that the last solve needed for the same residual reduction
+  info->status_pred = OSQP_PRED_USED;
+  if (pred->rate > 0.0 && res_pred > 0.0)
+    info->pred_iter_saved = c_log(res_plain / res_pred) / pred->rate;
+  pred->res_start = res_pred;
+}
+
+
+void predict_record(OSQPSolver* solver) {
+
+  OSQPInt        b;
+  OSQPWorkspace* work = solver->work;
+  OSQPPredict*   pred = work->pred;
+  OSQPInfo*      info = solver->info;
+  OSQPFloat      res_end;
+
+  OSQPVectorf* s[3] = { work->x, work->z, work->y };
+  OSQPVectorf* p[3] = { work->data->q, work->data->l, work->data->u };
+
+  if (!pred->started) return;
+  pred->started = 0;
+
+  if (info->status_val != OSQP_SOLVED &&
+      info->status_val != OSQP_SOLVED_INACCURATE)
+    return;
+
+  pred->last = (pred->nsol == 0) ? 0 : 1 - pred->last;
+  pred->nsol = c_min(pred->nsol + 1, 2);
+  for (b = 0; b < 3; b++) {
+    OSQPVectorf_copy(pred->sol[pred->last][b], s[b]);
+    OSQPVectorf_copy(pred->par[pred->last][b], p[b]);
+  }
+
+  // Residual reduction per iteration, from the scaled residuals of the last
+  // termination check
+  res_end = c_max(work->scaled_prim_res, work->scaled_dual_res);
+  if (info->iter > 0 && res_end > 0.0 && pred->res_start > res_end)
+    pred->rate = c_log(pred->res_start / res_end) / info->iter;
+}
+
+
+void predict_free(OSQPPredict* pred) {
+
+  OSQPInt j, b;
+
+  if (pred) {
+    for (b = 0; b < 3; b++) {
+      for (j = 0; j < 2; j++) {
+        OSQPVectorf_free(pred->sol[j][b]);
+        OSQPVectorf_free(pred->par[j][b]);
+      }
+      OSQPVectorf_free(pred->cand[b]);
+    }
+    for (j = 0; j < 2; j++) {
+      OSQPVectorf_free(pred->dn[j]);
+      OSQPVectorf_free(pred->dm[j]);
+    }
+    c_free(pred);
+  }
+}
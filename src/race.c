@@ -0,0 +1,432 @@
+#include "glob_opts.h"
+#include "race.h"
+#include "lin_alg.h"
+#include "auxil.h"
+#include "anderson.h"
+#include "nesterov.h"
+#include "error.h"
+#include "printing.h"
+#include "timing.h"
+
+// Ratio between the initial rho of consecutive replicas on the same side
+#define RACE_RHO_FACTOR (10.0)
+
+
+/**
+ * Replica of the main solver
+ *
+ * The workspace owns its iterates, work vectors, acceleration state and linear
+ * system solver. The problem data and the scaling are the ones of the main
+ * solver, set again at every race.
+ */
+typedef struct {
+  OSQPSolver    solver;   ///< replica solver, pointing to the structures below
+  OSQPWorkspace work;     ///< workspace of the replica
+  OSQPSettings  settings; ///< settings of the main solver with the rho of the replica
+  OSQPInfo      info;     ///< information of the replica
+  OSQPFloat     rho_prev; ///< rho at the end of the previous race
+} RaceReplica;
+
+
+struct OSQPRace_ {
+  OSQPInt      nrep;    ///< number of allocated replicas
+  RaceReplica* rep;     ///< replicas 1 to nrep (rep[k-1])
+  OSQPInt      running; ///< boolean: a race is in progress
+  OSQPInt      winner;  ///< index of the solver that finished first (-1 if none yet)
+  OSQPInt      started; ///< number of solvers that started the race, with the main solver
+};
+
+
+/* Free the vectors and solvers owned by a replica workspace */
+static void race_replica_free(OSQPWorkspace* work) {
+  if (work->linsys_solver)
+    work->linsys_solver->free(work->linsys_solver);
+  anderson_free(work->aa);
+  nesterov_free(work->nest);
+  OSQPVectorf_free(work->rho_vec_new);
+  OSQPVectorf_free(work->rho_vec_tmp);
+  OSQPVectorf_free(work->rho_vec);
+  OSQPVectorf_free(work->rho_inv_vec);
+  OSQPVectori_free(work->constr_type);
+  OSQPVectorf_free(work->x);
+  OSQPVectorf_free(work->y);
+  OSQPVectorf_free(work->z);
+  OSQPVectorf_view_free(work->xtilde_view);
+  OSQPVectorf_view_free(work->ztilde_view);
+  OSQPVectorf_free(work->xz_tilde);
+  OSQPVectorf_free(work->x_prev);
+  OSQPVectorf_free(work->z_prev);
+  OSQPVectorf_free(work->Ax);
+  OSQPVectorf_free(work->Px);
+  OSQPVectorf_free(work->Aty);
+  OSQPVectorf_free(work->delta_y);
+  OSQPVectorf_free(work->Atdelta_y);
+  OSQPVectorf_free(work->delta_x);
+  OSQPVectorf_free(work->Pdelta_x);
+  OSQPVectorf_free(work->Adelta_x);
+#ifdef OSQP_ENABLE_PROFILING
+  OSQPTimer_free(work->timer);
+#endif /* ifdef OSQP_ENABLE_PROFILING */
+}
+
+
+/* Allocate the workspace of a replica like the one of the main solver.
+ * Returns 1 if out of memory. */
+static OSQPInt race_replica_alloc(OSQPWorkspace*       work,
+                                  const OSQPWorkspace* main_work,
+                                  const OSQPSettings*  settings) {
+
+  OSQPInt n = main_work->data->n;
+  OSQPInt m = main_work->data->m;
+
+  if (settings->rho_is_vec) {
+    work->rho_vec     = OSQPVectorf_malloc(m);
+    work->rho_inv_vec = OSQPVectorf_malloc(m);
+    work->constr_type = OSQPVectori_calloc(m);
+    if (!work->rho_vec || !work->rho_inv_vec || !work->constr_type)
+      return 1;
+  }
+
+  work->x           = OSQPVectorf_calloc(n);
+  work->z           = OSQPVectorf_calloc(m);
+  work->y           = OSQPVectorf_calloc(m);
+  work->xz_tilde    = OSQPVectorf_calloc(n + m);
+  work->xtilde_view = OSQPVectorf_view(work->xz_tilde, 0, n);
+  work->ztilde_view = OSQPVectorf_view(work->xz_tilde, n, m);
+  work->x_prev      = OSQPVectorf_calloc(n);
+  work->z_prev      = OSQPVectorf_calloc(m);
+  work->Ax          = OSQPVectorf_calloc(m);
+  work->Px          = OSQPVectorf_calloc(n);
+  work->Aty         = OSQPVectorf_calloc(n);
+  work->delta_y     = OSQPVectorf_calloc(m);
+  work->Atdelta_y   = OSQPVectorf_calloc(n);
+  work->delta_x     = OSQPVectorf_calloc(n);
+  work->Pdelta_x    = OSQPVectorf_calloc(n);
+  work->Adelta_x    = OSQPVectorf_calloc(m);
+
+  if (!work->x || !work->z || !work->y || !work->xz_tilde ||
+      !work->xtilde_view || !work->ztilde_view || !work->x_prev ||
+      !work->z_prev || !work->Ax || !work->Px || !work->Aty ||
+      !work->delta_y || !work->Atdelta_y || !work->delta_x ||
+      !work->Pdelta_x || !work->Adelta_x)
+    return 1;
+
+  if (main_work->aa) {
+    work->aa = anderson_new(main_work->aa->mem, n, m);
+    if (!work->aa) return 1;
+  }
+  if (main_work->nest) {
+    work->nest = nesterov_new(n, m);
+    if (!work->nest) return 1;
+  }
+  if (main_work->rho_vec_new) {
+    work->rho_vec_new = OSQPVectorf_malloc(m);
+    work->rho_vec_tmp = OSQPVectorf_malloc(m);
+    if (!work->rho_vec_new || !work->rho_vec_tmp) return 1;
+  }
+
+#ifdef OSQP_ENABLE_PROFILING
+  work->timer = OSQPTimer_new();
+  if (!work->timer) return 1;
+#endif /* ifdef OSQP_ENABLE_PROFILING */
+
+  return 0;
+}
+
+
+/* Allocate the race with nrep replicas; OSQP_NULL if out of memory */
+static OSQPRace* race_new(const OSQPSolver* solver,
+                          OSQPInt           nrep) {
+
+  OSQPInt   k;
+  OSQPRace* race = c_calloc(1, sizeof(OSQPRace));
+  if (!race) return OSQP_NULL;
+
+  race->nrep = nrep;
+  race->rep  = c_calloc(nrep, sizeof(RaceReplica));
+  if (!race->rep) {
+    race_free(race);
+    return OSQP_NULL;
+  }
+
+  for (k = 0; k < nrep; k++) {
+    if (race_replica_alloc(&race->rep[k].work, solver->work, solver->settings)) {
+      race_free(race);
+      return OSQP_NULL;
+    }
+  }
+
+  return race;
+}
+
+
+void race_free(OSQPRace* race) {
+
+  OSQPInt k;
+
+  if (race) {
+    if (race->rep)
+      for (k = 0; k < race->nrep; k++) race_replica_free(&race->rep[k].work);
+    c_free(race->rep);
+    c_free(race);
+  }
+}
+
+
+void race_reset(OSQPRace* race) {
+
+  OSQPInt k;
+
+  if (race) {
+    for (k = 0; k < race->nrep; k++) {
+      if (race->rep[k].work.linsys_solver)
+        race->rep[k].work.linsys_solver->free(race->rep[k].work.linsys_solver);
+      race->rep[k].work.linsys_solver = OSQP_NULL;
+    }
+  }
+}
+
+
+/* Initial rho of replica k: rho*10, rho/10, rho*100, rho/100, ... */
+static OSQPFloat race_rho(OSQPFloat rho,
+                          OSQPInt   k) {
+
+  OSQPInt j;
+
+  for (j = 0; j < (k + 1) / 2; j++)
+    rho = (k % 2) ? rho * RACE_RHO_FACTOR : rho / RACE_RHO_FACTOR;
+
+  return c_min(c_max(rho, OSQP_RHO_MIN), OSQP_RHO_MAX);
+}
+
+
+OSQPInt race_init(OSQPSolver* solver) {
+
+  OSQPInt        k;
+  OSQPWorkspace* work     = solver->work;
+  OSQPSettings*  settings = solver->settings;
+  OSQPInt        nrep     = settings->rho_racing - 1;
+  RaceReplica*   rep;
+
+  // Replicas allocated for a smaller race are not enough
+  if (work->race && work->race->nrep < nrep) {
+    race_free(work->race);
+    work->race = OSQP_NULL;
+  }
+  if (!work->race) {
+    work->race = race_new(solver, nrep);
+    if (!work->race) return osqp_error(OSQP_MEM_ALLOC_ERROR);
+  }
+
+  for (k = 1; k <= nrep; k++) {
+    rep = &work->race->rep[k-1];
+
+    // Settings of the main solver, without the steps that only it performs
+    rep->rho_prev                    = rep->settings.rho;
+    rep->settings                    = *settings;
+    rep->settings.rho                = race_rho(settings->rho, k);
+    rep->settings.verbose            = 0;
+    rep->settings.polishing          = 0;
+    rep->settings.polish_speculative = 0;
+    rep->settings.rho_racing         = 0;
+    rep->info                        = *solver->info;
+    update_status(&rep->info, OSQP_UNSOLVED);
+
+    // Data and scaling of the main solver
+    rep->work.data            = work->data;
+    rep->work.scaling         = work->scaling;
+    rep->work.rho_inv         = 1. / rep->settings.rho;
+    rep->work.scaled_prim_res = work->scaled_prim_res;
+    rep->work.scaled_dual_res = work->scaled_dual_res;
+    rep->work.race            = work->race;
+    rep->work.race_id         = k;
+#ifdef OSQP_ENABLE_PROFILING
+    rep->work.first_run             = work->first_run;
+    rep->work.clear_update_time     = 0;
+    rep->work.rho_update_from_solve = 1;
+#endif /* ifdef OSQP_ENABLE_PROFILING */
+
+    // Start from the iterate of the main solver
+    OSQPVectorf_copy(rep->work.x, work->x);
+    OSQPVectorf_copy(rep->work.z, work->z);
+    OSQPVectorf_copy(rep->work.y, work->y);
+
+    rep->solver.settings = &rep->settings;
+    rep->solver.solution = OSQP_NULL;
+    rep->solver.info     = &rep->info;
+    rep->solver.work     = &rep->work;
+  }
+
+  work->race_id       = 0;
+  work->race->winner  = -1;
+  work->race->started = 1;
+  work->race->running = 1;
+
+  return OSQP_NO_ERROR;
+}
+
+
+OSQPSolver* race_replica(OSQPSolver* solver,
+                         OSQPInt     k) {
+
+  OSQPInt        exitflag = 0;
+  OSQPInt        types_changed = 0;
+  RaceReplica*   rep = &solver->work->race->rep[k-1];
+  OSQPWorkspace* work = &rep->work;
+
+  // Do not factorize for a race that is already over
+  if (race_stopped(work)) return OSQP_NULL;
+
+  if (rep->settings.rho_is_vec)
+    types_changed = set_rho_vec(&rep->solver);
+
+  if (!work->linsys_solver) {
+    exitflag = osqp_algebra_init_linsys_solver(&work->linsys_solver, work->data->P, work->data->A,
+                                               work->rho_vec, &rep->settings,
+                                               &work->scaled_prim_res, &work->scaled_dual_res, 0);
+  }
+  else {
+    work->linsys_solver->update_settings(work->linsys_solver, &rep->settings);
+
+    // The per-constraint adaptation changed the rho vector of the factorization
+    if (types_changed || rep->settings.adaptive_rho_vec || rep->rho_prev != rep->settings.rho)
+      exitflag = work->linsys_solver->update_rho_vec(work->linsys_solver, work->rho_vec,
+                                                     rep->settings.rho);
+  }
+
+  if (exitflag) {
+    // Factorize again in the next race
+    if (work->linsys_solver)
+      work->linsys_solver->free(work->linsys_solver);
+    work->linsys_solver = OSQP_NULL;
+    rep->settings.rho   = 0.0;
+    return OSQP_NULL;
+  }
+
+  work->linsys_solver->warm_start(work->linsys_solver, work->x);
+
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp atomic update
+#endif /* ifdef OSQP_ENABLE_OPENMP */
+  solver->work->race->started++;
+
+  return &rep->solver;
+}
+
+
+OSQPInt race_stopped(const OSQPWorkspace* work) {
+
+  OSQPInt winner;
+
+  if (!work->race || !work->race->running)
+    return 0;
+
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp atomic read
+#endif /* ifdef OSQP_ENABLE_OPENMP */
+  winner = work->race->winner;
+
+  return (winner >= 0) && (winner != work->race_id);
+}
+
+
+OSQPInt race_finish(OSQPSolver* solver) {
+
+  OSQPInt        winner;
+  OSQPWorkspace* work   = solver->work;
+  OSQPRace*      race   = work->race;
+  OSQPInt        status = solver->info->status_val;
+
+  if (!race || !race->running)
+    return 0;
+
+  if (work->race_id == 0 ||
+      (status != OSQP_UNSOLVED && status != OSQP_TIME_LIMIT_REACHED)) {
+    // The first solver to get here wins, its iterate is complete
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp critical (osqp_race)
+#endif /* ifdef OSQP_ENABLE_OPENMP */
+    {
+      if (race->winner < 0) {
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp atomic write
+#endif /* ifdef OSQP_ENABLE_OPENMP */
+        race->winner = work->race_id;
+      }
+      winner = race->winner;
+    }
+  }
+  else {
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp atomic read
+#endif /* ifdef OSQP_ENABLE_OPENMP */
+    winner = race->winner;
+  }
+
+  return (work->race_id == 0) && (winner > 0);
+}
+
+
+OSQPInt race_adopt(OSQPSolver* solver) {
+
+  OSQPInt        exitflag = 0;
+  OSQPWorkspace* work     = solver->work;
+  OSQPSettings*  settings = solver->settings;
+  OSQPInfo*      info     = solver->info;
+  RaceReplica*   rep;
+
+#ifdef OSQP_ENABLE_OPENMP
+#pragma omp flush
+#endif /* ifdef OSQP_ENABLE_OPENMP */
+  rep = &work->race->rep[work->race->winner - 1];
+
+  OSQPVectorf_copy(work->x, rep->work.x);
+  OSQPVectorf_copy(work->z, rep->work.z);
+  OSQPVectorf_copy(work->y, rep->work.y);
+  OSQPVectorf_copy(work->delta_x, rep->work.delta_x);
+  OSQPVectorf_copy(work->delta_y, rep->work.delta_y);
+
+  // Continue with the rho of the winner
+  if (settings->adaptive_rho_vec) {
+    settings->rho = rep->settings.rho;
+    OSQPVectorf_copy(work->rho_vec, rep->work.rho_vec);
+    OSQPVectorf_ew_reciprocal(work->rho_inv_vec, work->rho_vec);
+    exitflag = work->linsys_solver->update_rho_vec(work->linsys_solver, work->rho_vec, settings->rho);
+    info->rho_updates += 1;
+  }
+  else if (rep->settings.rho != settings->rho) {
+    exitflag = osqp_update_rho(solver, rep->settings.rho);
+    info->rho_updates += 1;
+  }
+  if (exitflag) return exitflag;
+
+  // Residuals and status of the winner
+  update_info(solver, rep->info.iter, 1, 0);
+  update_status(info, rep->info.status_val);
+  if (!has_solution(info))
+    info->obj_val = rep->info.obj_val;
+
+#ifdef OSQP_ENABLE_PRINTING
+  if (settings->verbose)
+    c_print("rho race won by replica %i with rho = %.2e\n",
+            (int)work->race->winner, settings->rho);
+#endif /* ifdef OSQP_ENABLE_PRINTING */
+
+  return OSQP_NO_ERROR;
+}
+
+
+void race_end(OSQPWorkspace* work) {
+  if (work->race)
+    work->race->running = 0;
+}
+
+
+OSQPInt race_started(const OSQPRace* race) {
+  return race ? race->started : 0;
+}
+
+
+OSQPInt race_winner(const OSQPRace* race) {
+  return race ? race->winner : -1;
+}
@@ -114,26 +114,57 @@ void print_setup_header(const OSQPSolver* solver) {
   }
   c_print(",\n          ");
 
+#ifndef OSQP_EMBEDDED_MODE
+  if (work->linsys_solver->memory > 0) {
+    c_print("linear system memory = %.1f kB", work->linsys_solver->memory / 1024.);
+    c_print(",\n          ");
+  }
+#endif
+
   c_print("eps_abs = %.1e, eps_rel = %.1e,\n          ",
           settings->eps_abs, settings->eps_rel);
   c_print("eps_prim_inf = %.1e, eps_dual_inf = %.1e,\n          ",
           settings->eps_prim_inf, settings->eps_dual_inf);
   c_print("rho = %.2e ", settings->rho);
 
-  if (settings->adaptive_rho) {
+  if (settings->adaptive_rho && settings->adaptive_rho_vec) {
+    c_print("(adaptive, per constraint)");
+  }
+  else if (settings->adaptive_rho) {
     c_print("(adaptive)");
   }
+  if (settings->rho_racing > 1) {
+    c_print(", raced by %i replicas", (int)settings->rho_racing);
+  }
   c_print(",\n          ");
   c_print("sigma = %.2e, alpha = %.2f, ",
           settings->sigma, settings->alpha);
   c_print("max_iter = %i\n", (int)settings->max_iter);
 
-  if (settings->check_termination) {
+  if (settings->check_termination && settings->adaptive_termination) {
+    c_print("          check_termination: adaptive (interval %i to %i),\n",
+      (int)c_min(OSQP_CHECK_TERMINATION_MIN, settings->check_termination),
+      (int)settings->check_termination);
+  }
+  else if (settings->check_termination) {
     c_print("          check_termination: on (interval %i),\n",
       (int)settings->check_termination);
   }
   else
     c_print("          check_termination: off,\n");
+
+  if (!settings->check_infeasibility)
+    c_print("          check_infeasibility: off,\n");
+  else if (settings->check_infeasibility > 1 || settings->infeasibility_stall)
+    c_print("          check_infeasibility: on (interval %i, after %i stalled checks),\n",
+      (int)settings->check_infeasibility, (int)settings->infeasibility_stall);
+
+  if (settings->anderson_mem)
+    c_print("          anderson acceleration: on (memory %i),\n",
+      (int)settings->anderson_mem);
+
+  if (settings->nesterov)
+    c_print("          nesterov acceleration: on,\n");
   
 # ifdef OSQP_ENABLE_PROFILING
   if (settings->time_limit)
@@ -152,18 +183,27 @@ void print_setup_header(const OSQPSolver* solver) {
     c_print("scaled_termination: off\n");
   }
 
-  if (settings->warm_starting) {
+  if (settings->warm_starting && settings->warm_start_predict) {
+    c_print("          warm starting: on (predicted), ");
+  } else if (settings->warm_starting) {
     c_print("          warm starting: on, ");
   } else {
     c_print("          warm starting: off, ");
   }
 
-  if (settings->polishing) {
+  if (settings->polishing && settings->polish_schur) {
+    c_print("polishing: on (schur rank <= %i), ", (int)settings->polish_schur);
+  } else if (settings->polishing) {
     c_print("polishing: on, ");
   } else {
     c_print("polishing: off, ");
   }
 
+  if (settings->polishing && settings->polish_speculative) {
+    c_print("\n          speculative polishing: after %i stable checks, ",
+            (int)settings->polish_speculative);
+  }
+
   c_print("\n");
 }
 
@@ -243,6 +283,15 @@ void print_footer(OSQPInfo* info,
 
   c_print("number of iterations: %i\n", (int)info->iter);
 
+# ifndef OSQP_EMBEDDED_MODE
+  if (info->status_pred == OSQP_PRED_USED) {
+    c_print("warm start prediction: used (about %.0f iterations saved)\n",
+            info->pred_iter_saved);
+  } else if (info->status_pred == OSQP_PRED_REJECTED) {
+    c_print("warm start prediction: rejected\n");
+  }
+# endif /* ifndef OSQP_EMBEDDED_MODE */
+
   if ((info->status_val == OSQP_SOLVED) ||
       (info->status_val == OSQP_SOLVED_INACCURATE)) {
     c_print("optimal objective:    %.4f\n", info->obj_val);
@@ -279,6 +328,7 @@ OSQPSettings* copy_settings(const OSQPSettings *settings) {
   new->profiler_level    = settings->profiler_level;
   new->verbose           = settings->verbose;
   new->warm_starting     = settings->warm_starting;
+  new->warm_start_predict = settings->warm_start_predict;
   new->scaling           = settings->scaling;
   new->polishing         = settings->polishing;
 
@@ -287,15 +337,22 @@ OSQPSettings* copy_settings(const OSQPSettings *settings) {
   new->sigma      = settings->sigma;
   new->alpha      = settings->alpha;
 
+  new->anderson_mem = settings->anderson_mem;
+  new->nesterov     = settings->nesterov;
+
   new->cg_max_iter      = settings->cg_max_iter;
   new->cg_tol_reduction = settings->cg_tol_reduction;
   new->cg_tol_fraction  = settings->cg_tol_fraction;
   new->cg_precond       = settings->cg_precond;
+  new->cg_block_size    = settings->cg_block_size;
+  new->cg_method        = settings->cg_method;
 
   new->adaptive_rho           = settings->adaptive_rho;
   new->adaptive_rho_interval  = settings->adaptive_rho_interval;
   new->adaptive_rho_fraction  = settings->adaptive_rho_fraction;
   new->adaptive_rho_tolerance = settings->adaptive_rho_tolerance;
+  new->adaptive_rho_vec       = settings->adaptive_rho_vec;
+  new->rho_racing             = settings->rho_racing;
 
   new->max_iter           = settings->max_iter;
   new->eps_abs            = settings->eps_abs;
@@ -304,10 +361,15 @@ OSQPSettings* copy_settings(const OSQPSettings *settings) {
   new->eps_dual_inf       = settings->eps_dual_inf;
   new->scaled_termination = settings->scaled_termination;
   new->check_termination  = settings->check_termination;
+  new->adaptive_termination = settings->adaptive_termination;
+  new->check_infeasibility  = settings->check_infeasibility;
+  new->infeasibility_stall  = settings->infeasibility_stall;
   new->time_limit         = settings->time_limit;
 
   new->delta              = settings->delta;
   new->polish_refine_iter = settings->polish_refine_iter;
+  new->polish_schur       = settings->polish_schur;
+  new->polish_speculative = settings->polish_speculative;
 
   return new;
 }
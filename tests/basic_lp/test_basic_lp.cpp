@@ -11,17 +11,20 @@ TEST_CASE_METHOD(basic_lp_test_fixture, "Basic LP", "[solve][lp]")
 {
   OSQPInt exitflag;
 
-  /* Test with and without polishing */
+  /* Test without polishing, and polishing with and without the Schur complement */
   OSQPInt polish;
+  OSQPInt polish_schur;
   OSQPInt expectedPolishStatus;
 
-  std::tie( polish, expectedPolishStatus ) =
-      GENERATE( table<OSQPInt, OSQPInt>(
-          { /* first is polish enabled, second is expected status */
-            std::make_tuple( 0, OSQP_POLISH_NOT_PERFORMED ),
-            std::make_tuple( 1, OSQP_POLISH_SUCCESS ) } ) );
+  std::tie( polish, polish_schur, expectedPolishStatus ) =
+      GENERATE( table<OSQPInt, OSQPInt, OSQPInt>(
+          { /* first is polish enabled, second is the Schur rank limit, third is expected status */
+            std::make_tuple( 0, 0,   OSQP_POLISH_NOT_PERFORMED ),
+            std::make_tuple( 1, 0,   OSQP_POLISH_SUCCESS ),
+            std::make_tuple( 1, 100, OSQP_POLISH_SUCCESS ) } ) );
 
   settings->polishing = polish;
+  settings->polish_schur = polish_schur;
   settings->polish_refine_iter = 4;
 
   /* TODO: MKL CG is failing this test, so test with default linear algebra only */
@@ -30,7 +33,7 @@ TEST_CASE_METHOD(basic_lp_test_fixture, "Basic LP", "[solve][lp]")
   settings->linsys_solver = GENERATE(filter(&isLinsysSupported, values({OSQP_DIRECT_SOLVER, OSQP_INDIRECT_SOLVER})));
 #endif
 
-  CAPTURE(settings->linsys_solver, settings->polishing);
+  CAPTURE(settings->linsys_solver, settings->polishing, settings->polish_schur);
 
   // Setup solver
   exitflag = osqp_setup(&tmpSolver, data->P, data->q,
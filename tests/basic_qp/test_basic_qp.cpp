@@ -1,8 +1,10 @@
 #include <catch2/catch.hpp>
+#include <vector>
 
 #include "osqp_api.h"    /* OSQP API wrapper (public + some private) */
 #include "osqp_tester.h" /* Tester helpers */
 #include "test_utils.h"  /* Testing Helper functions */
+#include "race.h"         /* Rho race of the replicas */
 
 #include "basic_qp_data.h"
 
@@ -54,6 +56,409 @@ TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Solve", "[solve][qp]")
       TESTS_TOL);
 }
 
+TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Polishing factorization cache", "[solve][qp]")
+{
+  OSQPInt exitflag;
+  OSQPInt nnzP = data->P->p[data->n];
+  LinSysSolver* plsh;
+
+  OSQPSolver*   refSolver = OSQP_NULL;
+  OSQPCscMatrix P2;
+  std::vector<OSQPFloat> P2x(data->P->x, data->P->x + nnzP);
+
+  // Test-specific options
+  settings->polishing     = 1;
+  settings->verbose       = 0;
+  settings->linsys_solver = OSQP_DIRECT_SOLVER;
+
+  // Setup solver
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  // Setup correct
+  mu_assert("Basic QP test solve: Setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP test solve: Error in polish status!",
+      solver->info->status_polish == OSQP_POLISH_SUCCESS);
+
+  plsh = solver->work->pol->plsh;
+  mu_assert("Basic QP test solve: Polishing factorization not kept!",
+      plsh != OSQP_NULL);
+
+  // Same active set: the factorization is reused
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP test solve: Error in polish status after the second solve!",
+      solver->info->status_polish == OSQP_POLISH_SUCCESS);
+  mu_assert("Basic QP test solve: Polishing factorization not reused!",
+      solver->work->pol->plsh == plsh);
+
+  // New values of P: the same factorization is refactored numerically
+  for (OSQPInt i = 0; i < nnzP; i++) P2x[i] *= 2.0;
+  csc_set_data(&P2, data->n, data->n, nnzP, P2x.data(), data->P->i, data->P->p);
+
+  exitflag = osqp_update_data_mat(solver.get(), P2x.data(), OSQP_NULL, nnzP,
+                                  OSQP_NULL, OSQP_NULL, 0);
+  mu_assert("Basic QP test solve: Error updating P!", exitflag == 0);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP test solve: Error in polish status after updating P!",
+      solver->info->status_polish == OSQP_POLISH_SUCCESS);
+  mu_assert("Basic QP test solve: Polishing factorization not refactored in place!",
+      solver->work->pol->plsh == plsh);
+
+  // Compare with a new solver of the updated problem
+  exitflag = osqp_setup(&refSolver, &P2, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  mu_assert("Basic QP test solve: Setup error!", exitflag == 0);
+
+  osqp_solve(refSolver);
+
+  mu_assert("Basic QP test solve: Error in polished primal solution after updating P!",
+      vec_norm_inf_diff(solver->solution->x, refSolver->solution->x, data->n) < 1e-8);
+  mu_assert("Basic QP test solve: Error in polished dual solution after updating P!",
+      vec_norm_inf_diff(solver->solution->y, refSolver->solution->y, data->m) < 1e-8);
+
+  osqp_cleanup(refSolver);
+  refSolver = OSQP_NULL;
+
+  // New delta: the factorization is formed again
+  settings->delta *= 0.1;
+  exitflag = osqp_update_settings(solver.get(), settings.get());
+  mu_assert("Basic QP test solve: Error updating delta!", exitflag == 0);
+  mu_assert("Basic QP test solve: Polishing factorization not invalidated by delta!",
+      solver->work->pol->data_changed == 1);
+
+  osqp_cold_start(solver.get());
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP test solve: Error in polish status after updating delta!",
+      solver->info->status_polish == OSQP_POLISH_SUCCESS);
+  mu_assert("Basic QP test solve: Polishing factorization not formed again after updating delta!",
+      solver->work->pol->data_changed == 0);
+
+  // Compare with a new solver with the updated delta
+  exitflag = osqp_setup(&refSolver, &P2, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  mu_assert("Basic QP test solve: Setup error!", exitflag == 0);
+
+  osqp_solve(refSolver);
+
+  mu_assert("Basic QP test solve: Error in polished primal solution after updating delta!",
+      vec_norm_inf_diff(solver->solution->x, refSolver->solution->x, data->n) < 1e-8);
+  mu_assert("Basic QP test solve: Error in polished dual solution after updating delta!",
+      vec_norm_inf_diff(solver->solution->y, refSolver->solution->y, data->m) < 1e-8);
+
+  osqp_cleanup(refSolver);
+}
+
+TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Polishing line search", "[solve][qp]")
+{
+  OSQPInt exitflag;
+  OSQPFloat prim_res, dual_res;
+
+  OSQPSolver* admmSolver = OSQP_NULL;
+
+  // Badly scaled QP whose polished solution reduces only one of the residuals
+  //   min  0.005*(x1^2 + x2^2) + 0.4*x1 + 0.6*x2
+  //   s.t. 0.2*x2 = 0.4,  -0.4 <= -0.2*x2 <= 0
+  OSQPFloat P_x[2] = { 0.01, 0.01 };
+  OSQPInt   P_i[2] = { 0, 1 };
+  OSQPInt   P_p[3] = { 0, 1, 2 };
+  OSQPFloat A_x[2] = { 0.2, -0.2 };
+  OSQPInt   A_i[2] = { 0, 1 };
+  OSQPInt   A_p[3] = { 0, 0, 2 };
+  OSQPFloat q[2]   = { 0.4, 0.6 };
+  OSQPFloat l[2]   = { 0.4, -0.4 };
+  OSQPFloat u[2]   = { 0.4, 0.0 };
+
+  OSQPCscMatrix P, A;
+  csc_set_data(&P, 2, 2, 2, P_x, P_i, P_p);
+  csc_set_data(&A, 2, 2, 2, A_x, A_i, A_p);
+
+  // Test-specific options
+  settings->verbose               = 0;
+  settings->eps_abs               = 1e-2;
+  settings->eps_rel               = 1e-2;
+  settings->adaptive_rho_interval = 25;
+
+  // ADMM solution
+  settings->polishing = 0;
+  exitflag = osqp_setup(&admmSolver, &P, q, &A, l, u, 2, 2, settings.get());
+  mu_assert("Basic QP test solve: Setup error!", exitflag == 0);
+
+  osqp_solve(admmSolver);
+  prim_res = admmSolver->info->prim_res;
+  dual_res = admmSolver->info->dual_res;
+  osqp_cleanup(admmSolver);
+
+  // Polished solution
+  settings->polishing = 1;
+  exitflag = osqp_setup(&tmpSolver, &P, q, &A, l, u, 2, 2, settings.get());
+  solver.reset(tmpSolver);
+  mu_assert("Basic QP test solve: Setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+
+  // The polished point alone is rejected, the line search finds a better one
+  mu_assert("Basic QP test solve: Error in polish status!",
+      solver->info->status_polish == OSQP_POLISH_SUCCESS);
+  mu_assert("Basic QP test solve: Primal residual not reduced by polishing!",
+      solver->info->prim_res < prim_res);
+  mu_assert("Basic QP test solve: Dual residual not reduced by polishing!",
+      solver->info->dual_res < dual_res);
+}
+
+TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Speculative polishing", "[solve][qp]")
+{
+  OSQPInt exitflag;
+  OSQPInt iter;
+
+  // Test-specific options
+  settings->polishing             = 1;
+  settings->verbose               = 0;
+  settings->warm_starting         = 0;
+  settings->eps_abs               = 1e-7;
+  settings->eps_rel               = 1e-7;
+  settings->check_termination     = 5;
+  settings->adaptive_termination  = 0;
+  settings->adaptive_rho_interval = 25;
+
+  // Setup solver
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  // Setup correct
+  mu_assert("Basic QP test solve: Setup error!", exitflag == 0);
+
+  // Polish after the ADMM only
+  osqp_solve(solver.get());
+  iter = solver->info->iter;
+
+  mu_assert("Basic QP test solve: Error in polish status!",
+      solver->info->status_polish == OSQP_POLISH_SUCCESS);
+
+  // Polish as soon as the active set guess is stable for one check
+  settings->polish_speculative = 1;
+  exitflag = osqp_update_settings(solver.get(), settings.get());
+  mu_assert("Basic QP test solve: Error updating the settings!", exitflag == 0);
+
+  // Solve twice to start from a fresh speculative state
+  for (OSQPInt k = 0; k < 2; k++) {
+    osqp_solve(solver.get());
+
+    mu_assert("Basic QP test solve: Error in solver status!",
+        solver->info->status_val == OSQP_SOLVED);
+    mu_assert("Basic QP test solve: Error in polish status!",
+        solver->info->status_polish == OSQP_POLISH_SUCCESS);
+    mu_assert("Basic QP test solve: More iterations with speculative polishing!",
+        solver->info->iter <= iter);
+
+    // Compare primal and dual solutions
+    mu_assert("Basic QP test solve: Error in primal solution!",
+        vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+              data->n) < TESTS_TOL);
+    mu_assert("Basic QP test solve: Error in dual solution!",
+        vec_norm_inf_diff(solver->solution->y, sols_data->y_test,
+              data->m) < TESTS_TOL);
+  }
+}
+
+// The replicas of the race run on OpenMP threads
+#ifdef OSQP_ENABLE_OPENMP
+TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Rho racing", "[solve][qp]")
+{
+  OSQPInt exitflag;
+
+  // Test-specific options: a poor rho that is not adapted
+  settings->polishing     = 0;
+  settings->verbose       = 0;
+  settings->warm_starting = 0;
+  settings->adaptive_rho  = 0;
+  settings->rho           = 1e-2;
+  settings->eps_abs       = 1e-5;
+  settings->eps_rel       = 1e-5;
+
+  // Setup solver
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  // Setup correct
+  mu_assert("Basic QP test solve: Setup error!", exitflag == 0);
+
+  // Race against replicas with rho = 1e-1, 1e-3, 1, 1e-4
+  settings->rho_racing = 5;
+  exitflag = osqp_update_settings(solver.get(), settings.get());
+  mu_assert("Basic QP test solve: Error updating the settings!", exitflag == 0);
+
+  // The second race starts from the rho of the winner of the first one
+  for (OSQPInt k = 0; k < 2; k++) {
+    OSQPFloat rho = solver->settings->rho;
+
+    exitflag = osqp_solve(solver.get());
+
+    mu_assert("Basic QP test solve: Error in solver!", exitflag == 0);
+    mu_assert("Basic QP test solve: Error in solver status!",
+        solver->info->status_val == OSQP_SOLVED);
+
+    // Compare primal and dual solutions
+    mu_assert("Basic QP test solve: Error in primal solution!",
+        vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+              data->n) < TESTS_TOL);
+    mu_assert("Basic QP test solve: Error in dual solution!",
+        vec_norm_inf_diff(solver->solution->y, sols_data->y_test,
+              data->m) < TESTS_TOL);
+
+    mu_assert("Basic QP test solve: Error in rho of the winner!",
+        (solver->settings->rho >= 1e-4 && solver->settings->rho <= 1e2));
+
+    // The main solver continued with the rho of a winning replica. This problem
+    // may be solved before the replicas start, the large QP test checks they run.
+    CAPTURE(k, race_started(solver->work->race), race_winner(solver->work->race));
+    mu_assert("Basic QP test solve: Error in the number of solvers of the race!",
+        (race_started(solver->work->race) >= 1 &&
+         race_started(solver->work->race) <= settings->rho_racing));
+    mu_assert("Basic QP test solve: Error in the winner of the race!",
+        (race_winner(solver->work->race) >= 0 &&
+         race_winner(solver->work->race) < settings->rho_racing));
+    if (race_winner(solver->work->race) > 0)
+      mu_assert("Basic QP test solve: The rho of the winning replica was not adopted!",
+          solver->settings->rho != rho);
+  }
+}
+#endif /* ifdef OSQP_ENABLE_OPENMP */
+
+TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Lean solve", "[solve][qp]")
+{
+  OSQPInt exitflag;
+
+  std::vector<OSQPFloat> x(data->n), y(data->m);
+  std::vector<OSQPFloat> prim_inf_cert(data->m), dual_inf_cert(data->n);
+  OSQPSolution solution = { x.data(), y.data(), prim_inf_cert.data(), dual_inf_cert.data() };
+
+  // Test-specific options: the lean solve does not polish or print
+  settings->polishing     = 1;
+  settings->verbose       = 1;
+  settings->scaling       = 1;
+  settings->warm_starting = 0;
+  settings->eps_abs       = 1e-6;
+  settings->eps_rel       = 1e-6;
+
+  /* Test all possible linear system solvers in this test case */
+  settings->linsys_solver = GENERATE(filter(&isLinsysSupported, values({OSQP_DIRECT_SOLVER, OSQP_INDIRECT_SOLVER})));
+
+  CAPTURE(settings->linsys_solver);
+
+  // Setup solver
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  // Setup correct
+  mu_assert("Basic QP test lean solve: Setup error!", exitflag == 0);
+
+  // The solution in the solver is not touched
+  solver->solution->x[0] = 42.0;
+
+  // Solve Problem
+  exitflag = osqp_solve_lean(solver.get(), &solution);
+
+  mu_assert("Basic QP test lean solve: Solve error!", exitflag == 0);
+
+  // Compare solver statuses
+  mu_assert("Basic QP test lean solve: Error in solver status!",
+      solver->info->status_val == sols_data->status_test);
+
+  // Compare primal solutions
+  mu_assert("Basic QP test lean solve: Error in primal solution!",
+      vec_norm_inf_diff(x.data(), sols_data->x_test,
+            data->n) < TESTS_TOL);
+
+  // Compare dual solutions
+  mu_assert("Basic QP test lean solve: Error in dual solution!",
+      vec_norm_inf_diff(y.data(), sols_data->y_test,
+            data->m) < TESTS_TOL);
+
+  // Compare objective values
+  mu_assert("Basic QP test lean solve: Error in objective value!",
+      c_absval(solver->info->obj_val - sols_data->obj_value_test) <
+      TESTS_TOL);
+
+  mu_assert("Basic QP test lean solve: Solver solution overwritten!",
+      solver->solution->x[0] == 42.0);
+
+#ifdef OSQP_ENABLE_PROFILING
+  mu_assert("Basic QP test lean solve: Solve time measured!",
+      solver->info->solve_time == 0.0);
+#endif
+
+  // The regular solve still works afterwards
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP test lean solve: Error in primal solution after osqp_solve!",
+      vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+            data->n) < TESTS_TOL);
+}
+
+TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Multiple right-hand sides", "[solve][qp]")
+{
+  OSQPInt exitflag;
+  OSQPInt i, j;
+
+  // More right-hand sides than are solved together in one block
+  const OSQPInt k   = 11;
+  const OSQPInt len = data->n + data->m;
+
+  settings->linsys_solver = GENERATE(filter(&isLinsysSupported, values({OSQP_DIRECT_SOLVER, OSQP_INDIRECT_SOLVER})));
+
+  CAPTURE(settings->linsys_solver);
+
+  // Setup solver
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Basic QP test multiple rhs: Setup error!", exitflag == 0);
+
+  LinSysSolver* linsys = solver->work->linsys_solver;
+
+  // Only some linear system solvers support multiple right-hand sides
+  if (!linsys->solve_multi)
+    return;
+
+  std::unique_ptr<OSQPFloat[]> rhs(new OSQPFloat[k*len]);
+  for (i = 0; i < k*len; i++)
+    rhs[i] = (OSQPFloat)((i * 37) % 17) - 8.0;
+
+  OSQPVectorf_ptr multi{OSQPVectorf_new(rhs.get(), k*len)};
+  exitflag = linsys->solve_multi(linsys, multi.get(), k);
+
+  mu_assert("Basic QP test multiple rhs: Solve error!", exitflag == 0);
+
+  // Every right-hand side matches a single solve
+  for (j = 0; j < k; j++) {
+    OSQPVectorf_ptr single{OSQPVectorf_new(rhs.get() + j*len, len)};
+    linsys->solve(linsys, single.get(), 0);
+
+    mu_assert("Basic QP test multiple rhs: Error in solution!",
+              vec_norm_inf_diff(OSQPVectorf_data(multi.get()) + j*len,
+                                OSQPVectorf_data(single.get()), len) < TESTS_TOL);
+  }
+}
+
 TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Settings", "[solve][qp]")
 {
   OSQPInt        exitflag;
@@ -152,6 +557,16 @@ TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Settings", "[solve][qp]")
 	    osqp_update_settings(solver.get(), settings.get()) > 0);
   settings->check_termination = OSQP_CHECK_TERMINATION;
 
+  settings->check_infeasibility = -1;
+  mu_assert("Basic QP test solve: Wrong value of check_infeasibility not caught!",
+	    osqp_update_settings(solver.get(), settings.get()) > 0);
+  settings->check_infeasibility = OSQP_CHECK_INFEASIBILITY;
+
+  settings->infeasibility_stall = -1;
+  mu_assert("Basic QP test solve: Wrong value of infeasibility_stall not caught!",
+	    osqp_update_settings(solver.get(), settings.get()) > 0);
+  settings->infeasibility_stall = OSQP_INFEASIBILITY_STALL;
+
   settings->delta = 0.0;
   mu_assert("Basic QP test solve: Wrong value of delta not caught!",
 	    osqp_update_settings(solver.get(), settings.get()) > 0);
@@ -167,6 +582,21 @@ TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Settings", "[solve][qp]")
 	    osqp_update_settings(solver.get(), settings.get()) > 0);
   settings->polish_refine_iter = OSQP_POLISH_REFINE_ITER;
 
+  settings->polish_schur = -1;
+  mu_assert("Basic QP test solve: Wrong value of polish_schur not caught!",
+	    osqp_update_settings(solver.get(), settings.get()) > 0);
+  settings->polish_schur = OSQP_POLISH_SCHUR;
+
+  settings->polish_speculative = -1;
+  mu_assert("Basic QP test solve: Wrong value of polish_speculative not caught!",
+	    osqp_update_settings(solver.get(), settings.get()) > 0);
+  settings->polish_speculative = OSQP_POLISH_SPECULATIVE;
+
+  settings->rho_racing = -1;
+  mu_assert("Basic QP test solve: Wrong value of rho_racing not caught!",
+	    osqp_update_settings(solver.get(), settings.get()) > 0);
+  settings->rho_racing = OSQP_RHO_RACING;
+
   settings->verbose = 2;
   mu_assert("Basic QP test solve: Wrong value of verbose not caught!",
 	    osqp_update_settings(solver.get(), settings.get()) > 0);
@@ -422,6 +852,40 @@ TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Settings", "[solve][qp]")
   settings->time_limit = tmp_float;
 #endif
 
+  // Setup solver with both acceleration schemes
+  settings->nesterov     = 1;
+  settings->anderson_mem = 5;
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+  mu_assert("Basic QP test solve: Setup should result in error due to nesterov combined with anderson_mem",
+            exitflag == OSQP_SETTINGS_VALIDATION_ERROR);
+  settings->nesterov     = 0;
+  settings->anderson_mem = 0;
+
+  // Setup solver with wrong settings->warm_start_predict
+  settings->warm_start_predict = 2;
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+  mu_assert("Basic QP test solve: Setup should result in error due to non-boolean settings->warm_start_predict",
+            exitflag == OSQP_SETTINGS_VALIDATION_ERROR);
+  settings->warm_start_predict = 0;
+
+  // Setup solver with per-constraint rho but a scalar rho
+  settings->adaptive_rho_vec = 1;
+  settings->rho_is_vec       = 0;
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+  mu_assert("Basic QP test solve: Setup should result in error due to adaptive_rho_vec without rho_is_vec",
+            exitflag == OSQP_SETTINGS_VALIDATION_ERROR);
+  settings->adaptive_rho_vec = 0;
+  settings->rho_is_vec       = 1;
+
 
   /* =========================
        SETUP WITH WRONG DATA
@@ -938,6 +1402,22 @@ TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Time limit", "[solve][qp]")
   // Compare solver statuses
   mu_assert("Basic QP test time limit: Error in timed out solver status!",
 	    solver->info->status_val == OSQP_TIME_LIMIT_REACHED);
+
+  // The timer is not read at every iteration, which must not delay the stop
+  // by much once many iterations fit in the limit. The tolerances cannot be
+  // met, so that the solve runs until the limit.
+  settings->time_limit = 1e-3;
+  settings->eps_rel    = 0.0;
+  settings->eps_abs    = 0.0;
+  osqp_update_settings(solver.get(), settings.get());
+
+  osqp_cold_start(solver.get());
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP test time limit: Error in timed out solver status!",
+	    solver->info->status_val == OSQP_TIME_LIMIT_REACHED);
+  mu_assert("Basic QP test time limit: Time limit exceeded by too much!",
+	    solver->info->run_time < 10 * settings->time_limit);
 }
 #endif // OSQP_ENABLE_PROFILING
 
@@ -991,3 +1471,425 @@ TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Warm start", "[solve][qp][war
     mu_assert("Basic QP test warm start: Warm start error!", solver->info->iter == 1);
   }
 }
+
+
+TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Warm start prediction", "[solve][qp][warm-start]")
+{
+  OSQPInt exitflag;
+  OSQPInt iter[2] = { 0, 0 };
+  OSQPInt k, pr;
+
+  OSQPFloat q[2];
+  OSQPFloat x_plain[6][2];
+
+  // Setup problem-specific setting
+  settings->check_termination = 1;
+  settings->adaptive_rho      = 0;
+  settings->eps_abs           = 1e-6;
+  settings->eps_rel           = 1e-6;
+
+  // Solve the same sequence of problems without and with the prediction
+  for (pr = 0; pr < 2; pr++) {
+    settings->warm_start_predict = pr;
+
+    exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                          data->A, data->l, data->u,
+                          data->m, data->n, settings.get());
+    solver.reset(tmpSolver);
+    mu_assert("Basic QP test warm start prediction: Setup error!", exitflag == 0);
+
+    // Move q along a line, with the same active constraints
+    for (k = 0; k < 6; k++) {
+      q[0] = data->q[0] + 0.05 * k;
+      q[1] = data->q[1] - 0.05 * k;
+      exitflag = osqp_update_data_vec(solver.get(), q, OSQP_NULL, OSQP_NULL);
+      mu_assert("Basic QP test warm start prediction: Data update error!", exitflag == 0);
+
+      exitflag = osqp_solve(solver.get());
+      mu_assert("Basic QP test warm start prediction: Error in solver!", exitflag == 0);
+      mu_assert("Basic QP test warm start prediction: Error in solver status!",
+          solver->info->status_val == OSQP_SOLVED);
+
+      if (pr == 0) {
+        x_plain[k][0] = solver->solution->x[0];
+        x_plain[k][1] = solver->solution->x[1];
+        mu_assert("Basic QP test warm start prediction: Prediction without the setting!",
+            solver->info->status_pred == OSQP_PRED_NOT_PERFORMED);
+      }
+      else {
+        mu_assert("Basic QP test warm start prediction: Error in primal solution!",
+            vec_norm_inf_diff(solver->solution->x, x_plain[k], data->n) < TESTS_TOL);
+
+        // Two solutions on the path are needed for the secant
+        if (k >= 2) {
+          mu_assert("Basic QP test warm start prediction: Prediction not used!",
+              solver->info->status_pred == OSQP_PRED_USED);
+          mu_assert("Basic QP test warm start prediction: No iterations saved reported!",
+              solver->info->pred_iter_saved > 0.0);
+        }
+      }
+      iter[pr] += solver->info->iter;
+    }
+  }
+
+  mu_assert("Basic QP test warm start prediction: No iterations saved!", iter[1] < iter[0]);
+}
+
+/* Products with a CSC matrix used to wrap the test data into operators */
+static void csc_mult(void* data, const OSQPFloat* x, OSQPFloat* y)
+{
+  const OSQPCscMatrix* M = (const OSQPCscMatrix*) data;
+
+  for (OSQPInt i = 0; i < M->m; i++) y[i] = 0.0;
+  for (OSQPInt j = 0; j < M->n; j++)
+    for (OSQPInt k = M->p[j]; k < M->p[j+1]; k++)
+      y[M->i[k]] += M->x[k] * x[j];
+}
+
+static void csc_mult_t(void* data, const OSQPFloat* x, OSQPFloat* y)
+{
+  const OSQPCscMatrix* M = (const OSQPCscMatrix*) data;
+
+  for (OSQPInt j = 0; j < M->n; j++) {
+    y[j] = 0.0;
+    for (OSQPInt k = M->p[j]; k < M->p[j+1]; k++)
+      y[j] += M->x[k] * x[M->i[k]];
+  }
+}
+
+/* P is stored as its upper triangular part */
+static void csc_mult_symm(void* data, const OSQPFloat* x, OSQPFloat* y)
+{
+  const OSQPCscMatrix* M = (const OSQPCscMatrix*) data;
+
+  csc_mult(data, x, y);
+  for (OSQPInt j = 0; j < M->n; j++)
+    for (OSQPInt k = M->p[j]; k < M->p[j+1]; k++)
+      if (M->i[k] != j) y[j] += M->x[k] * x[M->i[k]];
+}
+
+TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Matrix-free operators", "[solve][qp]")
+{
+  OSQPInt exitflag;
+  OSQPInt n = data->n;
+
+  if (!(osqp_capabilities() & OSQP_CAPABILITY_MATRIX_FREE)) {
+    exitflag = osqp_setup_operator(&tmpSolver, OSQP_NULL, data->q, OSQP_NULL,
+                                   data->l, data->u, data->m, n, settings.get());
+    mu_assert("Basic QP test operators: Missing capability not reported!",
+              exitflag == OSQP_FUNC_NOT_IMPLEMENTED);
+    return;
+  }
+
+  // Diagonal of P and squared column norms of A
+  std::vector<OSQPFloat> Pdiag(n, 0.0);
+  std::vector<OSQPFloat> Adiag(n, 0.0);
+  for (OSQPInt j = 0; j < n; j++) {
+    for (OSQPInt k = data->P->p[j]; k < data->P->p[j+1]; k++)
+      if (data->P->i[k] == j) Pdiag[j] = data->P->x[k];
+    for (OSQPInt k = data->A->p[j]; k < data->A->p[j+1]; k++)
+      Adiag[j] += data->A->x[k] * data->A->x[k];
+  }
+
+  OSQPOperator Pop = {n, n, &csc_mult_symm, OSQP_NULL, Pdiag.data(), data->P};
+  OSQPOperator Aop = {data->m, n, &csc_mult, &csc_mult_t, Adiag.data(), data->A};
+
+  // Ignored for operators
+  settings->linsys_solver = OSQP_DIRECT_SOLVER;
+  settings->polishing     = 1;
+  settings->scaling       = 10;
+
+  settings->eps_abs = 1e-5;
+  settings->eps_rel = 1e-5;
+  settings->rho_is_vec = GENERATE(0, 1);
+
+  CAPTURE(settings->rho_is_vec);
+
+  exitflag = osqp_setup_operator(&tmpSolver, &Pop, data->q, &Aop,
+                                 data->l, data->u, data->m, n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Basic QP test operators: Setup error!", exitflag == 0);
+  mu_assert("Basic QP test operators: Settings not overridden!",
+            (solver->settings->linsys_solver == OSQP_INDIRECT_SOLVER &&
+             solver->settings->scaling == 0 &&
+             solver->settings->polishing == 0));
+
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP test operators: Error in solver status!",
+      solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Basic QP test operators: Error in primal solution!",
+      vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+            n) < TESTS_TOL);
+
+  mu_assert("Basic QP test operators: Error in dual solution!",
+      vec_norm_inf_diff(solver->solution->y, sols_data->y_test,
+            data->m) < TESTS_TOL);
+
+  // The values of operators cannot be updated
+  exitflag = osqp_update_data_mat(solver.get(), data->P->x, OSQP_NULL, data->P->nzmax,
+                                  OSQP_NULL, OSQP_NULL, 0);
+  mu_assert("Basic QP test operators: Matrix update not rejected!",
+            exitflag == OSQP_FUNC_NOT_IMPLEMENTED);
+
+  // Polishing stays disabled
+  settings->polishing = 1;
+  osqp_update_settings(solver.get(), settings.get());
+  mu_assert("Basic QP test operators: Polishing enabled!",
+            solver->settings->polishing == 0);
+}
+
+TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Anderson acceleration", "[solve][qp]")
+{
+  OSQPInt exitflag;
+
+  // Test-specific options
+  settings->polishing         = 1;
+  settings->scaling           = 0;
+  settings->warm_starting     = 0;
+  settings->check_termination = 1;
+
+  settings->anderson_mem  = GENERATE(1, 5, 10);
+  settings->linsys_solver = GENERATE(filter(&isLinsysSupported, values({OSQP_DIRECT_SOLVER, OSQP_INDIRECT_SOLVER})));
+
+  CAPTURE(settings->anderson_mem, settings->linsys_solver);
+
+  // Setup solver
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Basic QP test Anderson: Setup error!", exitflag == 0);
+
+  // Solve Problem
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP test Anderson: Error in solver status!",
+      solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Basic QP test Anderson: Error in primal solution!",
+      vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+            data->n) < TESTS_TOL);
+
+  mu_assert("Basic QP test Anderson: Error in dual solution!",
+      vec_norm_inf_diff(solver->solution->y, sols_data->y_test,
+            data->m) < TESTS_TOL);
+
+  // Solving again starts from a cleared memory
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP test Anderson: Error in solver status after resolve!",
+      solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Basic QP test Anderson: Error in primal solution after resolve!",
+      vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+            data->n) < TESTS_TOL);
+}
+
+TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Adaptive termination checks", "[solve][qp]")
+{
+  OSQPInt exitflag;
+  OSQPInt iter_fixed;
+
+  // Test-specific options
+  settings->scaling               = 0;
+  settings->warm_starting         = 1;
+  settings->check_termination     = 25;
+  settings->adaptive_rho_interval = 25;
+
+  settings->linsys_solver = GENERATE(filter(&isLinsysSupported, values({OSQP_DIRECT_SOLVER, OSQP_INDIRECT_SOLVER})));
+
+  CAPTURE(settings->linsys_solver);
+
+  // Fixed checking interval for reference
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Basic QP test adaptive termination: Setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+  iter_fixed = solver->info->iter;
+
+  // Adaptive checking interval
+  settings->adaptive_termination = 1;
+  osqp_update_settings(solver.get(), settings.get());
+  osqp_cold_start(solver.get());
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP test adaptive termination: Error in solver status!",
+      solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Basic QP test adaptive termination: Error in primal solution!",
+      vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+            data->n) < TESTS_TOL);
+
+  mu_assert("Basic QP test adaptive termination: Error in dual solution!",
+      vec_norm_inf_diff(solver->solution->y, sols_data->y_test,
+            data->m) < TESTS_TOL);
+
+  mu_assert("Basic QP test adaptive termination: More iterations than with a fixed interval!",
+      solver->info->iter <= iter_fixed);
+
+  // A warm-started solve from the solution terminates at the first check,
+  // well before the longest interval
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP test adaptive termination: Error in solver status after warm start!",
+      solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Basic QP test adaptive termination: Late termination after warm start!",
+      solver->info->iter < settings->check_termination);
+}
+
+TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Batch solve", "[solve][qp]")
+{
+  OSQPInt exitflag;
+  OSQPInt k, i;
+
+  const OSQPInt nbatch = 6;
+  const OSQPInt bad    = 3;
+  OSQPInt n    = data->n;
+  OSQPInt m    = data->m;
+  OSQPInt nnzP = data->P->p[n];
+
+  // Instances with scaled P and q, and crossed bounds in instance bad
+  std::vector<OSQPFloat> Px(nbatch * nnzP), q(nbatch * n);
+  std::vector<OSQPFloat> l(nbatch * m), u(nbatch * m);
+  std::vector<OSQPFloat> x(nbatch * n), y(nbatch * m);
+  std::vector<OSQPSolution> solutions(nbatch);
+  std::vector<OSQPInfo> infos(nbatch);
+
+  for (k = 0; k < nbatch; k++) {
+    for (i = 0; i < nnzP; i++)
+      Px[k * nnzP + i] = data->P->x[i] * (1.0 + 0.2 * k);
+    for (i = 0; i < n; i++)
+      q[k * n + i] = data->q[i] * (1.0 - 0.1 * k);
+    for (i = 0; i < m; i++) {
+      l[k * m + i] = data->l[i];
+      u[k * m + i] = data->u[i];
+    }
+    solutions[k] = { &x[k * n], &y[k * m], OSQP_NULL, OSQP_NULL };
+  }
+  l[bad * m] = u[bad * m] + 1.0;
+
+  // Test-specific options
+  settings->verbose = 0;
+  settings->eps_abs = 1e-6;
+  settings->eps_rel = 1e-6;
+
+  exitflag = osqp_solve_batch(nbatch, data->P, Px.data(), q.data(),
+                              data->A, OSQP_NULL, l.data(), u.data(),
+                              m, n, settings.get(), 3,
+                              solutions.data(), infos.data(), OSQP_NULL);
+
+  mu_assert("Basic QP test batch: Crossed bounds not reported!",
+      exitflag == OSQP_DATA_VALIDATION_ERROR);
+  mu_assert("Basic QP test batch: Error in status of the invalid instance!",
+      infos[bad].status_val == OSQP_UNSOLVED);
+
+  // The other instances match separate solves
+  for (k = 0; k < nbatch; k++) {
+    if (k == bad) continue;
+    CAPTURE(k);
+
+    OSQPCscMatrix Pk = *data->P;
+    Pk.x = &Px[k * nnzP];
+
+    exitflag = osqp_setup(&tmpSolver, &Pk, &q[k * n],
+                          data->A, &l[k * m], &u[k * m],
+                          m, n, settings.get());
+    solver.reset(tmpSolver);
+    mu_assert("Basic QP test batch: Setup error!", exitflag == 0);
+
+    osqp_solve(solver.get());
+
+    mu_assert("Basic QP test batch: Error in solver status!",
+        infos[k].status_val == solver->info->status_val);
+    mu_assert("Basic QP test batch: Error in primal solution!",
+        vec_norm_inf_diff(&x[k * n], solver->solution->x, n) < TESTS_TOL);
+    mu_assert("Basic QP test batch: Error in dual solution!",
+        vec_norm_inf_diff(&y[k * m], solver->solution->y, m) < TESTS_TOL);
+  }
+}
+
+TEST_CASE_METHOD(basic_qp_test_fixture, "Basic QP: Batch solve with failed setups", "[solve][qp]")
+{
+  OSQPInt exitflag;
+  OSQPInt k, i;
+
+  // With 3 threads the blocks are 0-2, 3-5 and 6-8. The setup of the second
+  // block fails for its first two instances, and instance 7 fails its update.
+  const OSQPInt nbatch = 9;
+  const OSQPInt nbad   = 3;
+  const OSQPInt bad[3] = { 3, 4, 7 };
+  OSQPInt n = data->n;
+  OSQPInt m = data->m;
+
+  std::vector<OSQPFloat> q(nbatch * n), l(nbatch * m), u(nbatch * m);
+  std::vector<OSQPFloat> x(nbatch * n), y(nbatch * m);
+  std::vector<OSQPSolution> solutions(nbatch);
+  std::vector<OSQPInfo> infos(nbatch);
+  std::vector<OSQPInt> exitflags(nbatch, -1);
+  std::vector<bool> is_bad(nbatch, false);
+
+  for (k = 0; k < nbatch; k++) {
+    for (i = 0; i < n; i++)
+      q[k * n + i] = data->q[i] * (1.0 - 0.1 * k);
+    for (i = 0; i < m; i++) {
+      l[k * m + i] = data->l[i];
+      u[k * m + i] = data->u[i];
+    }
+    solutions[k] = { &x[k * n], &y[k * m], OSQP_NULL, OSQP_NULL };
+  }
+  for (k = 0; k < nbad; k++) {
+    l[bad[k] * m] = u[bad[k] * m] + 1.0;
+    is_bad[bad[k]] = true;
+  }
+
+  // Test-specific options
+  settings->verbose = 0;
+  settings->eps_abs = 1e-6;
+  settings->eps_rel = 1e-6;
+
+  exitflag = osqp_solve_batch(nbatch, data->P, OSQP_NULL, q.data(),
+                              data->A, OSQP_NULL, l.data(), u.data(),
+                              m, n, settings.get(), 3,
+                              solutions.data(), infos.data(), exitflags.data());
+
+  mu_assert("Basic QP test batch setup: Crossed bounds not reported!",
+      exitflag == OSQP_DATA_VALIDATION_ERROR);
+
+  for (k = 0; k < nbatch; k++) {
+    CAPTURE(k);
+
+    if (is_bad[k]) {
+      mu_assert("Basic QP test batch setup: Error in status of an invalid instance!",
+          infos[k].status_val == OSQP_UNSOLVED);
+      mu_assert("Basic QP test batch setup: Error in exitflag of an invalid instance!",
+          exitflags[k] == OSQP_DATA_VALIDATION_ERROR);
+      continue;
+    }
+
+    // The other instances match separate solves
+    exitflag = osqp_setup(&tmpSolver, data->P, &q[k * n],
+                          data->A, &l[k * m], &u[k * m],
+                          m, n, settings.get());
+    solver.reset(tmpSolver);
+    mu_assert("Basic QP test batch setup: Setup error!", exitflag == 0);
+
+    osqp_solve(solver.get());
+
+    mu_assert("Basic QP test batch setup: Error in exitflag!", exitflags[k] == 0);
+    mu_assert("Basic QP test batch setup: Error in solver status!",
+        infos[k].status_val == solver->info->status_val);
+    mu_assert("Basic QP test batch setup: Error in primal solution!",
+        vec_norm_inf_diff(&x[k * n], solver->solution->x, n) < TESTS_TOL);
+    mu_assert("Basic QP test batch setup: Error in dual solution!",
+        vec_norm_inf_diff(&y[k * m], solver->solution->y, m) < TESTS_TOL);
+  }
+}
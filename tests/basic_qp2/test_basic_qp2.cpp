@@ -128,3 +128,208 @@ TEST_CASE_METHOD(basic_qp2_test_fixture, "Basic QP2: Update vectors", "[solve],[
   mu_assert("Basic QP 2 test solve: Error in polish status!",
             solver->info->status_polish == OSQP_POLISH_SUCCESS);
 }
+
+TEST_CASE_METHOD(basic_qp2_test_fixture, "Basic QP2: Nesterov acceleration", "[solve],[qp],[update]")
+{
+  OSQPInt exitflag;
+  OSQPInt iter_plain;
+
+  // Need slightly tighter tolerances on this problem to pass the tests
+  settings->eps_abs           = 1e-6;
+  settings->eps_rel           = 1e-6;
+  settings->polishing         = 0;
+  settings->warm_starting     = 0;
+  settings->check_termination = 1;
+
+  // Fixed interval so that the iteration counts do not depend on timings
+  settings->adaptive_rho_interval = 25;
+
+  /* Test all possible linear system solvers in this test case */
+  settings->linsys_solver = GENERATE(filter(&isLinsysSupported, values({OSQP_DIRECT_SOLVER, OSQP_INDIRECT_SOLVER})));
+
+  CAPTURE(settings->linsys_solver);
+
+  // Plain ADMM for reference
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Basic QP 2 test Nesterov: Setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+  iter_plain = solver->info->iter;
+
+  // Accelerated ADMM
+  settings->nesterov = 1;
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Basic QP 2 test Nesterov: Setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP 2 test Nesterov: Error in solver status!",
+            solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Basic QP 2 test Nesterov: Error in primal solution!",
+            vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+                              data->n) /
+            vec_norm_inf(sols_data->x_test_new, data->n) < TESTS_TOL);
+
+  mu_assert("Basic QP 2 test Nesterov: Error in dual solution!",
+            vec_norm_inf_diff(solver->solution->y, sols_data->y_test,
+                              data->m) /
+            vec_norm_inf(sols_data->y_test_new, data->m) < TESTS_TOL);
+
+  // This problem converges slowly without acceleration. The inexact solves of
+  // the indirect solver perturb the residual that triggers the restarts.
+  if (settings->linsys_solver == OSQP_DIRECT_SOLVER)
+    mu_assert("Basic QP 2 test Nesterov: No reduction of the iterations!",
+              solver->info->iter < iter_plain);
+
+  // Warm-started solve after a data update
+  settings->warm_starting = 1;
+  osqp_update_settings(solver.get(), settings.get());
+  osqp_update_data_vec(solver.get(), sols_data->q_new, NULL, sols_data->u_new);
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP 2 test Nesterov: Error in solver status after update!",
+            solver->info->status_val == sols_data->status_test_new);
+
+  mu_assert("Basic QP 2 test Nesterov: Error in primal solution after update!",
+            vec_norm_inf_diff(solver->solution->x, sols_data->x_test_new,
+                              data->n) /
+            vec_norm_inf(sols_data->x_test_new, data->n) < TESTS_TOL);
+}
+
+TEST_CASE_METHOD(basic_qp2_test_fixture, "Basic QP2: Anderson acceleration", "[solve],[qp]")
+{
+  OSQPInt exitflag;
+  OSQPInt iter_plain;
+
+  // Need slightly tighter tolerances on this problem to pass the tests
+  settings->eps_abs           = 1e-5;
+  settings->eps_rel           = 1e-5;
+  settings->polishing         = 0;
+  settings->warm_starting     = 0;
+  settings->check_termination = 1;
+
+  // Fixed interval so that the iteration counts do not depend on timings
+  settings->adaptive_rho_interval = 25;
+
+  settings->scaling = GENERATE(0, 10);
+
+  CAPTURE(settings->scaling);
+
+  // Plain ADMM for reference
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Basic QP 2 test Anderson: Setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+  iter_plain = solver->info->iter;
+
+  // Accelerated ADMM, including memories larger than the problem
+  settings->anderson_mem = GENERATE(3, 5, 10);
+
+  CAPTURE(settings->anderson_mem);
+
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Basic QP 2 test Anderson: Setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP 2 test Anderson: Error in solver status!",
+            solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Basic QP 2 test Anderson: Error in primal solution!",
+            vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+                              data->n) /
+            vec_norm_inf(sols_data->x_test_new, data->n) < TESTS_TOL);
+
+  // Rejected extrapolations cost one iteration each, the safeguard must keep
+  // them from outweighing the accepted ones
+  mu_assert("Basic QP 2 test Anderson: More iterations than plain ADMM!",
+            solver->info->iter <= iter_plain);
+}
+
+TEST_CASE_METHOD(basic_qp2_test_fixture, "Basic QP2: Per-constraint adaptive rho", "[solve],[qp],[update]")
+{
+  OSQPInt exitflag;
+  OSQPInt iter_plain;
+
+  // Need slightly tighter tolerances on this problem to pass the tests
+  settings->eps_abs           = 1e-6;
+  settings->eps_rel           = 1e-6;
+  settings->polishing         = 0;
+  settings->warm_starting     = 0;
+  settings->check_termination = 5;
+
+  // Fixed interval so that the iteration counts do not depend on timings
+  settings->adaptive_rho_interval = 25;
+
+  /* Test all possible linear system solvers in this test case */
+  settings->linsys_solver = GENERATE(filter(&isLinsysSupported, values({OSQP_DIRECT_SOLVER, OSQP_INDIRECT_SOLVER})));
+
+  CAPTURE(settings->linsys_solver);
+
+  // One rho per constraint type for reference
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Basic QP 2 test rho vector: Setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+  iter_plain = solver->info->iter;
+
+  // One rho per constraint
+  settings->adaptive_rho_vec = 1;
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Basic QP 2 test rho vector: Setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP 2 test rho vector: Error in solver status!",
+            solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Basic QP 2 test rho vector: Error in primal solution!",
+            vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+                              data->n) /
+            vec_norm_inf(sols_data->x_test_new, data->n) < TESTS_TOL);
+
+  mu_assert("Basic QP 2 test rho vector: Error in dual solution!",
+            vec_norm_inf_diff(solver->solution->y, sols_data->y_test,
+                              data->m) /
+            vec_norm_inf(sols_data->y_test_new, data->m) < TESTS_TOL);
+
+  mu_assert("Basic QP 2 test rho vector: No reduction of the iterations!",
+            solver->info->iter < iter_plain);
+
+  // The constraint types do not change, so the adapted rho values are kept
+  osqp_update_data_vec(solver.get(), sols_data->q_new, NULL, sols_data->u_new);
+  osqp_solve(solver.get());
+
+  mu_assert("Basic QP 2 test rho vector: Error in solver status after update!",
+            solver->info->status_val == sols_data->status_test_new);
+
+  mu_assert("Basic QP 2 test rho vector: Error in primal solution after update!",
+            vec_norm_inf_diff(solver->solution->x, sols_data->x_test_new,
+                              data->n) /
+            vec_norm_inf(sols_data->x_test_new, data->n) < TESTS_TOL);
+}
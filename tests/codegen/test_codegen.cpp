@@ -415,6 +415,19 @@ TEST_CASE_METHOD(codegen_test_fixture, "Codegen: Error propgatation", "[codegen]
               exitflag == OSQP_WORKSPACE_NOT_INIT_ERROR);
   }
 
+  SECTION( "Indirect linear system solver" ) {
+    // Only the direct solver can be exported
+    enum osqp_linsys_solver_type tmpType = solver->work->linsys_solver->type;
+    solver->work->linsys_solver->type = OSQP_INDIRECT_SOLVER;
+
+    exitflag = osqp_codegen(solver.get(), CODEGEN_DIR, "error_", defines.get());
+
+    solver->work->linsys_solver->type = tmpType;
+
+    mu_assert("Indirect solver not rejected!",
+              exitflag == OSQP_FUNC_NOT_IMPLEMENTED);
+  }
+
   SECTION( "Missing data struct" ) {
     // Artificially delete all the data
     void *tmpVar = solver->work->data;
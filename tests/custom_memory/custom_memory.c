@@ -7,9 +7,15 @@
  */
 long int alloc_counter = 0;
 
+/* Total number of calls to the allocators, to check that a code path
+   does not allocate memory.
+ */
+long int malloc_counter = 0;
+
 void* my_malloc(size_t size) {
   void *m = malloc(size);
   alloc_counter++;
+  malloc_counter++;
   /* printf("OSQP allocator  (malloc): %zu bytes, %ld allocations \n",size, alloc_counter); */
   return m;
 }
@@ -17,12 +23,14 @@ void* my_malloc(size_t size) {
 void* my_calloc(size_t num, size_t size) {
   void *m = calloc(num, size);
   alloc_counter++;
+  malloc_counter++;
   /* printf("OSQP allocator  (calloc): %zu bytes, %ld allocations \n",num*size, alloc_counter); */
   return m;
 }
 
 void* my_realloc(void *ptr, size_t size) {
   void *m = realloc(ptr,size);
+  malloc_counter++;
   /* printf("OSQP allocator (realloc) : %zu bytes, %ld allocations \n",size, alloc_counter); */
   return m;
 }
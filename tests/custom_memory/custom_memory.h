@@ -20,6 +20,9 @@ void* my_calloc(size_t num, size_t size);
 void* my_realloc(void *ptr, size_t size);
 void  my_free(void *ptr);
 
+/* Total number of calls to my_malloc, my_calloc and my_realloc */
+extern long int malloc_counter;
+
 # ifdef __cplusplus
 }
 # endif
@@ -0,0 +1,66 @@
+#include <catch2/catch.hpp>
+
+#include "osqp_api.h"    /* OSQP API wrapper (public + some private) */
+#include "osqp_tester.h" /* Tester helpers */
+#include "test_utils.h"  /* Testing Helper functions */
+
+#include "basic_qp_data.h"
+
+/* With OSQP_CUSTOM_MEMORY, glob_opts.h includes custom_memory.h that declares
+   malloc_counter */
+
+
+TEST_CASE_METHOD(basic_qp_test_fixture, "Custom memory: Allocation-free solve", "[solve][qp][memory]")
+{
+#ifndef OSQP_CUSTOM_MEMORY
+  WARN("OSQP is not built with the custom memory allocators, allocations are not counted");
+#else
+  OSQPInt exitflag;
+  long int allocs;
+
+  // Test-specific options
+  settings->polishing     = 1;
+  settings->verbose       = 0;
+  settings->linsys_solver = OSQP_DIRECT_SOLVER;
+  settings->polish_schur  = GENERATE(0, 100);
+
+  CAPTURE(settings->polish_schur);
+
+  // Setup solver
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  // Setup correct
+  mu_assert("Custom memory test solve: Setup error!", exitflag == 0);
+
+  // The first solve may allocate the polishing workspace
+  osqp_solve(solver.get());
+
+  mu_assert("Custom memory test solve: Error in polishing status!",
+      solver->info->status_polish == OSQP_POLISH_SUCCESS);
+
+  // Later solves must not allocate
+  allocs = malloc_counter;
+  osqp_solve(solver.get());
+
+  mu_assert("Custom memory test solve: Error in polishing status!",
+      solver->info->status_polish == OSQP_POLISH_SUCCESS);
+  mu_assert("Custom memory test solve: Memory allocated in osqp_solve!",
+      malloc_counter == allocs);
+
+  // Same after a cold start
+  osqp_cold_start(solver.get());
+  allocs = malloc_counter;
+  osqp_solve(solver.get());
+
+  mu_assert("Custom memory test solve: Memory allocated in osqp_solve!",
+      malloc_counter == allocs);
+
+  // Compare primal solutions
+  mu_assert("Custom memory test solve: Error in primal solution!",
+      vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+            data->n) < TESTS_TOL);
+#endif
+}
@@ -10,6 +10,7 @@ import no_active_set.generate_problem
 import non_cvx.generate_problem
 import primal_dual_infeasibility.generate_problem
 import primal_infeasibility.generate_problem
+import reduced_kkt.generate_problem
 import solve_linsys.generate_problem
 import unconstrained.generate_problem
 import update_matrices.generate_problem
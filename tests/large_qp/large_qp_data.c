@@ -8,36 +8,40 @@
 
 OSQPFloat prob1_obj_val = 0.106081;
 
-/* Define the settings structure */
+/* Define the settings structure. The fields are named so that the initializer
+ * does not depend on the field order. Settings added after the data was
+ * generated stay zero (disabled), except for the infeasibility checks. */
 OSQPSettings prob1_settings = {
-  0,
-  OSQP_DIRECT_SOLVER,
-  0,
-  1,
-  10,
-  0,
-  (OSQPFloat)0.10000000000000000555,
-  1,
-  (OSQPFloat)0.00000100000000000000,
-  (OSQPFloat)1.60000000000000008882,
-  20,
-  10,
-  (OSQPFloat)0.14999999999999999445,
-  OSQP_DIAGONAL_PRECONDITIONER,
-  1,
-  0,
-  (OSQPFloat)0.40000000000000002220,
-  (OSQPFloat)5.00000000000000000000,
-  1000000000,
-  (OSQPFloat)0.00100000000000000002,
-  (OSQPFloat)0.00100000000000000002,
-  (OSQPFloat)0.00000000000000100000,
-  (OSQPFloat)0.00000000000000100000,
-  0,
-  25,
-  (OSQPFloat)1000.00000000000000000000,
-  (OSQPFloat)0.00000100000000000000,
-  3,
+  .device                 = 0,
+  .linsys_solver          = OSQP_DIRECT_SOLVER,
+  .verbose                = 0,
+  .warm_starting          = 1,
+  .scaling                = 10,
+  .polishing              = 0,
+  .rho                    = (OSQPFloat)0.10000000000000000555,
+  .rho_is_vec             = 1,
+  .sigma                  = (OSQPFloat)0.00000100000000000000,
+  .alpha                  = (OSQPFloat)1.60000000000000008882,
+  .cg_max_iter            = 20,
+  .cg_tol_reduction       = 10,
+  .cg_tol_fraction        = (OSQPFloat)0.14999999999999999445,
+  .cg_precond             = OSQP_DIAGONAL_PRECONDITIONER,
+  .cg_method              = OSQP_CG_STANDARD,
+  .adaptive_rho           = 1,
+  .adaptive_rho_interval  = 0,
+  .adaptive_rho_fraction  = (OSQPFloat)0.40000000000000002220,
+  .adaptive_rho_tolerance = (OSQPFloat)5.00000000000000000000,
+  .max_iter               = 1000000000,
+  .eps_abs                = (OSQPFloat)0.00100000000000000002,
+  .eps_rel                = (OSQPFloat)0.00100000000000000002,
+  .eps_prim_inf           = (OSQPFloat)0.00000000000000100000,
+  .eps_dual_inf           = (OSQPFloat)0.00000000000000100000,
+  .scaled_termination     = 0,
+  .check_termination      = 25,
+  .check_infeasibility    = 1,
+  .time_limit             = (OSQPFloat)1000.00000000000000000000,
+  .delta                  = (OSQPFloat)0.00000100000000000000,
+  .polish_refine_iter     = 3,
 };
 
 /* Define the data structure */
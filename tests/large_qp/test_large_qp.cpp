@@ -3,6 +3,7 @@
 #include "osqp_api.h"    /* OSQP API wrapper (public + some private) */
 #include "osqp_tester.h" /* Tester helpers */
 #include "test_utils.h"  /* Testing Helper functions */
+#include "race.h"         /* Rho race of the replicas */
 
 #include "large_qp_data.h"
 
@@ -36,3 +37,45 @@ TEST_CASE_METHOD(OSQPTestFixture, "Large QP solve", "[solve],[qp]")
   mu_assert("Large QP test solve: Error in objective value!",
             c_absval(solver->info->obj_val - prob1_obj_val)/(c_absval(prob1_obj_val)) < TESTS_TOL);
 }
+
+// The replicas of the race run on OpenMP threads
+#ifdef OSQP_ENABLE_OPENMP
+TEST_CASE_METHOD(OSQPTestFixture, "Large QP: Rho racing", "[solve],[qp]")
+{
+  OSQPInt   exitflag;
+  OSQPFloat rho;
+
+  // A poor rho that is not adapted, so that the main solver takes long enough
+  // for the replicas to start on their threads
+  settings->adaptive_rho = 0;
+  settings->rho          = 1e-6;
+  settings->rho_racing   = 5;
+
+  exitflag = osqp_setup(&tmpSolver, &prob1_data_P_csc, prob1_data_q_val,
+                        &prob1_data_A_csc, prob1_data_l_val, prob1_data_u_val,
+                        prob1_data_m, prob1_data_n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Large QP test rho racing: Setup error!", exitflag == 0);
+
+  // Race against replicas with rho = 1e-5, 1e-7, 1e-4, 1e-8
+  rho      = solver->settings->rho;
+  exitflag = osqp_solve(solver.get());
+
+  CAPTURE(race_started(solver->work->race), race_winner(solver->work->race),
+          solver->settings->rho, solver->info->iter);
+
+  mu_assert("Large QP test rho racing: Error in solver!", exitflag == 0);
+  mu_assert("Large QP test rho racing: Error in solver status!",
+            solver->info->status_val == OSQP_SOLVED);
+  mu_assert("Large QP test rho racing: Error in objective value!",
+            c_absval(solver->info->obj_val - prob1_obj_val)/(c_absval(prob1_obj_val)) < TESTS_TOL);
+
+  mu_assert("Large QP test rho racing: No replica ran in the race!",
+            race_started(solver->work->race) > 1);
+  mu_assert("Large QP test rho racing: A replica did not win the race!",
+            race_winner(solver->work->race) > 0);
+  mu_assert("Large QP test rho racing: The rho of the winner was not adopted!",
+            solver->settings->rho != rho);
+}
+#endif /* ifdef OSQP_ENABLE_OPENMP */
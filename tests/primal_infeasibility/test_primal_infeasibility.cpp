@@ -39,3 +39,56 @@ TEST_CASE_METHOD(primal_infeasibility_test_fixture, "Primal infeasibility", "[so
   mu_assert("Primal infeasible QP test solve: Error in solver status!",
             solver->info->status_val == sols_data->status_test);
 }
+
+TEST_CASE_METHOD(primal_infeasibility_test_fixture, "Primal infeasibility: Check schedule", "[solve],[infeasible]")
+{
+  OSQPInt exitflag;
+  OSQPInt iter;
+
+  // Test-specific solver settings
+  settings->scaling       = 0;
+  settings->warm_starting = 0;
+  settings->max_iter      = 2000;
+
+  // Setup workspace
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  // Setup correct
+  mu_assert("Primal infeasible QP test solve: Setup error!",
+             exitflag == OSQP_NO_ERROR);
+
+  // Infeasibility checked at every termination check
+  osqp_solve(solver.get());
+  mu_assert("Primal infeasible QP test solve: Error in solver status!",
+            solver->info->status_val == OSQP_PRIMAL_INFEASIBLE);
+  iter = solver->info->iter;
+
+  // Checked at every 4th termination check only, after 2 stalled checks
+  settings->check_infeasibility = 4;
+  settings->infeasibility_stall = 2;
+  exitflag = osqp_update_settings(solver.get(), settings.get());
+  mu_assert("Primal infeasible QP test solve: Error updating the settings!",
+            exitflag == OSQP_NO_ERROR);
+
+  osqp_solve(solver.get());
+  mu_assert("Primal infeasible QP test solve: Error in solver status with a sparse schedule!",
+            solver->info->status_val == OSQP_PRIMAL_INFEASIBLE);
+  mu_assert("Primal infeasible QP test solve: Infeasibility detected before it was checked!",
+            solver->info->iter > iter);
+
+  // Never checked: the iteration limit is reached
+  settings->check_infeasibility = 0;
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+  mu_assert("Primal infeasible QP test solve: Setup error!",
+             exitflag == OSQP_NO_ERROR);
+
+  osqp_solve(solver.get());
+  mu_assert("Primal infeasible QP test solve: Infeasibility checked although disabled!",
+            solver->info->status_val == OSQP_MAX_ITER_REACHED);
+}
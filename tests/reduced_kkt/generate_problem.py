@@ -0,0 +1,50 @@
+import numpy as np
+from scipy import sparse
+import utils.codegen_utils as cu
+from numpy.random import Generator, PCG64
+
+# Set random seed for reproducibility
+rg = Generator(PCG64(2))
+
+# Few variables and many dense constraints: the reduced KKT system
+# P + sigma*I + A'*diag(rho)*A is much smaller than the full KKT matrix
+n = 6
+m = 60
+
+M = rg.standard_normal((n, n))
+P = sparse.csc_matrix(M @ M.T + np.eye(n))
+A = sparse.random(m, n, density=0.8, format='csc', random_state=rg)
+
+# Build the problem from its optimality conditions:
+# constraints 0, 1 active at the upper bound, 2, 3 at the lower bound
+x = rg.standard_normal(n)
+y = np.zeros(m)
+y[:2] = 1. + rg.random(2)
+y[2:4] = -1. - rg.random(2)
+q = -(P @ x + A.T @ y)
+
+Ax = A @ x
+l = Ax - 1. - rg.random(m)
+u = Ax + 1. + rg.random(m)
+u[:2] = Ax[:2]
+l[2:4] = Ax[2:4]
+
+# Scaling P and q by 2 keeps x and doubles y,
+# then scaling A, l and u by 2 halves y back
+Pu = sparse.triu(P, format='csc')
+
+# Generate problem solutions
+sols_data = {'x_test': x,
+             'y_test': y,
+             'obj_value_test': 0.5 * x @ P @ x + q @ x,
+             'status_test': 'optimal',
+             'P_new_x': 2. * Pu.data,
+             'q_new': 2. * q,
+             'y_test_P_new': 2. * y,
+             'A_new_x': 2. * A.data,
+             'l_new': 2. * l,
+             'u_new': 2. * u,
+             'y_test_A_new': y}
+
+# Generate problem data
+cu.generate_problem_data(Pu, q, A, l, u, 'reduced_kkt', sols_data)
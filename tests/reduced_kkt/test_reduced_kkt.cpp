@@ -0,0 +1,519 @@
+#include <catch2/catch.hpp>
+#include <string.h>
+
+#include "osqp_api.h"    /* OSQP API wrapper (public + some private) */
+#include "osqp_tester.h" /* Tester helpers */
+#include "test_utils.h"  /* Testing Helper functions */
+
+#include "reduced_kkt_data.h"
+
+#ifdef OSQP_ALGEBRA_BUILTIN
+#include "pcg_interface.h"
+#endif
+
+
+TEST_CASE_METHOD(reduced_kkt_test_fixture, "Reduced KKT: Solve and update", "[solve],[qp],[update]")
+{
+  OSQPInt exitflag;
+
+  // Need slightly tighter tolerances on this problem to pass the tests
+  settings->eps_abs   = 1e-6;
+  settings->eps_rel   = 1e-6;
+  settings->polishing = 1;
+
+  /* Test all possible linear system solvers in this test case */
+  settings->linsys_solver = GENERATE(filter(&isLinsysSupported, values({OSQP_DIRECT_SOLVER, OSQP_INDIRECT_SOLVER})));
+
+  /* The indirect solvers precondition the same reduced system */
+  settings->cg_precond = GENERATE(OSQP_DIAGONAL_PRECONDITIONER, OSQP_IC0_PRECONDITIONER,
+                                  OSQP_BLOCK_JACOBI_PRECONDITIONER);
+
+  CAPTURE(settings->linsys_solver, settings->cg_precond);
+
+  // Setup workspace
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  // Setup correct
+  mu_assert("Reduced KKT test solve: Setup error!", exitflag == 0);
+
+  // With few variables and many constraints QDLDL factors the reduced KKT system
+  const char* linsys_name = solver->work->linsys_solver->name(solver->work->linsys_solver);
+  if (strncmp(linsys_name, "QDLDL", 5) == 0) {
+    mu_assert("Reduced KKT test solve: Reduced KKT system not selected!",
+              strstr(linsys_name, "reduced KKT") != NULL);
+  }
+
+  // Multiple right-hand sides are solved through the reduced system as well
+  LinSysSolver* linsys = solver->work->linsys_solver;
+  if (linsys->solve_multi) {
+    const OSQPInt k   = 9;
+    const OSQPInt len = data->n + data->m;
+
+    std::unique_ptr<OSQPFloat[]> rhs(new OSQPFloat[k*len]);
+    for (OSQPInt i = 0; i < k*len; i++)
+      rhs[i] = (OSQPFloat)((i * 37) % 17) - 8.0;
+
+    OSQPVectorf_ptr multi{OSQPVectorf_new(rhs.get(), k*len)};
+    mu_assert("Reduced KKT test multiple rhs: Solve error!",
+              linsys->solve_multi(linsys, multi.get(), k) == 0);
+
+    for (OSQPInt j = 0; j < k; j++) {
+      OSQPVectorf_ptr single{OSQPVectorf_new(rhs.get() + j*len, len)};
+      linsys->solve(linsys, single.get(), 0);
+
+      mu_assert("Reduced KKT test multiple rhs: Error in solution!",
+                vec_norm_inf_diff(OSQPVectorf_data(multi.get()) + j*len,
+                                  OSQPVectorf_data(single.get()), len) < TESTS_TOL);
+    }
+  }
+
+  // Solve Problem
+  osqp_solve(solver.get());
+
+  // Compare solver statuses
+  mu_assert("Reduced KKT test solve: Error in solver status!",
+            solver->info->status_val == sols_data->status_test);
+
+  // Compare primal solutions
+  mu_assert("Reduced KKT test solve: Error in primal solution!",
+            vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+                              data->n) < TESTS_TOL);
+
+  // Compare dual solutions
+  mu_assert("Reduced KKT test solve: Error in dual solution!",
+            vec_norm_inf_diff(solver->solution->y, sols_data->y_test,
+                              data->m) < TESTS_TOL);
+
+  // Compare objective values
+  mu_assert("Reduced KKT test solve: Error in objective value!",
+            c_absval(solver->info->obj_val - sols_data->obj_value_test) < TESTS_TOL);
+
+  // Scale P and q: the factorization is recomputed on the same pattern
+  osqp_update_data_mat(solver.get(),
+                       sols_data->P_new_x, OSQP_NULL, data->P->p[data->n],
+                       NULL, NULL, 0);
+  osqp_update_data_vec(solver.get(), sols_data->q_new, NULL, NULL);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Reduced KKT test update P: Error in solver status!",
+            solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Reduced KKT test update P: Error in primal solution!",
+            vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+                              data->n) < TESTS_TOL);
+
+  mu_assert("Reduced KKT test update P: Error in dual solution!",
+            vec_norm_inf_diff(solver->solution->y, sols_data->y_test_P_new,
+                              data->m) < TESTS_TOL);
+
+  // Scale A and the bounds
+  osqp_update_data_mat(solver.get(),
+                       NULL, NULL, 0,
+                       sols_data->A_new_x, OSQP_NULL, data->A->p[data->n]);
+  osqp_update_data_vec(solver.get(), NULL, sols_data->l_new, sols_data->u_new);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Reduced KKT test update A: Error in solver status!",
+            solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Reduced KKT test update A: Error in primal solution!",
+            vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+                              data->n) < TESTS_TOL);
+
+  mu_assert("Reduced KKT test update A: Error in dual solution!",
+            vec_norm_inf_diff(solver->solution->y, sols_data->y_test_A_new,
+                              data->m) < TESTS_TOL);
+}
+
+
+#ifdef OSQP_ALGEBRA_BUILTIN
+TEST_CASE_METHOD(reduced_kkt_test_fixture, "Reduced KKT: Incomplete Cholesky preconditioner", "[solve],[qp],[update]")
+{
+  OSQPInt exitflag;
+  OSQPInt iters[2];
+
+  const OSQPInt k   = 9;
+  const OSQPInt len = data->n + data->m;
+
+  std::unique_ptr<OSQPFloat[]> rhs(new OSQPFloat[k*len]);
+  for (OSQPInt i = 0; i < k*len; i++)
+    rhs[i] = (OSQPFloat)((i * 37) % 17) - 8.0;
+
+  settings->linsys_solver = OSQP_INDIRECT_SOLVER;
+
+  /* Total CG iterations of the same solves with each preconditioner */
+  for (OSQPInt p = 0; p < 2; p++) {
+    settings->cg_precond = p ? OSQP_IC0_PRECONDITIONER : OSQP_DIAGONAL_PRECONDITIONER;
+
+    CAPTURE(settings->cg_precond);
+
+    exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                          data->A, data->l, data->u,
+                          data->m, data->n, settings.get());
+    solver.reset(tmpSolver);
+
+    mu_assert("Reduced KKT test IC0: Setup error!", exitflag == 0);
+
+    pcg_solver* pcg = (pcg_solver*)solver->work->linsys_solver;
+    iters[p] = 0;
+
+    /* The factorization is computed before the first solve after setup, a rho
+     * update and a data update, where it must not fall back to the diagonal */
+    for (OSQPInt stage = 0; stage < 3; stage++) {
+      if (stage == 1) {
+        exitflag = osqp_update_rho(solver.get(), 10.0 * settings->rho);
+        mu_assert("Reduced KKT test IC0: Error updating rho!", exitflag == 0);
+      }
+      else if (stage == 2) {
+        exitflag = osqp_update_data_mat(solver.get(),
+                                        sols_data->P_new_x, OSQP_NULL, data->P->p[data->n],
+                                        sols_data->A_new_x, OSQP_NULL, data->A->p[data->n]);
+        mu_assert("Reduced KKT test IC0: Error updating P and A!", exitflag == 0);
+      }
+
+      /* The tolerance of the second ADMM iteration is the smallest one */
+      for (OSQPInt j = 0; j < k; j++) {
+        OSQPVectorf_ptr b{OSQPVectorf_new(rhs.get() + j*len, len)};
+        mu_assert("Reduced KKT test IC0: Solve error!",
+                  pcg->solve(pcg, b.get(), 2) == 0);
+        iters[p] += pcg->cg_iters;
+      }
+
+      mu_assert("Reduced KKT test IC0: Preconditioner fell back to the diagonal!",
+                pcg->precond_failed == OSQP_NO_PRECONDITIONER);
+    }
+
+    if (settings->cg_precond == OSQP_IC0_PRECONDITIONER)
+      mu_assert("Reduced KKT test IC0: Factorization not built!", pcg->ic0 != OSQP_NULL);
+  }
+
+  CAPTURE(iters[0], iters[1]);
+
+  mu_assert("Reduced KKT test IC0: More CG iterations than the diagonal preconditioner!",
+            iters[1] < iters[0]);
+}
+#endif /* ifdef OSQP_ALGEBRA_BUILTIN */
+
+
+TEST_CASE_METHOD(reduced_kkt_test_fixture, "Reduced KKT: Block-Jacobi block sizes", "[solve],[qp]")
+{
+  OSQPInt exitflag;
+
+  if (!isLinsysSupported(OSQP_INDIRECT_SOLVER))
+    return;
+
+  settings->eps_abs       = 1e-6;
+  settings->eps_rel       = 1e-6;
+  settings->linsys_solver = OSQP_INDIRECT_SOLVER;
+  settings->cg_precond    = OSQP_BLOCK_JACOBI_PRECONDITIONER;
+
+  /* Automatic detection, scalar blocks, uneven blocks and a single block */
+  settings->cg_block_size = GENERATE(0, 1, 4, 100);
+
+  CAPTURE(settings->cg_block_size);
+
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Reduced KKT test block-Jacobi: Setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Reduced KKT test block-Jacobi: Error in solver status!",
+            solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Reduced KKT test block-Jacobi: Error in primal solution!",
+            vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+                              data->n) < TESTS_TOL);
+
+  // Changing the block size rebuilds the partition on the next solve
+  settings->cg_block_size = 2;
+  exitflag = osqp_update_settings(solver.get(), settings.get());
+  mu_assert("Reduced KKT test block-Jacobi: Update settings error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Reduced KKT test block-Jacobi: Error in primal solution after update!",
+            vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+                              data->n) < TESTS_TOL);
+}
+
+
+TEST_CASE_METHOD(reduced_kkt_test_fixture, "Reduced KKT: MINRES on the full KKT system", "[solve],[qp]")
+{
+  OSQPInt exitflag;
+
+  if (!isLinsysSupported(OSQP_INDIRECT_SOLVER))
+    return;
+
+  settings->eps_abs       = 1e-6;
+  settings->eps_rel       = 1e-6;
+  settings->polishing     = 1;
+  settings->linsys_solver = OSQP_INDIRECT_SOLVER;
+  settings->cg_method     = OSQP_CG_MINRES;
+
+  /* The preconditioner of the reduced system is reused for the x block */
+  settings->cg_precond = GENERATE(OSQP_NO_PRECONDITIONER, OSQP_DIAGONAL_PRECONDITIONER,
+                                  OSQP_IC0_PRECONDITIONER, OSQP_BLOCK_JACOBI_PRECONDITIONER);
+
+  CAPTURE(settings->cg_precond);
+
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Reduced KKT test MINRES: Setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Reduced KKT test MINRES: Error in solver status!",
+            solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Reduced KKT test MINRES: Error in primal solution!",
+            vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+                              data->n) < TESTS_TOL);
+
+  mu_assert("Reduced KKT test MINRES: Error in dual solution!",
+            vec_norm_inf_diff(solver->solution->y, sols_data->y_test,
+                              data->m) < TESTS_TOL);
+}
+
+
+TEST_CASE_METHOD(reduced_kkt_test_fixture, "Reduced KKT: MINRES matches PCG", "[solve],[qp]")
+{
+  OSQPInt exitflag;
+  OSQPInt pcg_iter;
+
+  if (!isLinsysSupported(OSQP_INDIRECT_SOLVER))
+    return;
+
+  settings->eps_abs       = 1e-6;
+  settings->eps_rel       = 1e-6;
+  settings->polishing     = 0;
+  settings->linsys_solver = OSQP_INDIRECT_SOLVER;
+  settings->cg_precond    = OSQP_DIAGONAL_PRECONDITIONER;
+  settings->cg_method     = OSQP_CG_STANDARD;
+
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Reduced KKT test MINRES vs PCG: PCG setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Reduced KKT test MINRES vs PCG: Error in PCG solver status!",
+            solver->info->status_val == sols_data->status_test);
+
+  pcg_iter = solver->info->iter;
+  std::unique_ptr<OSQPFloat[]> x_pcg(new OSQPFloat[data->n]);
+  std::unique_ptr<OSQPFloat[]> y_pcg(new OSQPFloat[data->m]);
+  memcpy(x_pcg.get(), solver->solution->x, data->n * sizeof(OSQPFloat));
+  memcpy(y_pcg.get(), solver->solution->y, data->m * sizeof(OSQPFloat));
+
+  /* MINRES solves the full KKT system to the same relative accuracy */
+  settings->cg_method = OSQP_CG_MINRES;
+
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Reduced KKT test MINRES vs PCG: MINRES setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Reduced KKT test MINRES vs PCG: Error in MINRES solver status!",
+            solver->info->status_val == sols_data->status_test);
+
+  CAPTURE(pcg_iter, solver->info->iter);
+
+  mu_assert("Reduced KKT test MINRES vs PCG: Different number of iterations!",
+            c_absval(solver->info->iter - pcg_iter) <= settings->check_termination);
+
+  mu_assert("Reduced KKT test MINRES vs PCG: Error in primal solution!",
+            vec_norm_inf_diff(solver->solution->x, x_pcg.get(), data->n) < TESTS_TOL);
+
+  mu_assert("Reduced KKT test MINRES vs PCG: Error in dual solution!",
+            vec_norm_inf_diff(solver->solution->y, y_pcg.get(), data->m) < TESTS_TOL);
+}
+
+
+TEST_CASE_METHOD(reduced_kkt_test_fixture, "Reduced KKT: Deflated CG", "[solve],[qp],[update]")
+{
+  OSQPInt exitflag;
+
+  if (!isLinsysSupported(OSQP_INDIRECT_SOLVER))
+    return;
+
+  settings->eps_abs       = 1e-6;
+  settings->eps_rel       = 1e-6;
+  settings->polishing     = 1;
+  settings->linsys_solver = OSQP_INDIRECT_SOLVER;
+  settings->cg_method     = OSQP_CG_DEFLATED;
+
+  settings->cg_precond = GENERATE(OSQP_NO_PRECONDITIONER, OSQP_DIAGONAL_PRECONDITIONER,
+                                  OSQP_IC0_PRECONDITIONER, OSQP_BLOCK_JACOBI_PRECONDITIONER);
+
+  CAPTURE(settings->cg_precond);
+
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Reduced KKT test deflated CG: Setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Reduced KKT test deflated CG: Error in solver status!",
+            solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Reduced KKT test deflated CG: Error in primal solution!",
+            vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+                              data->n) < TESTS_TOL);
+
+  mu_assert("Reduced KKT test deflated CG: Error in dual solution!",
+            vec_norm_inf_diff(solver->solution->y, sols_data->y_test,
+                              data->m) < TESTS_TOL);
+
+  // The recycled basis must be dropped when the matrices change
+  osqp_update_data_mat(solver.get(),
+                       sols_data->P_new_x, OSQP_NULL, data->P->p[data->n],
+                       NULL, NULL, 0);
+  osqp_update_data_vec(solver.get(), sols_data->q_new, NULL, NULL);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Reduced KKT test deflated CG: Error in solver status after update!",
+            solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Reduced KKT test deflated CG: Error in dual solution after update!",
+            vec_norm_inf_diff(solver->solution->y, sols_data->y_test_P_new,
+                              data->m) < TESTS_TOL);
+}
+
+
+TEST_CASE_METHOD(reduced_kkt_test_fixture, "Reduced KKT: Pipelined CG", "[solve],[qp],[update]")
+{
+  OSQPInt exitflag;
+
+  if (!isLinsysSupported(OSQP_INDIRECT_SOLVER))
+    return;
+
+  settings->eps_abs       = 1e-6;
+  settings->eps_rel       = 1e-6;
+  settings->polishing     = 1;
+  settings->linsys_solver = OSQP_INDIRECT_SOLVER;
+  settings->cg_method     = OSQP_CG_PIPELINED;
+
+  settings->cg_precond = GENERATE(OSQP_NO_PRECONDITIONER, OSQP_DIAGONAL_PRECONDITIONER,
+                                  OSQP_IC0_PRECONDITIONER, OSQP_BLOCK_JACOBI_PRECONDITIONER);
+
+  CAPTURE(settings->cg_precond);
+
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Reduced KKT test pipelined CG: Setup error!", exitflag == 0);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Reduced KKT test pipelined CG: Error in solver status!",
+            solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Reduced KKT test pipelined CG: Error in primal solution!",
+            vec_norm_inf_diff(solver->solution->x, sols_data->x_test,
+                              data->n) < TESTS_TOL);
+
+  mu_assert("Reduced KKT test pipelined CG: Error in dual solution!",
+            vec_norm_inf_diff(solver->solution->y, sols_data->y_test,
+                              data->m) < TESTS_TOL);
+
+  // Scale P and q, then A and the bounds
+  osqp_update_data_mat(solver.get(),
+                       sols_data->P_new_x, OSQP_NULL, data->P->p[data->n],
+                       NULL, NULL, 0);
+  osqp_update_data_vec(solver.get(), sols_data->q_new, NULL, NULL);
+  osqp_update_data_mat(solver.get(),
+                       NULL, NULL, 0,
+                       sols_data->A_new_x, OSQP_NULL, data->A->p[data->n]);
+  osqp_update_data_vec(solver.get(), NULL, sols_data->l_new, sols_data->u_new);
+
+  osqp_solve(solver.get());
+
+  mu_assert("Reduced KKT test pipelined CG: Error in solver status after update!",
+            solver->info->status_val == sols_data->status_test);
+
+  mu_assert("Reduced KKT test pipelined CG: Error in dual solution after update!",
+            vec_norm_inf_diff(solver->solution->y, sols_data->y_test_A_new,
+                              data->m) < TESTS_TOL);
+}
+
+
+TEST_CASE_METHOD(reduced_kkt_test_fixture, "Reduced KKT: Pipelined CG matches PCG iterates", "[solve],[qp]")
+{
+  OSQPInt exitflag;
+
+  if (!isLinsysSupported(OSQP_INDIRECT_SOLVER))
+    return;
+
+  const OSQPInt len = data->n + data->m;
+
+  std::unique_ptr<OSQPFloat[]> rhs(new OSQPFloat[len]);
+  for (OSQPInt i = 0; i < len; i++)
+    rhs[i] = (OSQPFloat)((i * 37) % 17) - 8.0;
+
+  settings->linsys_solver = OSQP_INDIRECT_SOLVER;
+  settings->cg_precond    = GENERATE(OSQP_NO_PRECONDITIONER, OSQP_DIAGONAL_PRECONDITIONER);
+
+  /* Stop both methods after the same number of iterations, before convergence */
+  settings->cg_max_iter = GENERATE(1, 2, 3, 4, 5);
+
+  CAPTURE(settings->cg_precond, settings->cg_max_iter);
+
+  settings->cg_method = OSQP_CG_STANDARD;
+
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Reduced KKT test pipelined CG iterates: PCG setup error!", exitflag == 0);
+
+  /* With zero ADMM residuals the tolerance of the second ADMM iteration is the
+   * smallest one, so every solve runs cg_max_iter iterations from zero */
+  OSQPVectorf_ptr b_pcg{OSQPVectorf_new(rhs.get(), len)};
+  LinSysSolver* linsys = solver->work->linsys_solver;
+  mu_assert("Reduced KKT test pipelined CG iterates: PCG solve error!",
+            linsys->solve(linsys, b_pcg.get(), 2) == 0);
+
+  settings->cg_method = OSQP_CG_PIPELINED;
+
+  exitflag = osqp_setup(&tmpSolver, data->P, data->q,
+                        data->A, data->l, data->u,
+                        data->m, data->n, settings.get());
+  solver.reset(tmpSolver);
+
+  mu_assert("Reduced KKT test pipelined CG iterates: Pipelined CG setup error!", exitflag == 0);
+
+  OSQPVectorf_ptr b_pipe{OSQPVectorf_new(rhs.get(), len)};
+  linsys = solver->work->linsys_solver;
+  mu_assert("Reduced KKT test pipelined CG iterates: Pipelined CG solve error!",
+            linsys->solve(linsys, b_pipe.get(), 2) == 0);
+
+  mu_assert("Reduced KKT test pipelined CG iterates: Different iterates!",
+            vec_norm_inf_diff(OSQPVectorf_data(b_pipe.get()),
+                              OSQPVectorf_data(b_pcg.get()), len) < TESTS_TOL);
+}